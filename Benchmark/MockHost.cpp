@@ -0,0 +1,1725 @@
+#include "MockHost.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+using namespace TD;
+
+namespace
+{
+	class MockDownloadResult : public OP_TOPDownloadResult
+	{
+	public:
+		MockDownloadResult(size_t bytes) :
+			myRefs{ 0 }, myStorage(bytes)
+		{
+			size = bytes;
+		}
+
+		virtual void*
+		getData() override
+		{
+			return myStorage.data();
+		}
+
+	protected:
+		virtual void
+		acquire() override
+		{
+			myRefs++;
+		}
+
+		virtual void
+		release() override
+		{
+			if (--myRefs == 0)
+				delete this;
+		}
+
+		virtual void	reserved0() override {}
+		virtual void	reserved1() override {}
+		virtual void	reserved2() override {}
+		virtual void	reserved3() override {}
+		virtual void	reserved4() override {}
+
+	private:
+		std::atomic<int>		myRefs;
+		std::vector<uint8_t>	myStorage;
+	};
+
+	class MockTOPBuffer : public TOP_Buffer
+	{
+	public:
+		MockTOPBuffer(uint64_t bytes, TOP_BufferFlags bufferFlags) :
+			myRefs{ 0 }, myStorage{ new uint8_t[bytes] }
+		{
+			data = myStorage.get();
+			size = bytes;
+			flags = bufferFlags;
+		}
+
+	protected:
+		virtual void
+		acquire() override
+		{
+			myRefs++;
+		}
+
+		virtual void
+		release() override
+		{
+			if (--myRefs == 0)
+				delete this;
+		}
+
+		virtual void	reserved0() override {}
+		virtual void	reserved1() override {}
+		virtual void	reserved2() override {}
+		virtual void	reserved3() override {}
+		virtual void	reserved4() override {}
+
+	private:
+		std::atomic<int>			myRefs;
+		std::unique_ptr<uint8_t[]>	myStorage;
+	};
+
+	int
+	channelsIn(OP_PixelFormat fmt)
+	{
+		switch (fmt)
+		{
+			case OP_PixelFormat::Mono8Fixed:
+			case OP_PixelFormat::Mono32Float:
+				return 1;
+			case OP_PixelFormat::RG32Float:
+				return 2;
+			default:
+				return 4;
+		}
+	}
+
+	bool
+	isFloat(OP_PixelFormat fmt)
+	{
+		return fmt == OP_PixelFormat::Mono32Float || fmt == OP_PixelFormat::RG32Float ||
+				fmt == OP_PixelFormat::RGBA32Float;
+	}
+
+	bool
+	isSupported(OP_PixelFormat fmt)
+	{
+		switch (fmt)
+		{
+			case OP_PixelFormat::BGRA8Fixed:
+			case OP_PixelFormat::RGBA8Fixed:
+			case OP_PixelFormat::Mono8Fixed:
+			case OP_PixelFormat::RGBA32Float:
+			case OP_PixelFormat::Mono32Float:
+			case OP_PixelFormat::RG32Float:
+				return true;
+			default:
+				return false;
+		}
+	}
+}
+
+void
+MockString::setString(const char* val)
+{
+	myValue = val ? val : "";
+}
+
+#pragma region MockInputs
+
+MockInputs::MockInputs() :
+	myTimeInfo{}
+{
+	myTimeInfo.rate = 60.0;
+	myTimeInfo.rootRate = 60.0;
+	myTimeInfo.deltaFrames = 1.0;
+	myTimeInfo.deltaMS = 1000.0 / 60.0;
+}
+
+MockParameter&
+MockInputs::par(const char* name)
+{
+	return myParameters[name];
+}
+
+bool
+MockInputs::hasPar(const char* name) const
+{
+	return myParameters.count(name) != 0;
+}
+
+void
+MockInputs::setPar(const char* name, double v0, double v1, double v2, double v3)
+{
+	MockParameter&	p = par(name);
+	p.values[0] = v0;
+	p.values[1] = v1;
+	p.values[2] = v2;
+	p.values[3] = v3;
+
+	const int	idx = static_cast<int>(v0);
+	if (idx >= 0 && idx < static_cast<int>(p.menuNames.size()))
+		p.str = p.menuNames[idx];
+}
+
+void
+MockInputs::setPar(const char* name, const char* value)
+{
+	MockParameter&	p = par(name);
+	p.str = value ? value : "";
+
+	auto it = std::find(p.menuNames.begin(), p.menuNames.end(), p.str);
+	if (it != p.menuNames.end())
+		p.values[0] = static_cast<double>(it - p.menuNames.begin());
+}
+
+void
+MockInputs::setParCHOP(const char* name, const OP_CHOPInput* chop)
+{
+	par(name).chop = chop;
+}
+
+void
+MockInputs::setParSOP(const char* name, const OP_SOPInput* sop)
+{
+	par(name).sop = sop;
+}
+
+void
+MockInputs::setParTOP(const char* name, const OP_TOPInput* top)
+{
+	par(name).top = top;
+}
+
+template <class T>
+static void
+setAt(std::vector<const T*>& inputs, int32_t index, const T* input)
+{
+	if (static_cast<int32_t>(inputs.size()) <= index)
+		inputs.resize(index + 1, nullptr);
+	inputs[index] = input;
+}
+
+void
+MockInputs::setInput(int32_t index, const OP_CHOPInput* chop)
+{
+	setAt(myCHOPInputs, index, chop);
+}
+
+void
+MockInputs::setInput(int32_t index, const OP_SOPInput* sop)
+{
+	setAt(mySOPInputs, index, sop);
+}
+
+void
+MockInputs::setInput(int32_t index, const OP_TOPInput* top)
+{
+	setAt(myTOPInputs, index, top);
+}
+
+void
+MockInputs::setInput(int32_t index, const OP_DATInput* dat)
+{
+	setAt(myDATInputs, index, dat);
+}
+
+void
+MockInputs::nextFrame()
+{
+	myTimeInfo.absFrame++;
+	myTimeInfo.frame += 1.0;
+	myTimeInfo.rootFrame += 1.0;
+}
+
+const MockParameter*
+MockInputs::findPar(const char* name) const
+{
+	auto it = myParameters.find(name);
+	return it == myParameters.end() ? nullptr : &it->second;
+}
+
+template <class T>
+const T*
+MockInputs::inputAt(const std::vector<const T*>& inputs, int32_t index)
+{
+	if (index < 0 || index >= static_cast<int32_t>(inputs.size()))
+		return nullptr;
+	return inputs[index];
+}
+
+int32_t
+MockInputs::getNumInputs() const
+{
+	size_t n = std::max(std::max(myCHOPInputs.size(), mySOPInputs.size()),
+						std::max(myTOPInputs.size(), myDATInputs.size()));
+	return static_cast<int32_t>(n);
+}
+
+const OP_CHOPInput*
+MockInputs::getInputCHOP(int32_t index) const
+{
+	return inputAt(myCHOPInputs, index);
+}
+
+const OP_DATInput*
+MockInputs::getParDAT(const char* name) const
+{
+	const MockParameter*	p = findPar(name);
+	return p ? p->dat : nullptr;
+}
+
+const OP_CHOPInput*
+MockInputs::getParCHOP(const char* name) const
+{
+	const MockParameter*	p = findPar(name);
+	return p ? p->chop : nullptr;
+}
+
+const OP_ObjectInput*
+MockInputs::getParObject(const char* name) const
+{
+	return nullptr;
+}
+
+double
+MockInputs::getParDouble(const char* name, int32_t index) const
+{
+	const MockParameter*	p = findPar(name);
+	if (!p || index < 0 || index > 3)
+		return 0.0;
+	return p->values[index];
+}
+
+bool
+MockInputs::getParDouble2(const char* name, double& v0, double& v1) const
+{
+	const MockParameter*	p = findPar(name);
+	if (!p)
+		return false;
+	v0 = p->values[0];
+	v1 = p->values[1];
+	return true;
+}
+
+bool
+MockInputs::getParDouble3(const char* name, double& v0, double& v1, double& v2) const
+{
+	const MockParameter*	p = findPar(name);
+	if (!p)
+		return false;
+	v0 = p->values[0];
+	v1 = p->values[1];
+	v2 = p->values[2];
+	return true;
+}
+
+bool
+MockInputs::getParDouble4(const char* name, double& v0, double& v1, double& v2, double& v3) const
+{
+	const MockParameter*	p = findPar(name);
+	if (!p)
+		return false;
+	v0 = p->values[0];
+	v1 = p->values[1];
+	v2 = p->values[2];
+	v3 = p->values[3];
+	return true;
+}
+
+int32_t
+MockInputs::getParInt(const char* name, int32_t index) const
+{
+	return static_cast<int32_t>(std::lround(getParDouble(name, index)));
+}
+
+bool
+MockInputs::getParInt2(const char* name, int32_t& v0, int32_t& v1) const
+{
+	double d0, d1;
+	if (!getParDouble2(name, d0, d1))
+		return false;
+	v0 = static_cast<int32_t>(std::lround(d0));
+	v1 = static_cast<int32_t>(std::lround(d1));
+	return true;
+}
+
+bool
+MockInputs::getParInt3(const char* name, int32_t& v0, int32_t& v1, int32_t& v2) const
+{
+	double d0, d1, d2;
+	if (!getParDouble3(name, d0, d1, d2))
+		return false;
+	v0 = static_cast<int32_t>(std::lround(d0));
+	v1 = static_cast<int32_t>(std::lround(d1));
+	v2 = static_cast<int32_t>(std::lround(d2));
+	return true;
+}
+
+bool
+MockInputs::getParInt4(const char* name, int32_t& v0, int32_t& v1, int32_t& v2, int32_t& v3) const
+{
+	double d0, d1, d2, d3;
+	if (!getParDouble4(name, d0, d1, d2, d3))
+		return false;
+	v0 = static_cast<int32_t>(std::lround(d0));
+	v1 = static_cast<int32_t>(std::lround(d1));
+	v2 = static_cast<int32_t>(std::lround(d2));
+	v3 = static_cast<int32_t>(std::lround(d3));
+	return true;
+}
+
+const char*
+MockInputs::getParString(const char* name) const
+{
+	const MockParameter*	p = findPar(name);
+	return p ? p->str.c_str() : "";
+}
+
+const char*
+MockInputs::getParFilePath(const char* name) const
+{
+	return getParString(name);
+}
+
+bool
+MockInputs::getRelativeTransform(const char* from_name, const char* to_name, double matrix[4][4]) const
+{
+	for (int i = 0; i < 4; i++)
+		for (int j = 0; j < 4; j++)
+			matrix[i][j] = i == j ? 1.0 : 0.0;
+	return false;
+}
+
+void
+MockInputs::enablePar(const char* name, bool onoff) const
+{
+	myParameters[name].enabled = onoff;
+}
+
+const OP_DATInput*
+MockInputs::getDAT(const char* path) const
+{
+	return nullptr;
+}
+
+const OP_CHOPInput*
+MockInputs::getCHOP(const char* path) const
+{
+	return nullptr;
+}
+
+const OP_ObjectInput*
+MockInputs::getObject(const char* path) const
+{
+	return nullptr;
+}
+
+const OP_SOPInput*
+MockInputs::getParSOP(const char* name) const
+{
+	const MockParameter*	p = findPar(name);
+	return p ? p->sop : nullptr;
+}
+
+const OP_SOPInput*
+MockInputs::getInputSOP(int32_t index) const
+{
+	return inputAt(mySOPInputs, index);
+}
+
+const OP_SOPInput*
+MockInputs::getSOP(const char* path) const
+{
+	return nullptr;
+}
+
+const OP_DATInput*
+MockInputs::getInputDAT(int32_t index) const
+{
+	return inputAt(myDATInputs, index);
+}
+
+PyObject*
+MockInputs::getParPython(const char* name) const
+{
+	return nullptr;
+}
+
+const OP_TimeInfo*
+MockInputs::getTimeInfo() const
+{
+	return &myTimeInfo;
+}
+
+const OP_TOPInput*
+MockInputs::getTOP(const char* path) const
+{
+	return nullptr;
+}
+
+const OP_TOPInput*
+MockInputs::getInputTOP(int32_t index) const
+{
+	return inputAt(myTOPInputs, index);
+}
+
+const OP_TOPInput*
+MockInputs::getParTOP(const char* name) const
+{
+	const MockParameter*	p = findPar(name);
+	return p ? p->top : nullptr;
+}
+
+const OP_TOPInputOpenGL*
+MockInputs::getInputTOPOpenGL(int32_t index) const
+{
+	return nullptr;
+}
+
+const OP_TOPInputOpenGL*
+MockInputs::getParTOPOpenGL(const char* name) const
+{
+	return nullptr;
+}
+
+const OP_TOPInputOpenGL*
+MockInputs::getTOPOpenGL(const char* path) const
+{
+	return nullptr;
+}
+
+void*
+MockInputs::getTOPDataInCPUMemory(const OP_TOPInputOpenGL* top, const OP_TOPInputDownloadOptionsOpenGL* options) const
+{
+	return nullptr;
+}
+
+#pragma endregion
+
+#pragma region MockParameterManager
+
+MockParameterManager::MockParameterManager(MockInputs* inputs) :
+	myInputs{ inputs }
+{
+}
+
+OP_ParAppendResult
+MockParameterManager::appendNumeric(const OP_NumericParameter& np, int32_t size)
+{
+	if (!np.name || myInputs->hasPar(np.name))
+		return OP_ParAppendResult::InvalidName;
+	if (size < 1 || size > 4)
+		return OP_ParAppendResult::InvalidSize;
+
+	MockParameter&	p = myInputs->par(np.name);
+	for (int i = 0; i < size; i++)
+		p.values[i] = np.defaultValues[i];
+	return OP_ParAppendResult::Success;
+}
+
+OP_ParAppendResult
+MockParameterManager::appendText(const OP_StringParameter& sp)
+{
+	if (!sp.name || myInputs->hasPar(sp.name))
+		return OP_ParAppendResult::InvalidName;
+
+	myInputs->par(sp.name).str = sp.defaultValue ? sp.defaultValue : "";
+	return OP_ParAppendResult::Success;
+}
+
+OP_ParAppendResult
+MockParameterManager::appendFloat(const OP_NumericParameter& np, int32_t size)
+{
+	return appendNumeric(np, size);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendInt(const OP_NumericParameter& np, int32_t size)
+{
+	return appendNumeric(np, size);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendXY(const OP_NumericParameter& np)
+{
+	return appendNumeric(np, 2);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendXYZ(const OP_NumericParameter& np)
+{
+	return appendNumeric(np, 3);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendUV(const OP_NumericParameter& np)
+{
+	return appendNumeric(np, 2);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendUVW(const OP_NumericParameter& np)
+{
+	return appendNumeric(np, 3);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendRGB(const OP_NumericParameter& np)
+{
+	return appendNumeric(np, 3);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendRGBA(const OP_NumericParameter& np)
+{
+	return appendNumeric(np, 4);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendToggle(const OP_NumericParameter& np)
+{
+	return appendNumeric(np, 1);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendPulse(const OP_NumericParameter& np)
+{
+	return appendNumeric(np, 1);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendString(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendFile(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendFolder(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendDAT(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendCHOP(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendTOP(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendObject(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendMenu(const OP_StringParameter& sp, int32_t nitems, const char** names, const char** labels)
+{
+	OP_ParAppendResult res = appendText(sp);
+	if (res != OP_ParAppendResult::Success)
+		return res;
+
+	MockParameter&	p = myInputs->par(sp.name);
+	p.menuNames.assign(names, names + nitems);
+	// Menus cook with the index of their default entry
+	myInputs->setPar(sp.name, p.str.c_str());
+	return res;
+}
+
+OP_ParAppendResult
+MockParameterManager::appendStringMenu(const OP_StringParameter& sp, int32_t nitems, const char** names, const char** labels)
+{
+	return appendMenu(sp, nitems, names, labels);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendSOP(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendPython(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendOP(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendCOMP(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendMAT(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendPanelCOMP(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendHeader(const OP_StringParameter& np)
+{
+	return appendText(np);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendMomentary(const OP_NumericParameter& np)
+{
+	return appendNumeric(np, 1);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendWH(const OP_NumericParameter& np)
+{
+	return appendNumeric(np, 2);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendDynamicStringMenu(const OP_StringParameter& sp)
+{
+	return appendText(sp);
+}
+
+OP_ParAppendResult
+MockParameterManager::appendDynamicMenu(const OP_NumericParameter& np)
+{
+	return appendNumeric(np, 1);
+}
+
+#pragma endregion
+
+#pragma region TOP
+
+MockTOPInput::MockTOPInput(int width, int height) :
+	myPixels(static_cast<size_t>(width) * height * 4)
+{
+	opPath = "/mock/top_in";
+	opId = 1;
+	textureDesc.width = width;
+	textureDesc.height = height;
+	textureDesc.texDim = OP_TexDim::e2D;
+	textureDesc.pixelFormat = OP_PixelFormat::RGBA8Fixed;
+	totalCooks = 1;
+	customOP = nullptr;
+}
+
+OP_SmartRef<OP_TOPDownloadResult>
+MockTOPInput::downloadTexture(const OP_TOPInputDownloadOptions& opts, void* reserved1) const
+{
+	const OP_PixelFormat	fmt = opts.pixelFormat == OP_PixelFormat::Invalid ? textureDesc.pixelFormat : opts.pixelFormat;
+	if (!isSupported(fmt))
+		return OP_SmartRef<OP_TOPDownloadResult>();
+
+	const int		w = width();
+	const int		h = height();
+	const int		chans = channelsIn(fmt);
+	const size_t	pixelBytes = chans * (isFloat(fmt) ? sizeof(float) : sizeof(uint8_t));
+
+	MockDownloadResult*	res = new MockDownloadResult(pixelBytes * w * h);
+	res->textureDesc = textureDesc;
+	res->textureDesc.pixelFormat = fmt;
+
+	uint8_t*	out = static_cast<uint8_t*>(res->getData());
+	for (int y = 0; y < h; y++)
+	{
+		const int		srcY = opts.verticalFlip ? h - 1 - y : y;
+		const uint8_t*	src = myPixels.data() + static_cast<size_t>(srcY) * w * 4;
+		uint8_t*		dst = out + static_cast<size_t>(y) * w * pixelBytes;
+		switch (fmt)
+		{
+			case OP_PixelFormat::RGBA8Fixed:
+				memcpy(dst, src, static_cast<size_t>(w) * 4);
+				break;
+			case OP_PixelFormat::BGRA8Fixed:
+				for (int x = 0; x < w; x++)
+				{
+					dst[4 * x + 0] = src[4 * x + 2];
+					dst[4 * x + 1] = src[4 * x + 1];
+					dst[4 * x + 2] = src[4 * x + 0];
+					dst[4 * x + 3] = src[4 * x + 3];
+				}
+				break;
+			case OP_PixelFormat::Mono8Fixed:
+				for (int x = 0; x < w; x++)
+					dst[x] = src[4 * x];
+				break;
+			default:
+			{
+				float*	fdst = reinterpret_cast<float*>(dst);
+				for (int x = 0; x < w; x++)
+					for (int c = 0; c < chans; c++)
+						fdst[chans * x + c] = src[4 * x + c] / 255.0f;
+				break;
+			}
+		}
+	}
+	return OP_SmartRef<OP_TOPDownloadResult>(res);
+}
+
+const OP_CUDAArrayInfo*
+MockTOPInput::getCUDAArray(const OP_CUDAAcquireInfo& info, void* reserved2) const
+{
+	return nullptr;
+}
+
+OP_SmartRef<TOP_Buffer>
+MockTOPContext::createOutputBuffer(uint64_t size, TOP_BufferFlags flags, void* reserved)
+{
+	myBuffersCreated++;
+	myBytesCreated += size;
+	return OP_SmartRef<TOP_Buffer>(new MockTOPBuffer(size, flags));
+}
+
+void
+MockTOPContext::returnBuffer(OP_SmartRef<TOP_Buffer>* buf)
+{
+	if (buf && *buf)
+	{
+		myBuffersReturned++;
+		buf->release();
+	}
+}
+
+void
+MockTOPOutput::uploadBuffer(OP_SmartRef<TOP_Buffer>* buf, const TOP_UploadInfo& info, void* reserved)
+{
+	// Takes ownership of 'buf', same as TouchDesigner
+	myLastBuffer = std::move(*buf);
+	myLastInfo = info;
+	myUploads++;
+}
+
+const OP_CUDAArrayInfo*
+MockTOPOutput::createCUDAArray(const TOP_CUDAOutputInfo& info, void* reserved)
+{
+	return nullptr;
+}
+
+#pragma endregion
+
+#pragma region CHOP
+
+MockCHOPInput::MockCHOPInput(int32_t chans, int32_t samples, double rate) :
+	myData(chans, std::vector<float>(samples, 0.0f)), myNames(chans)
+{
+	opPath = "/mock/chop_in";
+	opId = 2;
+	numChannels = chans;
+	numSamples = samples;
+	sampleRate = rate;
+	startIndex = 0;
+	totalCooks = 1;
+	customOP = nullptr;
+	for (int32_t i = 0; i < chans; i++)
+		myNames[i] = "chan" + std::to_string(i + 1);
+	updatePointers();
+}
+
+void
+MockCHOPInput::setChannelName(int32_t i, const char* name)
+{
+	myNames[i] = name;
+	updatePointers();
+}
+
+void
+MockCHOPInput::updatePointers()
+{
+	myChannelPointers.clear();
+	myNamePointers.clear();
+	for (size_t i = 0; i < myData.size(); i++)
+	{
+		myChannelPointers.push_back(myData[i].data());
+		myNamePointers.push_back(myNames[i].c_str());
+	}
+	channelData = myChannelPointers.data();
+	nameData = myNamePointers.data();
+}
+
+CHOP_Output*
+MockCHOPOutput::allocate(int32_t numChannels, int32_t numSamples, float sampleRate, uint32_t startIndex)
+{
+	myData.resize(numChannels);
+	myChannelPointers.resize(numChannels);
+	myNamePointers.resize(numChannels);
+	myNames.resize(numChannels);
+	for (int32_t i = 0; i < numChannels; i++)
+	{
+		myData[i].assign(numSamples, 0.0f);
+		myChannelPointers[i] = myData[i].data();
+		myNamePointers[i] = myNames[i].str().c_str();
+	}
+	myOutput.reset(new CHOP_Output(numChannels, numSamples, sampleRate, startIndex,
+									myChannelPointers.data(), myNamePointers.data()));
+	return myOutput.get();
+}
+
+#pragma endregion
+
+#pragma region SOP
+
+MockSOPInput::MockSOPInput()
+{
+	opPath = "/mock/sop_in";
+	opId = 3;
+	myPrimsInfo = nullptr;
+	myPrimPointIndices = nullptr;
+	totalCooks = 1;
+	customOP = nullptr;
+}
+
+std::unique_ptr<MockSOPInput>
+MockSOPInput::grid(int rows, int cols)
+{
+	std::unique_ptr<MockSOPInput>	sop(new MockSOPInput());
+	for (int r = 0; r < rows; r++)
+	{
+		for (int c = 0; c < cols; c++)
+		{
+			const float u = cols > 1 ? static_cast<float>(c) / (cols - 1) : 0.0f;
+			const float v = rows > 1 ? static_cast<float>(r) / (rows - 1) : 0.0f;
+			sop->addPoint(Position(2.0f * u - 1.0f, 2.0f * v - 1.0f, 0.0f));
+			sop->myNormalData.emplace_back(0.0f, 0.0f, 1.0f);
+			sop->myTextureData.emplace_back(u, v, 0.0f);
+		}
+	}
+	for (int r = 0; r + 1 < rows; r++)
+	{
+		for (int c = 0; c + 1 < cols; c++)
+		{
+			const int32_t	p = r * cols + c;
+			sop->addTriangle(p, p + 1, p + cols + 1);
+			sop->addTriangle(p, p + cols + 1, p + cols);
+		}
+	}
+	sop->finalize();
+	return sop;
+}
+
+std::unique_ptr<MockSOPInput>
+MockSOPInput::sphere(int rings, int segments)
+{
+	const float	pi = 3.14159265358979f;
+
+	std::unique_ptr<MockSOPInput>	sop(new MockSOPInput());
+	const int32_t	top = sop->addPoint(Position(0.0f, 1.0f, 0.0f));
+	for (int r = 1; r < rings; r++)
+	{
+		const float	theta = pi * r / rings;
+		for (int s = 0; s < segments; s++)
+		{
+			const float	phi = 2.0f * pi * s / segments;
+			sop->addPoint(Position(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)));
+		}
+	}
+	const int32_t	bottom = sop->addPoint(Position(0.0f, -1.0f, 0.0f));
+
+	auto ringPoint = [segments](int r, int s) { return 1 + (r - 1) * segments + (s % segments); };
+	for (int s = 0; s < segments; s++)
+		sop->addTriangle(top, ringPoint(1, s + 1), ringPoint(1, s));
+	for (int r = 1; r + 1 < rings; r++)
+	{
+		for (int s = 0; s < segments; s++)
+		{
+			sop->addTriangle(ringPoint(r, s), ringPoint(r, s + 1), ringPoint(r + 1, s + 1));
+			sop->addTriangle(ringPoint(r, s), ringPoint(r + 1, s + 1), ringPoint(r + 1, s));
+		}
+	}
+	for (int s = 0; s < segments; s++)
+		sop->addTriangle(bottom, ringPoint(rings - 1, s), ringPoint(rings - 1, s + 1));
+
+	for (const Position& p : sop->myPositions)
+		sop->myNormalData.emplace_back(p.x, p.y, p.z);
+	sop->finalize();
+	return sop;
+}
+
+std::unique_ptr<MockSOPInput>
+MockSOPInput::pointCloud(int numPoints, unsigned seed)
+{
+	std::unique_ptr<MockSOPInput>	sop(new MockSOPInput());
+	std::mt19937	gen(seed);
+	std::uniform_real_distribution<float>	dist(-1.0f, 1.0f);
+	for (int i = 0; i < numPoints; i++)
+		sop->addPoint(Position(dist(gen), dist(gen), dist(gen)));
+	sop->finalize();
+	return sop;
+}
+
+int32_t
+MockSOPInput::addPoint(const Position& p)
+{
+	myPositions.push_back(p);
+	return static_cast<int32_t>(myPositions.size() - 1);
+}
+
+void
+MockSOPInput::addTriangle(int32_t a, int32_t b, int32_t c)
+{
+	SOP_PrimitiveInfo	prim;
+	prim.numVertices = 3;
+	prim.type = PrimitiveType::Polygon;
+	prim.pointIndicesOffset = static_cast<int32_t>(myIndices.size());
+	prim.isClosed = true;
+	myPrims.push_back(prim);
+
+	myIndices.push_back(a);
+	myIndices.push_back(b);
+	myIndices.push_back(c);
+}
+
+void
+MockSOPInput::finalize()
+{
+	for (SOP_PrimitiveInfo& prim : myPrims)
+		prim.pointIndices = myIndices.data() + prim.pointIndicesOffset;
+	myPrimsInfo = myPrims.data();
+	myPrimPointIndices = myIndices.data();
+
+	myNormals.numNormals = static_cast<int32_t>(myNormalData.size());
+	myNormals.normals = myNormalData.data();
+	myColors.numColors = static_cast<int32_t>(myColorData.size());
+	myColors.colors = myColorData.data();
+	myTextures.numTextures = static_cast<int32_t>(myTextureData.size());
+	myTextures.numTextureLayers = myTextureData.empty() ? 0 : 1;
+	myTextures.textures = myTextureData.data();
+}
+
+int32_t
+MockSOPInput::getNumPoints() const
+{
+	return static_cast<int32_t>(myPositions.size());
+}
+
+int32_t
+MockSOPInput::getNumVertices() const
+{
+	return static_cast<int32_t>(myIndices.size());
+}
+
+int32_t
+MockSOPInput::getNumPrimitives() const
+{
+	return static_cast<int32_t>(myPrims.size());
+}
+
+int32_t
+MockSOPInput::getNumCustomAttributes() const
+{
+	return 0;
+}
+
+const Position*
+MockSOPInput::getPointPositions() const
+{
+	return myPositions.data();
+}
+
+const SOP_NormalInfo*
+MockSOPInput::getNormals() const
+{
+	return myNormalData.empty() ? nullptr : &myNormals;
+}
+
+const SOP_ColorInfo*
+MockSOPInput::getColors() const
+{
+	return myColorData.empty() ? nullptr : &myColors;
+}
+
+const SOP_TextureInfo*
+MockSOPInput::getTextures() const
+{
+	return myTextureData.empty() ? nullptr : &myTextures;
+}
+
+const SOP_CustomAttribData*
+MockSOPInput::getCustomAttribute(int32_t customAttribIndex) const
+{
+	return nullptr;
+}
+
+const SOP_CustomAttribData*
+MockSOPInput::getCustomAttribute(const char* customAttribName) const
+{
+	return nullptr;
+}
+
+bool
+MockSOPInput::hasNormals() const
+{
+	return !myNormalData.empty();
+}
+
+bool
+MockSOPInput::hasColors() const
+{
+	return !myColorData.empty();
+}
+
+// Möller–Trumbore, 't' is in units of 'dir'
+bool
+MockSOPInput::intersect(const Position& orig, const Vector& dir, int prim, float& t, float& u, float& v) const
+{
+	const int32_t*	idx = myPrims[prim].pointIndices;
+	const Position&	p0 = myPositions[idx[0]];
+	const Position&	p1 = myPositions[idx[1]];
+	const Position&	p2 = myPositions[idx[2]];
+
+	const float e1[3] = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+	const float e2[3] = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+	const float pv[3] = { dir.y * e2[2] - dir.z * e2[1], dir.z * e2[0] - dir.x * e2[2], dir.x * e2[1] - dir.y * e2[0] };
+	const float det = e1[0] * pv[0] + e1[1] * pv[1] + e1[2] * pv[2];
+	if (std::fabs(det) < 1e-12f)
+		return false;
+
+	const float inv = 1.0f / det;
+	const float tv[3] = { orig.x - p0.x, orig.y - p0.y, orig.z - p0.z };
+	u = (tv[0] * pv[0] + tv[1] * pv[1] + tv[2] * pv[2]) * inv;
+	if (u < 0.0f || u > 1.0f)
+		return false;
+
+	const float qv[3] = { tv[1] * e1[2] - tv[2] * e1[1], tv[2] * e1[0] - tv[0] * e1[2], tv[0] * e1[1] - tv[1] * e1[0] };
+	v = (dir.x * qv[0] + dir.y * qv[1] + dir.z * qv[2]) * inv;
+	if (v < 0.0f || u + v > 1.0f)
+		return false;
+
+	t = (e2[0] * qv[0] + e2[1] * qv[1] + e2[2] * qv[2]) * inv;
+	return t > 1e-6f;
+}
+
+// Parity of crossings along a fixed ray, brute force over every triangle.
+// TouchDesigner uses an acceleration structure, so absolute numbers for
+// operators that call this heavily are pessimistic.
+bool
+MockSOPInput::isInside(const Position& pos)
+{
+	const Vector	dir(0.577f, 0.5774f, 0.5771f);
+
+	int		crossings = 0;
+	float	t, u, v;
+	for (int i = 0; i < getNumPrimitives(); i++)
+	{
+		if (myPrims[i].numVertices == 3 && intersect(pos, dir, i, t, u, v))
+			crossings++;
+	}
+	return crossings % 2 == 1;
+}
+
+bool
+MockSOPInput::sendRay(const Position& pos, const Vector& dir,
+					Position& hitPosition, float& hitLength, Vector& hitNormal,
+					float& hitU, float& hitV, int& hitPrimitiveIndex)
+{
+	float	best = -1.0f;
+	float	t, u, v;
+	for (int i = 0; i < getNumPrimitives(); i++)
+	{
+		if (myPrims[i].numVertices != 3 || !intersect(pos, dir, i, t, u, v))
+			continue;
+		if (best < 0.0f || t < best)
+		{
+			best = t;
+			hitU = u;
+			hitV = v;
+			hitPrimitiveIndex = i;
+		}
+	}
+	if (best < 0.0f)
+		return false;
+
+	hitPosition = Position(pos.x + dir.x * best, pos.y + dir.y * best, pos.z + dir.z * best);
+	hitLength = best * std::sqrt(dir.x * dir.x + dir.y * dir.y + dir.z * dir.z);
+
+	const int32_t*	idx = myPrims[hitPrimitiveIndex].pointIndices;
+	const Position&	p0 = myPositions[idx[0]];
+	const Position&	p1 = myPositions[idx[1]];
+	const Position&	p2 = myPositions[idx[2]];
+	const float e1[3] = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+	const float e2[3] = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+	hitNormal = Vector(e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]);
+	hitNormal.normalize();
+	return true;
+}
+
+const SOP_ColorInfo*
+MockSOPInput::getVtxColors() const
+{
+	return nullptr;
+}
+
+const SOP_TextureInfo*
+MockSOPInput::getVtxTextures() const
+{
+	return nullptr;
+}
+
+const SOP_ColorInfo*
+MockSOPInput::getPrimColors() const
+{
+	return nullptr;
+}
+
+bool
+MockSOPInput::hasVtxColors() const
+{
+	return false;
+}
+
+bool
+MockSOPInput::hasPrimColors() const
+{
+	return false;
+}
+
+void
+MockSOPOutput::clear()
+{
+	myPositions.clear();
+	myNormals.clear();
+	myColors.clear();
+	myTexCoords.clear();
+	myTexLayers = 0;
+	myTriangles.clear();
+	myLineIndices.clear();
+	myLineSizes.clear();
+	myParticles = 0;
+	myCustomAttributes.clear();
+}
+
+int32_t
+MockSOPOutput::addPoint(const Position& pos)
+{
+	myPositions.push_back(pos);
+	return static_cast<int32_t>(myPositions.size() - 1);
+}
+
+bool
+MockSOPOutput::addPoints(const Position* pos, int32_t numPoints)
+{
+	myPositions.insert(myPositions.end(), pos, pos + numPoints);
+	return true;
+}
+
+int32_t
+MockSOPOutput::getNumPoints()
+{
+	return static_cast<int32_t>(myPositions.size());
+}
+
+template <class T>
+static bool
+writeRange(std::vector<T>& dst, size_t numPoints, const T* src, int32_t count, int32_t start)
+{
+	if (start < 0 || start + static_cast<size_t>(count) > numPoints)
+		return false;
+	if (dst.size() < numPoints)
+		dst.resize(numPoints);
+	std::copy(src, src + count, dst.begin() + start);
+	return true;
+}
+
+bool
+MockSOPOutput::setNormal(const Vector& n, int32_t pointIdx)
+{
+	return writeRange(myNormals, myPositions.size(), &n, 1, pointIdx);
+}
+
+bool
+MockSOPOutput::setNormals(const Vector* n, int32_t numPoints, int32_t startPointIdx)
+{
+	return writeRange(myNormals, myPositions.size(), n, numPoints, startPointIdx);
+}
+
+bool
+MockSOPOutput::hasNormal()
+{
+	return !myNormals.empty();
+}
+
+bool
+MockSOPOutput::setColor(const Color& c, int32_t pointIdx)
+{
+	return writeRange(myColors, myPositions.size(), &c, 1, pointIdx);
+}
+
+bool
+MockSOPOutput::setColors(const Color* colors, int32_t numPoints, int32_t startPointIdx)
+{
+	return writeRange(myColors, myPositions.size(), colors, numPoints, startPointIdx);
+}
+
+bool
+MockSOPOutput::hasColor()
+{
+	return !myColors.empty();
+}
+
+bool
+MockSOPOutput::setTexCoord(const TexCoord* tex, int32_t numLayers, int32_t pointIdx)
+{
+	return setTexCoords(tex, 1, numLayers, pointIdx);
+}
+
+bool
+MockSOPOutput::setTexCoords(const TexCoord* t, int32_t numPoints, int32_t numLayers, int32_t startPointIdx)
+{
+	if (numLayers < 1)
+		return false;
+	myTexLayers = std::max(myTexLayers, numLayers);
+	return writeRange(myTexCoords, myPositions.size() * myTexLayers, t,
+						numPoints * numLayers, startPointIdx * myTexLayers);
+}
+
+bool
+MockSOPOutput::hasTexCoord()
+{
+	return !myTexCoords.empty();
+}
+
+int32_t
+MockSOPOutput::getNumTexCoordLayers()
+{
+	return myTexLayers;
+}
+
+bool
+MockSOPOutput::setCustomAttribute(const SOP_CustomAttribData* cu, int32_t numPoints)
+{
+	if (!cu || !cu->name)
+		return false;
+
+	std::vector<float>&	data = myCustomAttributes[cu->name];
+	const size_t		count = static_cast<size_t>(numPoints) * cu->numComponents;
+	data.resize(count);
+	if (cu->attribType == AttribType::Float && cu->floatData)
+		std::copy(cu->floatData, cu->floatData + count, data.begin());
+	else if (cu->intData)
+		std::copy(cu->intData, cu->intData + count, data.begin());
+	return true;
+}
+
+bool
+MockSOPOutput::hasCustomAttibutes()
+{
+	return !myCustomAttributes.empty();
+}
+
+bool
+MockSOPOutput::addTriangle(int32_t ptIdx1, int32_t ptIdx2, int32_t ptIdx3)
+{
+	myTriangles.push_back(ptIdx1);
+	myTriangles.push_back(ptIdx2);
+	myTriangles.push_back(ptIdx3);
+	return true;
+}
+
+bool
+MockSOPOutput::addTriangles(const int32_t* indices, int32_t size)
+{
+	myTriangles.insert(myTriangles.end(), indices, indices + 3 * static_cast<size_t>(size));
+	return true;
+}
+
+bool
+MockSOPOutput::addParticleSystem(int32_t numParticles, int32_t startIndex)
+{
+	myParticles += numParticles;
+	return true;
+}
+
+bool
+MockSOPOutput::addLine(const int32_t* indices, int32_t size)
+{
+	myLineIndices.insert(myLineIndices.end(), indices, indices + size);
+	myLineSizes.push_back(size);
+	return true;
+}
+
+bool
+MockSOPOutput::addLines(const int32_t* indices, int32_t* sizeOfEachLine, int32_t numOfLines)
+{
+	for (int32_t i = 0; i < numOfLines; i++)
+	{
+		addLine(indices, sizeOfEachLine[i]);
+		indices += sizeOfEachLine[i];
+	}
+	return true;
+}
+
+int32_t
+MockSOPOutput::getNumPrimitives()
+{
+	return numTriangles() + numLines() + myParticles;
+}
+
+bool
+MockSOPOutput::setBoundingBox(const BoundingBox& bbox)
+{
+	return true;
+}
+
+bool
+MockSOPOutput::addGroup(const SOP_GroupType& type, const char* name)
+{
+	return true;
+}
+
+bool
+MockSOPOutput::destroyGroup(const SOP_GroupType& type, const char* name)
+{
+	return true;
+}
+
+bool
+MockSOPOutput::addPointToGroup(int index, const char* name)
+{
+	return true;
+}
+
+bool
+MockSOPOutput::addPrimToGroup(int index, const char* name)
+{
+	return true;
+}
+
+bool
+MockSOPOutput::addToGroup(int index, const SOP_GroupType& type, const char* name)
+{
+	return true;
+}
+
+bool
+MockSOPOutput::discardFromPointGroup(int index, const char* name)
+{
+	return true;
+}
+
+bool
+MockSOPOutput::discardFromPrimGroup(int index, const char* name)
+{
+	return true;
+}
+
+bool
+MockSOPOutput::discardFromGroup(int index, const SOP_GroupType& type, const char* name)
+{
+	return true;
+}
+
+void
+MockSOPVBOOutput::enableNormal()
+{
+	myHasNormal = true;
+}
+
+void
+MockSOPVBOOutput::enableColor()
+{
+	myHasColor = true;
+}
+
+void
+MockSOPVBOOutput::enableTexCoord(int32_t numLayers)
+{
+	myTexLayers = std::max(1, numLayers);
+}
+
+bool
+MockSOPVBOOutput::hasNormal()
+{
+	return myHasNormal;
+}
+
+bool
+MockSOPVBOOutput::hasColor()
+{
+	return myHasColor;
+}
+
+bool
+MockSOPVBOOutput::hasTexCoord()
+{
+	return myTexLayers > 0;
+}
+
+bool
+MockSOPVBOOutput::hasCustomAttibutes()
+{
+	return !myCustomAttributes.empty();
+}
+
+bool
+MockSOPVBOOutput::addCustomAttribute(const SOP_CustomAttribInfo& cu)
+{
+	if (!cu.name)
+		return false;
+	myCustomAttributes[cu.name].assign(myPositions.size() * cu.numComponents, 0.0f);
+	return true;
+}
+
+void
+MockSOPVBOOutput::allocVBO(int32_t numVertices, int32_t numIndices, VBOBufferMode mode)
+{
+	myPositions.assign(numVertices, Position());
+	myNormals.assign(myHasNormal ? numVertices : 0, Vector());
+	myColors.assign(myHasColor ? numVertices : 0, Color());
+	myTexCoords.assign(static_cast<size_t>(numVertices) * myTexLayers, TexCoord());
+	myIndices.assign(numIndices, 0);
+	myUsedIndices = 0;
+}
+
+Position*
+MockSOPVBOOutput::getPos()
+{
+	return myPositions.data();
+}
+
+Vector*
+MockSOPVBOOutput::getNormals()
+{
+	return myHasNormal ? myNormals.data() : nullptr;
+}
+
+Color*
+MockSOPVBOOutput::getColors()
+{
+	return myHasColor ? myColors.data() : nullptr;
+}
+
+TexCoord*
+MockSOPVBOOutput::getTexCoords()
+{
+	return myTexLayers > 0 ? myTexCoords.data() : nullptr;
+}
+
+int32_t
+MockSOPVBOOutput::getNumTexCoordLayers()
+{
+	return myTexLayers;
+}
+
+int32_t*
+MockSOPVBOOutput::reserveIndices(int32_t numIndices)
+{
+	if (myUsedIndices + numIndices > myIndices.size())
+		myIndices.resize(myUsedIndices + numIndices);
+	int32_t*	res = myIndices.data() + myUsedIndices;
+	myUsedIndices += numIndices;
+	return res;
+}
+
+int32_t*
+MockSOPVBOOutput::addTriangles(int32_t numTriangles)
+{
+	return reserveIndices(3 * numTriangles);
+}
+
+int32_t*
+MockSOPVBOOutput::addParticleSystem(int32_t numParticles)
+{
+	return reserveIndices(numParticles);
+}
+
+int32_t*
+MockSOPVBOOutput::addLines(int32_t numIndices)
+{
+	return reserveIndices(numIndices);
+}
+
+bool
+MockSOPVBOOutput::getCustomAttribute(SOP_CustomAttribData* cu, const char* name)
+{
+	auto it = myCustomAttributes.find(name);
+	if (it == myCustomAttributes.end())
+		return false;
+	cu->floatData = it->second.data();
+	return true;
+}
+
+void
+MockSOPVBOOutput::updateComplete()
+{
+}
+
+bool
+MockSOPVBOOutput::setBoundingBox(const BoundingBox& bbox)
+{
+	return true;
+}
+
+#pragma endregion
+
+#pragma region DAT
+
+MockDATInput::MockDATInput(int32_t rows, int32_t cols, bool table) :
+	myCells(static_cast<size_t>(rows) * cols)
+{
+	opPath = "/mock/dat_in";
+	opId = 4;
+	numRows = rows;
+	numCols = cols;
+	isTable = table;
+	totalCooks = 1;
+	customOP = nullptr;
+	updatePointers();
+}
+
+void
+MockDATInput::setCell(int32_t row, int32_t col, const std::string& value)
+{
+	myCells[static_cast<size_t>(row) * numCols + col] = value;
+	updatePointers();
+}
+
+void
+MockDATInput::updatePointers()
+{
+	myCellPointers.resize(myCells.size());
+	for (size_t i = 0; i < myCells.size(); i++)
+		myCellPointers[i] = myCells[i].c_str();
+	cellData = myCellPointers.data();
+}
+
+void
+MockDATOutput::setOutputDataType(DAT_OutDataType type)
+{
+	myType = type;
+}
+
+DAT_OutDataType
+MockDATOutput::getOutputDataType()
+{
+	return myType;
+}
+
+void
+MockDATOutput::setTableSize(const int32_t rows, const int32_t cols)
+{
+	myRows = rows;
+	myCols = cols;
+	myCells.assign(static_cast<size_t>(rows) * cols, std::string());
+}
+
+void
+MockDATOutput::getTableSize(int32_t* rows, int32_t* cols)
+{
+	*rows = myRows;
+	*cols = myCols;
+}
+
+bool
+MockDATOutput::setText(const char* str)
+{
+	myText = str ? str : "";
+	return myType == DAT_OutDataType::Text;
+}
+
+int32_t
+MockDATOutput::findRow(const char* rowName, int32_t hintRowIndex)
+{
+	for (int32_t r = 0; r < myRows && myCols > 0; r++)
+		if (myCells[static_cast<size_t>(r) * myCols] == rowName)
+			return r;
+	return -1;
+}
+
+int32_t
+MockDATOutput::findCol(const char* colName, int32_t hintColIndex)
+{
+	for (int32_t c = 0; c < myCols && myRows > 0; c++)
+		if (myCells[c] == colName)
+			return c;
+	return -1;
+}
+
+bool
+MockDATOutput::inTable(int32_t row, int32_t col) const
+{
+	return row >= 0 && row < myRows && col >= 0 && col < myCols;
+}
+
+bool
+MockDATOutput::setCellString(int32_t row, int32_t col, const char* str)
+{
+	if (!inTable(row, col))
+		return false;
+	myCells[static_cast<size_t>(row) * myCols + col] = str ? str : "";
+	return true;
+}
+
+bool
+MockDATOutput::setCellInt(int32_t row, int32_t col, int32_t value)
+{
+	return setCellString(row, col, std::to_string(value).c_str());
+}
+
+bool
+MockDATOutput::setCellDouble(int32_t row, int32_t col, double value)
+{
+	return setCellString(row, col, std::to_string(value).c_str());
+}
+
+const char*
+MockDATOutput::getCellString(int32_t row, int32_t col)
+{
+	return inTable(row, col) ? myCells[static_cast<size_t>(row) * myCols + col].c_str() : nullptr;
+}
+
+bool
+MockDATOutput::getCellInt(int32_t row, int32_t col, int32_t* res)
+{
+	const char*	str = getCellString(row, col);
+	if (!str)
+		return false;
+	*res = std::atoi(str);
+	return true;
+}
+
+bool
+MockDATOutput::getCellDouble(int32_t row, int32_t col, double* res)
+{
+	const char*	str = getCellString(row, col);
+	if (!str)
+		return false;
+	*res = std::atof(str);
+	return true;
+}
+
+#pragma endregion
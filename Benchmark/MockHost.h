@@ -0,0 +1,622 @@
+#ifndef __MockHost__
+#define __MockHost__
+
+#include "CPlusPlus_Common.h"
+#include "TOP_CPlusPlusBase.h"
+#include "CHOP_CPlusPlusBase.h"
+#include "SOP_CPlusPlusBase.h"
+#include "DAT_CPlusPlusBase.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+This file implements the side of the SDK that TouchDesigner normally provides:
+OP_Inputs, OP_ParameterManager, the TOP_Context/TOP_Output pair and the
+CHOP/SOP/DAT outputs. It has no GPU and no UI, inputs are plain CPU arrays that
+the benchmark fills with synthetic data. The goal is to be faithful enough that
+every operator in this repository runs its normal execute() path, not to be a
+complete reimplementation of TouchDesigner.
+*/
+
+class MockString : public TD::OP_String
+{
+public:
+	MockString() = default;
+
+	virtual ~MockString() = default;
+
+	virtual void	setString(const char* val) override;
+
+	const std::string&	str() const { return myValue; }
+
+private:
+	std::string		myValue;
+};
+
+// Value of a single parameter as seen through OP_Inputs
+struct MockParameter
+{
+	double						values[4] = { 0.0, 0.0, 0.0, 0.0 };
+	std::string					str;
+	std::vector<std::string>	menuNames;
+	bool						enabled = true;
+
+	const TD::OP_CHOPInput*		chop = nullptr;
+	const TD::OP_SOPInput*		sop = nullptr;
+	const TD::OP_TOPInput*		top = nullptr;
+	const TD::OP_DATInput*		dat = nullptr;
+};
+
+class MockInputs : public TD::OP_Inputs
+{
+public:
+	MockInputs();
+
+	virtual ~MockInputs() = default;
+
+	// Parameter values, menus accept either the menu entry name or its index
+	MockParameter&	par(const char* name);
+
+	bool			hasPar(const char* name) const;
+
+	void			setPar(const char* name, double v0, double v1 = 0.0, double v2 = 0.0, double v3 = 0.0);
+
+	void			setPar(const char* name, const char* value);
+
+	void			setParCHOP(const char* name, const TD::OP_CHOPInput* chop);
+
+	void			setParSOP(const char* name, const TD::OP_SOPInput* sop);
+
+	void			setParTOP(const char* name, const TD::OP_TOPInput* top);
+
+	// Wired inputs, index is the input connector
+	void			setInput(int32_t index, const TD::OP_CHOPInput* chop);
+
+	void			setInput(int32_t index, const TD::OP_SOPInput* sop);
+
+	void			setInput(int32_t index, const TD::OP_TOPInput* top);
+
+	void			setInput(int32_t index, const TD::OP_DATInput* dat);
+
+	// Advances the timeline by one frame at 60 fps
+	void			nextFrame();
+
+	virtual int32_t		getNumInputs() const override;
+
+	virtual const TD::OP_CHOPInput*		getInputCHOP(int32_t index) const override;
+
+	virtual const TD::OP_DATInput*		getParDAT(const char* name) const override;
+
+	virtual const TD::OP_CHOPInput*		getParCHOP(const char* name) const override;
+
+	virtual const TD::OP_ObjectInput*	getParObject(const char* name) const override;
+
+	virtual double		getParDouble(const char* name, int32_t index = 0) const override;
+
+	virtual bool		getParDouble2(const char* name, double& v0, double& v1) const override;
+
+	virtual bool		getParDouble3(const char* name, double& v0, double& v1, double& v2) const override;
+
+	virtual bool		getParDouble4(const char* name, double& v0, double& v1, double& v2, double& v3) const override;
+
+	virtual int32_t		getParInt(const char* name, int32_t index = 0) const override;
+
+	virtual bool		getParInt2(const char* name, int32_t& v0, int32_t& v1) const override;
+
+	virtual bool		getParInt3(const char* name, int32_t& v0, int32_t& v1, int32_t& v2) const override;
+
+	virtual bool		getParInt4(const char* name, int32_t& v0, int32_t& v1, int32_t& v2, int32_t& v3) const override;
+
+	virtual const char*	getParString(const char* name) const override;
+
+	virtual const char*	getParFilePath(const char* name) const override;
+
+	virtual bool		getRelativeTransform(const char* from_name, const char* to_name, double matrix[4][4]) const override;
+
+	virtual void		enablePar(const char* name, bool onoff) const override;
+
+	virtual const TD::OP_DATInput*		getDAT(const char* path) const override;
+
+	virtual const TD::OP_CHOPInput*		getCHOP(const char* path) const override;
+
+	virtual const TD::OP_ObjectInput*	getObject(const char* path) const override;
+
+	virtual const TD::OP_SOPInput*		getParSOP(const char* name) const override;
+
+	virtual const TD::OP_SOPInput*		getInputSOP(int32_t index) const override;
+
+	virtual const TD::OP_SOPInput*		getSOP(const char* path) const override;
+
+	virtual const TD::OP_DATInput*		getInputDAT(int32_t index) const override;
+
+	virtual PyObject*					getParPython(const char* name) const override;
+
+	virtual const TD::OP_TimeInfo*		getTimeInfo() const override;
+
+	virtual const TD::OP_TOPInput*		getTOP(const char* path) const override;
+
+	virtual const TD::OP_TOPInput*		getInputTOP(int32_t index) const override;
+
+	virtual const TD::OP_TOPInput*		getParTOP(const char* name) const override;
+
+private:
+	virtual const TD::OP_TOPInputOpenGL*	getInputTOPOpenGL(int32_t index) const override;
+
+	virtual const TD::OP_TOPInputOpenGL*	getParTOPOpenGL(const char* name) const override;
+
+	virtual const TD::OP_TOPInputOpenGL*	getTOPOpenGL(const char* path) const override;
+
+	virtual void*	getTOPDataInCPUMemory(const TD::OP_TOPInputOpenGL* top,
+											const TD::OP_TOPInputDownloadOptionsOpenGL* options) const override;
+
+	const MockParameter*	findPar(const char* name) const;
+
+	template <class T>
+	static const T*			inputAt(const std::vector<const T*>& inputs, int32_t index);
+
+	// enablePar() is const in the SDK
+	mutable std::map<std::string, MockParameter>	myParameters;
+
+	std::vector<const TD::OP_CHOPInput*>	myCHOPInputs;
+	std::vector<const TD::OP_SOPInput*>		mySOPInputs;
+	std::vector<const TD::OP_TOPInput*>		myTOPInputs;
+	std::vector<const TD::OP_DATInput*>		myDATInputs;
+
+	TD::OP_TimeInfo		myTimeInfo;
+};
+
+// Records every parameter appended by setupParameters() into a MockInputs
+// with its default value, so an operator cooks with its shipped defaults
+// unless the benchmark overrides them.
+class MockParameterManager : public TD::OP_ParameterManager
+{
+public:
+	explicit MockParameterManager(MockInputs* inputs);
+
+	virtual ~MockParameterManager() = default;
+
+	virtual TD::OP_ParAppendResult	appendFloat(const TD::OP_NumericParameter& np, int32_t size = 1) override;
+	virtual TD::OP_ParAppendResult	appendInt(const TD::OP_NumericParameter& np, int32_t size = 1) override;
+	virtual TD::OP_ParAppendResult	appendXY(const TD::OP_NumericParameter& np) override;
+	virtual TD::OP_ParAppendResult	appendXYZ(const TD::OP_NumericParameter& np) override;
+	virtual TD::OP_ParAppendResult	appendUV(const TD::OP_NumericParameter& np) override;
+	virtual TD::OP_ParAppendResult	appendUVW(const TD::OP_NumericParameter& np) override;
+	virtual TD::OP_ParAppendResult	appendRGB(const TD::OP_NumericParameter& np) override;
+	virtual TD::OP_ParAppendResult	appendRGBA(const TD::OP_NumericParameter& np) override;
+	virtual TD::OP_ParAppendResult	appendToggle(const TD::OP_NumericParameter& np) override;
+	virtual TD::OP_ParAppendResult	appendPulse(const TD::OP_NumericParameter& np) override;
+	virtual TD::OP_ParAppendResult	appendString(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendFile(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendFolder(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendDAT(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendCHOP(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendTOP(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendObject(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendMenu(const TD::OP_StringParameter& sp, int32_t nitems,
+												const char** names, const char** labels) override;
+	virtual TD::OP_ParAppendResult	appendStringMenu(const TD::OP_StringParameter& sp, int32_t nitems,
+												const char** names, const char** labels) override;
+	virtual TD::OP_ParAppendResult	appendSOP(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendPython(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendOP(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendCOMP(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendMAT(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendPanelCOMP(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendHeader(const TD::OP_StringParameter& np) override;
+	virtual TD::OP_ParAppendResult	appendMomentary(const TD::OP_NumericParameter& np) override;
+	virtual TD::OP_ParAppendResult	appendWH(const TD::OP_NumericParameter& np) override;
+	virtual TD::OP_ParAppendResult	appendDynamicStringMenu(const TD::OP_StringParameter& sp) override;
+	virtual TD::OP_ParAppendResult	appendDynamicMenu(const TD::OP_NumericParameter& np) override;
+
+private:
+	TD::OP_ParAppendResult	appendNumeric(const TD::OP_NumericParameter& np, int32_t size);
+
+	TD::OP_ParAppendResult	appendText(const TD::OP_StringParameter& sp);
+
+	MockInputs*		myInputs;
+};
+
+#pragma region TOP
+
+// RGBA8 image held in CPU memory, downloadTexture() converts it to the
+// requested format the same way the GPU readback would.
+class MockTOPInput : public TD::OP_TOPInput
+{
+public:
+	MockTOPInput(int width, int height);
+
+	virtual ~MockTOPInput() = default;
+
+	uint8_t*	pixels() { return myPixels.data(); }
+
+	int			width() const { return static_cast<int>(textureDesc.width); }
+
+	int			height() const { return static_cast<int>(textureDesc.height); }
+
+	// Marks the texture as changed, bumps totalCooks
+	void		touch() { totalCooks++; }
+
+	virtual TD::OP_SmartRef<TD::OP_TOPDownloadResult>	downloadTexture(const TD::OP_TOPInputDownloadOptions& opts, void* reserved1) const override;
+
+	virtual const TD::OP_CUDAArrayInfo*	getCUDAArray(const TD::OP_CUDAAcquireInfo& info, void* reserved2) const override;
+
+protected:
+	virtual void*	reserved0() override { return nullptr; }
+	virtual void*	reserved1() override { return nullptr; }
+	virtual void*	reserved2() override { return nullptr; }
+	virtual void*	reserved3() override { return nullptr; }
+	virtual void*	reserved4() override { return nullptr; }
+
+private:
+	std::vector<uint8_t>	myPixels;
+};
+
+class MockTOPContext : public TD::TOP_Context
+{
+public:
+	MockTOPContext() = default;
+
+	virtual ~MockTOPContext() = default;
+
+	virtual TD::OP_SmartRef<TD::TOP_Buffer>	createOutputBuffer(uint64_t size, TD::TOP_BufferFlags flags, void* reserved) override;
+
+	virtual void		returnBuffer(TD::OP_SmartRef<TD::TOP_Buffer>* buf) override;
+
+	virtual PyObject*	createArgumentsTuple(int numOtherArgs, void* reserved1) override { return nullptr; }
+
+	virtual PyObject*	callPythonCallback(const char* functionName, PyObject* arguments, PyObject* keywords,
+											void* reserved1) override { return nullptr; }
+
+	virtual bool		beginCUDAOperations(void* reserved1) override { return false; }
+
+	virtual void		endCUDAOperations(void* reserved1) override {}
+
+	uint64_t			buffersCreated() const { return myBuffersCreated.load(); }
+
+	uint64_t			bytesCreated() const { return myBytesCreated.load(); }
+
+	uint64_t			buffersReturned() const { return myBuffersReturned.load(); }
+
+protected:
+	virtual void*	reservedFunc0() override { return nullptr; }
+	virtual void*	reservedFunc1() override { return nullptr; }
+	virtual void*	reservedFunc2() override { return nullptr; }
+	virtual void*	reservedFunc3() override { return nullptr; }
+	virtual void*	reservedFunc4() override { return nullptr; }
+	virtual void*	reservedFunc5() override { return nullptr; }
+	virtual void*	reservedFunc6() override { return nullptr; }
+	virtual void*	reservedFunc7() override { return nullptr; }
+	virtual void*	reservedFunc8() override { return nullptr; }
+	virtual void*	reservedFunc9() override { return nullptr; }
+	virtual void*	reservedFunc10() override { return nullptr; }
+	virtual void*	reservedFunc11() override { return nullptr; }
+	virtual void*	reservedFunc12() override { return nullptr; }
+	virtual void*	reservedFunc13() override { return nullptr; }
+	virtual void*	reservedFunc14() override { return nullptr; }
+
+	virtual void	reserved0() override {}
+	virtual void	reserved1() override {}
+	virtual void	reserved2() override {}
+	virtual void	reserved3() override {}
+	virtual void	reserved4() override {}
+	virtual void	reserved5() override {}
+	virtual void	reserved6() override {}
+	virtual void	reserved7() override {}
+	virtual void	reserved8() override {}
+	virtual void	reserved9() override {}
+
+private:
+	std::atomic<uint64_t>	myBuffersCreated{ 0 };
+	std::atomic<uint64_t>	myBytesCreated{ 0 };
+	std::atomic<uint64_t>	myBuffersReturned{ 0 };
+};
+
+class MockTOPOutput : public TD::TOP_Output
+{
+public:
+	MockTOPOutput() = default;
+
+	virtual ~MockTOPOutput() = default;
+
+	virtual void	uploadBuffer(TD::OP_SmartRef<TD::TOP_Buffer>* buf, const TD::TOP_UploadInfo& info, void* reserved) override;
+
+	virtual const TD::OP_CUDAArrayInfo*	createCUDAArray(const TD::TOP_CUDAOutputInfo& info, void* reserved) override;
+
+	// Number of uploads since the last call to reset()
+	int						uploads() const { return myUploads; }
+
+	const TD::TOP_UploadInfo&	lastUploadInfo() const { return myLastInfo; }
+
+	// Pixels of the last upload, nullptr before the first one
+	const void*				lastData() const { return myLastBuffer ? myLastBuffer->data : nullptr; }
+
+	void					reset() { myUploads = 0; }
+
+private:
+	virtual void	reserved0() override {}
+	virtual void	reserved1() override {}
+	virtual void	reserved2() override {}
+	virtual void	reserved3() override {}
+	virtual void	reserved4() override {}
+	virtual void	reserved5() override {}
+	virtual void	reserved6() override {}
+	virtual void	reserved7() override {}
+	virtual void	reserved8() override {}
+	virtual void	reserved9() override {}
+
+	// Holds on to the last uploaded buffer the way TouchDesigner does until
+	// the upload completes
+	TD::OP_SmartRef<TD::TOP_Buffer>	myLastBuffer;
+	TD::TOP_UploadInfo				myLastInfo;
+	int								myUploads = 0;
+};
+
+#pragma endregion
+
+#pragma region CHOP
+
+class MockCHOPInput : public TD::OP_CHOPInput
+{
+public:
+	MockCHOPInput(int32_t numChannels, int32_t numSamples, double rate = 60.0);
+
+	float*		channel(int32_t i) { return myData[i].data(); }
+
+	void		setChannelName(int32_t i, const char* name);
+
+	void		touch() { totalCooks++; }
+
+private:
+	void		updatePointers();
+
+	std::vector<std::vector<float>>	myData;
+	std::vector<std::string>		myNames;
+	std::vector<const float*>		myChannelPointers;
+	std::vector<const char*>		myNamePointers;
+};
+
+// Storage behind the CHOP_Output handed to execute()
+class MockCHOPOutput
+{
+public:
+	MockCHOPOutput() = default;
+
+	TD::CHOP_Output*	allocate(int32_t numChannels, int32_t numSamples, float sampleRate, uint32_t startIndex);
+
+	TD::CHOP_Output*	output() { return myOutput.get(); }
+
+	std::vector<MockString>&	names() { return myNames; }
+
+private:
+	std::vector<std::vector<float>>	myData;
+	std::vector<float*>				myChannelPointers;
+	std::vector<MockString>			myNames;
+	std::vector<const char*>		myNamePointers;
+	std::unique_ptr<TD::CHOP_Output>	myOutput;
+};
+
+#pragma endregion
+
+#pragma region SOP
+
+class MockSOPInput : public TD::OP_SOPInput
+{
+public:
+	MockSOPInput();
+
+	virtual ~MockSOPInput() = default;
+
+	// Regular grid in the XY plane spanning [-1, 1], two triangles per cell
+	static std::unique_ptr<MockSOPInput>	grid(int rows, int cols);
+
+	// Closed UV sphere of radius 1 made of triangles, with normals
+	static std::unique_ptr<MockSOPInput>	sphere(int rings, int segments);
+
+	// Random points inside the unit cube, no primitives
+	static std::unique_ptr<MockSOPInput>	pointCloud(int numPoints, unsigned seed);
+
+	int32_t		addPoint(const TD::Position& p);
+
+	void		addTriangle(int32_t a, int32_t b, int32_t c);
+
+	// Must be called after the geometry changes and before a cook
+	void		finalize();
+
+	void		touch() { totalCooks++; }
+
+	virtual int32_t		getNumPoints() const override;
+	virtual int32_t		getNumVertices() const override;
+	virtual int32_t		getNumPrimitives() const override;
+	virtual int32_t		getNumCustomAttributes() const override;
+	virtual const TD::Position*		getPointPositions() const override;
+	virtual const TD::SOP_NormalInfo*	getNormals() const override;
+	virtual const TD::SOP_ColorInfo*	getColors() const override;
+	virtual const TD::SOP_TextureInfo*	getTextures() const override;
+	virtual const TD::SOP_CustomAttribData*	getCustomAttribute(int32_t customAttribIndex) const override;
+	virtual const TD::SOP_CustomAttribData*	getCustomAttribute(const char* customAttribName) const override;
+	virtual bool		hasNormals() const override;
+	virtual bool		hasColors() const override;
+	virtual bool		isInside(const TD::Position& pos) override;
+	virtual bool		sendRay(const TD::Position& pos, const TD::Vector& dir,
+								TD::Position& hitPosition, float& hitLength, TD::Vector& hitNormal,
+								float& hitU, float& hitV, int& hitPrimitiveIndex) override;
+	virtual const TD::SOP_ColorInfo*	getVtxColors() const override;
+	virtual const TD::SOP_TextureInfo*	getVtxTextures() const override;
+	virtual const TD::SOP_ColorInfo*	getPrimColors() const override;
+	virtual bool		hasVtxColors() const override;
+	virtual bool		hasPrimColors() const override;
+
+private:
+	bool		intersect(const TD::Position& orig, const TD::Vector& dir, int prim, float& t, float& u, float& v) const;
+
+	std::vector<TD::Position>			myPositions;
+	std::vector<TD::Vector>				myNormalData;
+	std::vector<TD::Color>				myColorData;
+	std::vector<TD::TexCoord>			myTextureData;
+	std::vector<int32_t>				myIndices;
+	std::vector<TD::SOP_PrimitiveInfo>	myPrims;
+
+	TD::SOP_NormalInfo		myNormals;
+	TD::SOP_ColorInfo		myColors;
+	TD::SOP_TextureInfo		myTextures;
+};
+
+class MockSOPOutput : public TD::SOP_Output
+{
+public:
+	MockSOPOutput() = default;
+
+	virtual ~MockSOPOutput() = default;
+
+	void			clear();
+
+	int32_t			numTriangles() const { return static_cast<int32_t>(myTriangles.size() / 3); }
+
+	int32_t			numLines() const { return static_cast<int32_t>(myLineSizes.size()); }
+
+	virtual int32_t	addPoint(const TD::Position& pos) override;
+	virtual bool	addPoints(const TD::Position* pos, int32_t numPoints) override;
+	virtual int32_t	getNumPoints() override;
+	virtual bool	setNormal(const TD::Vector& n, int32_t pointIdx) override;
+	virtual bool	setNormals(const TD::Vector* n, int32_t numPoints, int32_t startPointIdx) override;
+	virtual bool	hasNormal() override;
+	virtual bool	setColor(const TD::Color& c, int32_t pointIdx) override;
+	virtual bool	setColors(const TD::Color* colors, int32_t numPoints, int32_t startPointIdx) override;
+	virtual bool	hasColor() override;
+	virtual bool	setTexCoord(const TD::TexCoord* tex, int32_t numLayers, int32_t pointIdx) override;
+	virtual bool	setTexCoords(const TD::TexCoord* t, int32_t numPoints, int32_t numLayers, int32_t startPointIdx) override;
+	virtual bool	hasTexCoord() override;
+	virtual int32_t	getNumTexCoordLayers() override;
+	virtual bool	setCustomAttribute(const TD::SOP_CustomAttribData* cu, int32_t numPoints) override;
+	virtual bool	hasCustomAttibutes() override;
+	virtual bool	addTriangle(int32_t ptIdx1, int32_t ptIdx2, int32_t ptIdx3) override;
+	virtual bool	addTriangles(const int32_t* indices, int32_t size) override;
+	virtual bool	addParticleSystem(int32_t numParticles, int32_t startIndex) override;
+	virtual bool	addLine(const int32_t* indices, int32_t size) override;
+	virtual bool	addLines(const int32_t* indices, int32_t* sizeOfEachLine, int32_t numOfLines) override;
+	virtual int32_t	getNumPrimitives() override;
+	virtual bool	setBoundingBox(const TD::BoundingBox& bbox) override;
+	virtual bool	addGroup(const TD::SOP_GroupType& type, const char* name) override;
+	virtual bool	destroyGroup(const TD::SOP_GroupType& type, const char* name) override;
+	virtual bool	addPointToGroup(int index, const char* name) override;
+	virtual bool	addPrimToGroup(int index, const char* name) override;
+	virtual bool	addToGroup(int index, const TD::SOP_GroupType& type, const char* name) override;
+	virtual bool	discardFromPointGroup(int index, const char* name) override;
+	virtual bool	discardFromPrimGroup(int index, const char* name) override;
+	virtual bool	discardFromGroup(int index, const TD::SOP_GroupType& type, const char* name) override;
+
+private:
+	std::vector<TD::Position>	myPositions;
+	std::vector<TD::Vector>		myNormals;
+	std::vector<TD::Color>		myColors;
+	std::vector<TD::TexCoord>	myTexCoords;
+	int32_t						myTexLayers = 0;
+	std::vector<int32_t>		myTriangles;
+	std::vector<int32_t>		myLineIndices;
+	std::vector<int32_t>		myLineSizes;
+	int32_t						myParticles = 0;
+	std::map<std::string, std::vector<float>>	myCustomAttributes;
+};
+
+class MockSOPVBOOutput : public TD::SOP_VBOOutput
+{
+public:
+	MockSOPVBOOutput() = default;
+
+	virtual ~MockSOPVBOOutput() = default;
+
+	virtual void		enableNormal() override;
+	virtual void		enableColor() override;
+	virtual void		enableTexCoord(int32_t numLayers = 0) override;
+	virtual bool		hasNormal() override;
+	virtual bool		hasColor() override;
+	virtual bool		hasTexCoord() override;
+	virtual bool		hasCustomAttibutes() override;
+	virtual bool		addCustomAttribute(const TD::SOP_CustomAttribInfo& cu) override;
+	virtual void		allocVBO(int32_t numVertices, int32_t numIndices, TD::VBOBufferMode mode) override;
+	virtual TD::Position*	getPos() override;
+	virtual TD::Vector*		getNormals() override;
+	virtual TD::Color*		getColors() override;
+	virtual TD::TexCoord*	getTexCoords() override;
+	virtual int32_t		getNumTexCoordLayers() override;
+	virtual int32_t*	addTriangles(int32_t numTriangles) override;
+	virtual int32_t*	addParticleSystem(int32_t numParticles) override;
+	virtual int32_t*	addLines(int32_t numIndices) override;
+	virtual bool		getCustomAttribute(TD::SOP_CustomAttribData* cu, const char* name) override;
+	virtual void		updateComplete() override;
+	virtual bool		setBoundingBox(const TD::BoundingBox& bbox) override;
+
+private:
+	int32_t*			reserveIndices(int32_t numIndices);
+
+	bool					myHasNormal = false;
+	bool					myHasColor = false;
+	int32_t					myTexLayers = 0;
+	std::vector<TD::Position>	myPositions;
+	std::vector<TD::Vector>		myNormals;
+	std::vector<TD::Color>		myColors;
+	std::vector<TD::TexCoord>	myTexCoords;
+	std::vector<int32_t>		myIndices;
+	size_t					myUsedIndices = 0;
+	std::map<std::string, std::vector<float>>	myCustomAttributes;
+};
+
+#pragma endregion
+
+#pragma region DAT
+
+class MockDATInput : public TD::OP_DATInput
+{
+public:
+	MockDATInput(int32_t rows, int32_t cols, bool table = true);
+
+	void		setCell(int32_t row, int32_t col, const std::string& value);
+
+	void		touch() { totalCooks++; }
+
+private:
+	void		updatePointers();
+
+	std::vector<std::string>	myCells;
+	std::vector<const char*>	myCellPointers;
+};
+
+class MockDATOutput : public TD::DAT_Output
+{
+public:
+	MockDATOutput() = default;
+
+	virtual ~MockDATOutput() = default;
+
+	virtual void	setOutputDataType(TD::DAT_OutDataType type) override;
+	virtual TD::DAT_OutDataType	getOutputDataType() override;
+	virtual void	setTableSize(const int32_t rows, const int32_t cols) override;
+	virtual void	getTableSize(int32_t* rows, int32_t* cols) override;
+	virtual bool	setText(const char* str) override;
+	virtual int32_t	findRow(const char* rowName, int32_t hintRowIndex = -1) override;
+	virtual int32_t	findCol(const char* colName, int32_t hintColIndex = -1) override;
+	virtual bool	setCellString(int32_t row, int32_t col, const char* str) override;
+	virtual bool	setCellInt(int32_t row, int32_t col, int32_t value) override;
+	virtual bool	setCellDouble(int32_t row, int32_t col, double value) override;
+	virtual const char*	getCellString(int32_t row, int32_t col) override;
+	virtual bool	getCellInt(int32_t row, int32_t col, int32_t* res) override;
+	virtual bool	getCellDouble(int32_t row, int32_t col, double* res) override;
+
+private:
+	bool			inTable(int32_t row, int32_t col) const;
+
+	TD::DAT_OutDataType			myType = TD::DAT_OutDataType::Table;
+	int32_t						myRows = 0;
+	int32_t						myCols = 0;
+	std::vector<std::string>	myCells;
+	std::string					myText;
+};
+
+#pragma endregion
+
+#endif
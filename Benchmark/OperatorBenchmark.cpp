@@ -0,0 +1,923 @@
+/*
+Headless benchmark for the operators in this repository.
+
+Every plugin is loaded through its Create*Instance entry point, cooked with the
+mock host in MockHost.h and execute() is timed over synthetic inputs at several
+sizes. Plugins that were not built (missing OpenCV, CGAL, ...) are skipped.
+
+Usage:
+	OperatorBenchmark [--filter <text>] [--iterations <n>] [--warmup <n>]
+	                  [--plugins <dir>] [--classifier <cascade.xml>] [--info]
+*/
+
+#include "PluginHost.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef PLUGIN_DIR
+#define PLUGIN_DIR "."
+#endif
+
+namespace
+{
+	struct Options
+	{
+		std::string		filter;
+		std::string		pluginDir = PLUGIN_DIR;
+		std::string		classifier;
+		int				iterations = 20;
+		int				warmup = 3;
+		bool			info = false;
+	};
+
+	struct Stats
+	{
+		double	min = 0.0;
+		double	median = 0.0;
+		double	p95 = 0.0;
+		double	mean = 0.0;
+	};
+
+	Stats
+	summarize(std::vector<double> samples)
+	{
+		Stats	s;
+		if (samples.empty())
+			return s;
+
+		std::sort(samples.begin(), samples.end());
+		const size_t	n = samples.size();
+		s.min = samples.front();
+		s.median = n % 2 ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+		s.p95 = samples[std::min(n - 1, static_cast<size_t>(std::ceil(0.95 * n)) - 1)];
+		s.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+		return s;
+	}
+
+	class Benchmark
+	{
+	public:
+		explicit Benchmark(const Options& opts) :
+			myOptions{ opts }
+		{
+		}
+
+		const Options&	options() const { return myOptions; }
+
+		bool
+		wants(const char* op) const
+		{
+			return myOptions.filter.empty() || std::strstr(op, myOptions.filter.c_str()) != nullptr;
+		}
+
+		// Returns nullptr and reports the reason if the plugin cannot be used
+		template <class Host>
+		std::unique_ptr<Host>
+		load(const char* op)
+		{
+			std::unique_ptr<Host>	host(new Host(myOptions.pluginDir + "/" + op + ".so"));
+			if (!host->isLoaded())
+			{
+				std::printf("%-24s skipped: %s\n", op, host->error().c_str());
+				return nullptr;
+			}
+			return host;
+		}
+
+		// 'beforeCook' runs outside of the timed region, use it to change inputs
+		// between frames the way an animated network would
+		Stats
+		run(const char* op, const std::string& label, OperatorHost& host,
+			const std::function<void()>& beforeCook = std::function<void()>())
+		{
+			CookResult	last;
+			for (int i = 0; i < myOptions.warmup; i++)
+			{
+				if (beforeCook)
+					beforeCook();
+				last = host.cook();
+			}
+
+			std::vector<double>	samples;
+			samples.reserve(myOptions.iterations);
+			for (int i = 0; i < myOptions.iterations; i++)
+			{
+				if (beforeCook)
+					beforeCook();
+				last = host.cook();
+				samples.push_back(last.executeMs);
+			}
+
+			const Stats	s = summarize(samples);
+			std::printf("%-24s %-40s %10.3f %10.3f %10.3f %10.3f\n", op, label.c_str(), s.min, s.median, s.p95, s.mean);
+
+			if (!last.error.empty())
+				std::printf("%-24s   error: %s\n", "", last.error.c_str());
+			if (!last.warning.empty())
+				std::printf("%-24s   warning: %s\n", "", last.warning.c_str());
+			if (myOptions.info)
+			{
+				for (const auto& chan : last.infoCHOP)
+					std::printf("%-24s   %s = %g\n", "", chan.first.c_str(), chan.second);
+			}
+			return s;
+		}
+
+	private:
+		Options		myOptions;
+	};
+
+	struct Resolution
+	{
+		int			width;
+		int			height;
+		const char*	name;
+	};
+
+	const Resolution	theResolutions[] =
+	{
+		{ 640, 360, "640x360" },
+		{ 1280, 720, "1280x720" },
+		{ 1920, 1080, "1920x1080" },
+		{ 3840, 2160, "3840x2160" },
+	};
+
+	std::string
+	label(const std::string& a, const std::string& b)
+	{
+		return a + " " + b;
+	}
+
+	// Smooth gradient with some noise so quantization and dithering have work to do
+	void
+	fillGradient(MockTOPInput& top, unsigned seed)
+	{
+		std::mt19937	gen(seed);
+		std::uniform_int_distribution<int>	noise(-8, 8);
+		uint8_t*	px = top.pixels();
+		for (int y = 0; y < top.height(); y++)
+		{
+			for (int x = 0; x < top.width(); x++)
+			{
+				uint8_t*	p = px + (static_cast<size_t>(y) * top.width() + x) * 4;
+				p[0] = static_cast<uint8_t>(std::clamp(255 * x / top.width() + noise(gen), 0, 255));
+				p[1] = static_cast<uint8_t>(std::clamp(255 * y / top.height() + noise(gen), 0, 255));
+				p[2] = static_cast<uint8_t>(std::clamp(128 + noise(gen), 0, 255));
+				p[3] = 255;
+			}
+		}
+	}
+
+	// Binary image of scattered discs, the typical input of a distance transform
+	void
+	fillDiscs(MockTOPInput& top, int count, unsigned seed)
+	{
+		std::mt19937	gen(seed);
+		std::uniform_int_distribution<int>	xs(0, top.width() - 1);
+		std::uniform_int_distribution<int>	ys(0, top.height() - 1);
+		std::uniform_int_distribution<int>	rs(4, std::max(5, top.height() / 20));
+
+		uint8_t*	px = top.pixels();
+		std::fill(px, px + static_cast<size_t>(top.width()) * top.height() * 4, uint8_t(255));
+		for (int i = 0; i < count; i++)
+		{
+			const int	cx = xs(gen), cy = ys(gen), r = rs(gen);
+			for (int y = std::max(0, cy - r); y < std::min(top.height(), cy + r + 1); y++)
+			{
+				for (int x = std::max(0, cx - r); x < std::min(top.width(), cx + r + 1); x++)
+				{
+					if ((x - cx) * (x - cx) + (y - cy) * (y - cy) <= r * r)
+					{
+						uint8_t*	p = px + (static_cast<size_t>(y) * top.width() + x) * 4;
+						p[0] = p[1] = p[2] = 0;
+					}
+				}
+			}
+		}
+	}
+
+	// Blurred random texture translated by (dx, dy) each frame
+	class MovingTexture
+	{
+	public:
+		MovingTexture(MockTOPInput& top, unsigned seed) :
+			myTop{ top }, myFrame{ 0 }
+		{
+			std::mt19937	gen(seed);
+			std::uniform_int_distribution<int>	dist(0, 255);
+			const int	w = top.width(), h = top.height();
+			myTexture.resize(static_cast<size_t>(w) * h);
+			for (uint8_t& v : myTexture)
+				v = static_cast<uint8_t>(dist(gen));
+			for (int pass = 0; pass < 2; pass++)
+			{
+				std::vector<uint8_t>	tmp(myTexture);
+				for (int y = 1; y + 1 < h; y++)
+					for (int x = 1; x + 1 < w; x++)
+					{
+						int sum = 0;
+						for (int j = -1; j <= 1; j++)
+							for (int i = -1; i <= 1; i++)
+								sum += tmp[(y + j) * w + x + i];
+						myTexture[y * w + x] = static_cast<uint8_t>(sum / 9);
+					}
+			}
+		}
+
+		void
+		advance(int dx, int dy)
+		{
+			const int	w = myTop.width(), h = myTop.height();
+			uint8_t*	px = myTop.pixels();
+			for (int y = 0; y < h; y++)
+			{
+				const int	sy = ((y - dy * myFrame) % h + h) % h;
+				for (int x = 0; x < w; x++)
+				{
+					const int	sx = ((x - dx * myFrame) % w + w) % w;
+					uint8_t*	p = px + (static_cast<size_t>(y) * w + x) * 4;
+					p[0] = p[1] = p[2] = myTexture[sy * w + sx];
+					p[3] = 255;
+				}
+			}
+			myTop.touch();
+			myFrame++;
+		}
+
+	private:
+		MockTOPInput&			myTop;
+		std::vector<uint8_t>	myTexture;
+		int						myFrame;
+	};
+
+	std::unique_ptr<MockCHOPInput>
+	randomPointsCHOP(int numPoints, unsigned seed)
+	{
+		std::unique_ptr<MockCHOPInput>	chop(new MockCHOPInput(3, numPoints));
+		std::mt19937	gen(seed);
+		std::uniform_real_distribution<float>	dist(-1.0f, 1.0f);
+		for (int c = 0; c < 3; c++)
+			for (int i = 0; i < numPoints; i++)
+				chop->channel(c)[i] = dist(gen);
+		chop->setChannelName(0, "tx");
+		chop->setChannelName(1, "ty");
+		chop->setChannelName(2, "tz");
+		return chop;
+	}
+
+	std::unique_ptr<MockCHOPInput>
+	noiseCHOP(int numChannels, int numSamples, unsigned seed)
+	{
+		std::unique_ptr<MockCHOPInput>	chop(new MockCHOPInput(numChannels, numSamples));
+		std::mt19937	gen(seed);
+		std::normal_distribution<float>	dist(0.0f, 1.0f);
+		for (int c = 0; c < numChannels; c++)
+			for (int i = 0; i < numSamples; i++)
+				chop->channel(c)[i] = dist(gen);
+		return chop;
+	}
+
+#pragma region TOP
+
+	void
+	benchBasicFilterTOP(Benchmark& bench)
+	{
+		const char*	op = "BasicFilterTOP";
+		if (!bench.wants(op))
+			return;
+
+		for (const Resolution& res : theResolutions)
+		{
+			MockTOPInput	top(res.width, res.height);
+			fillGradient(top, 1);
+
+			struct Case { const char* name; int dither; const char* mode; int serpentine; int multithreaded; int threads; int downscale; const char* filter; int downloadDepth; };
+			const Case	cases[] =
+			{
+				{ "bits=2", 0, "Floydsteinberg", 0, 0, 1, 1, "Box", 0 },
+				{ "bits=2 threads=4", 0, "Floydsteinberg", 0, 0, 4, 1, "Box", 0 },
+				{ "bits=2 dither", 1, "Floydsteinberg", 0, 0, 1, 1, "Box", 0 },
+				{ "bits=2 dither serpentine", 1, "Floydsteinberg", 1, 0, 1, 1, "Box", 0 },
+				{ "bits=2 dither threads=4", 1, "Floydsteinberg", 0, 0, 4, 1, "Box", 0 },
+				{ "bits=2 dither multithreaded", 1, "Floydsteinberg", 0, 1, 1, 1, "Box", 0 },
+				{ "bits=2 bayer8", 1, "Bayer8", 0, 0, 1, 1, "Box", 0 },
+				{ "bits=2 bluenoise", 1, "Bluenoise", 0, 0, 1, 1, "Box", 0 },
+				{ "bits=2 bluenoise threads=4", 1, "Bluenoise", 0, 0, 4, 1, "Box", 0 },
+				{ "bits=2 downscale=2 nearest", 0, "Floydsteinberg", 0, 0, 1, 2, "Nearest", 0 },
+				{ "bits=2 downscale=2 bilinear", 0, "Floydsteinberg", 0, 0, 1, 2, "Bilinear", 0 },
+				{ "bits=2 downscale=2 box", 0, "Floydsteinberg", 0, 0, 1, 2, "Box", 0 },
+				{ "bits=2 download depth=1", 0, "Floydsteinberg", 0, 0, 1, 1, "Box", 1 },
+			};
+			for (const Case& c : cases)
+			{
+				std::unique_ptr<TOPHost>	host = bench.load<TOPHost>(op);
+				if (!host)
+					return;
+				host->inputs().setInput(0, &top);
+				host->inputs().setPar("Bitspercolor", 2);
+				host->inputs().setPar("Dither", c.dither);
+				host->inputs().setPar("Dithermode", c.mode);
+				host->inputs().setPar("Serpentine", c.serpentine);
+				host->inputs().setPar("Multithreaded", c.multithreaded);
+				host->inputs().setPar("Threads", c.threads);
+				host->inputs().setPar("Downscale", c.downscale);
+				host->inputs().setPar("Resizefilter", c.filter);
+				host->inputs().setPar("Downloaddepth", c.downloadDepth);
+				bench.run(op, label(res.name, c.name), *host);
+			}
+		}
+	}
+
+	void
+	benchDistanceTransformTOP(Benchmark& bench)
+	{
+		const char*	op = "DistanceTransformTOP";
+		if (!bench.wants(op))
+			return;
+
+		for (const Resolution& res : theResolutions)
+		{
+			MockTOPInput	top(res.width, res.height);
+			fillDiscs(top, 64, 2);
+
+			struct Case { const char* name; const char* type; const char* mask; };
+			for (const Case& c : { Case{ "L2 precise", "L2", "Precise" }, Case{ "L1 3x3", "L1", "Three" } })
+			{
+				std::unique_ptr<TOPHost>	host = bench.load<TOPHost>(op);
+				if (!host)
+					return;
+				host->inputs().setInput(0, &top);
+				host->inputs().setPar("Distancetype", c.type);
+				host->inputs().setPar("Masksize", c.mask);
+				host->inputs().setPar("Channel", "R");
+				bench.run(op, label(res.name, c.name), *host);
+			}
+		}
+	}
+
+	struct FlowError
+	{
+		double	seams = 0.0;
+		double	elsewhere = 0.0;
+	};
+
+	// Mean length of the difference between two RG32Float flows, within 4 pixels of the
+	// boundaries between tilesX x tilesY tiles and everywhere else
+	FlowError
+	compareFlow(const float* a, const float* b, int width, int height, int tilesX, int tilesY)
+	{
+		FlowError	error;
+		if (!a || !b)
+			return error;
+
+		const int	band = 4;
+		auto	nearBoundary = [&](int i, int size, int tiles)
+		{
+			for (int t = 1; t < tiles; t++)
+			{
+				if (std::abs(i - size * t / tiles) < band)
+					return true;
+			}
+			return false;
+		};
+
+		double	sums[2] = { 0.0, 0.0 };
+		size_t	counts[2] = { 0, 0 };
+		for (int y = 0; y < height; y++)
+		{
+			// The output is flipped vertically from the frame the tiles split
+			const bool	seamRow = nearBoundary(height - 1 - y, height, tilesY);
+			for (int x = 0; x < width; x++)
+			{
+				const size_t	i = 2 * (static_cast<size_t>(y) * width + x);
+				const double	d = std::hypot(a[i] - b[i], a[i + 1] - b[i + 1]);
+				const int		seam = seamRow || nearBoundary(x, width, tilesX) ? 0 : 1;
+				sums[seam] += d;
+				counts[seam]++;
+			}
+		}
+
+		error.seams = counts[0] ? sums[0] / counts[0] : 0.0;
+		error.elsewhere = counts[1] ? sums[1] / counts[1] : 0.0;
+		return error;
+	}
+
+	void
+	benchOpticalFlowCPUTOP(Benchmark& bench)
+	{
+		const char*	op = "OpticalFlowCPUTOP";
+		if (!bench.wants(op))
+			return;
+
+		for (const Resolution& res : theResolutions)
+		{
+			if (res.width > 1920)
+				continue;
+
+			MockTOPInput	top(res.width, res.height);
+			MovingTexture	texture(top, 3);
+
+			struct Case { const char* name; const char* algorithm; const char* preset; const char* scale; bool edgeAware; };
+			for (const Case& c : { Case{ "farneback", "Farneback", "Fast", "Full", false },
+									Case{ "farneback half", "Farneback", "Fast", "Half", false },
+									Case{ "farneback quarter edge aware", "Farneback", "Fast", "Quarter", true },
+									Case{ "dis ultrafast", "Dis", "Ultrafast", "Full", false },
+									Case{ "dis medium", "Dis", "Medium", "Full", false },
+									Case{ "sparse to dense", "Sparsetodense", "Fast", "Full", false } })
+			{
+				std::unique_ptr<TOPHost>	host = bench.load<TOPHost>(op);
+				if (!host)
+					return;
+				host->inputs().setInput(0, &top);
+				host->inputs().setPar("Algorithm", c.algorithm);
+				host->inputs().setPar("Dispreset", c.preset);
+				host->inputs().setPar("Computescale", c.scale);
+				host->inputs().setPar("Edgeaware", c.edgeAware);
+				bench.run(op, label(res.name, c.name), *host, [&] { texture.advance(2, 1); });
+			}
+
+			// Tiled Farneback against the untiled one, for the speed-up and the error the seams add
+			std::unique_ptr<TOPHost>	untiled = bench.load<TOPHost>(op);
+			if (!untiled)
+				return;
+			untiled->inputs().setInput(0, &top);
+			const Stats	reference = bench.run(op, label(res.name, "farneback untiled"), *untiled, [&] { texture.advance(2, 1); });
+
+			struct TiledCase { const char* name; int tilesX; int tilesY; double overlap; };
+			for (const TiledCase& c : { TiledCase{ "farneback tiles 2x2", 2, 2, 0.25 },
+										TiledCase{ "farneback tiles 4x4", 4, 4, 0.25 },
+										TiledCase{ "farneback tiles 4x4 overlap 0", 4, 4, 0.0 },
+										TiledCase{ "farneback tiles 4x4 overlap 1", 4, 4, 1.0 } })
+			{
+				std::unique_ptr<TOPHost>	host = bench.load<TOPHost>(op);
+				if (!host)
+					return;
+				host->inputs().setInput(0, &top);
+				host->inputs().setPar("Tiles", c.tilesX, c.tilesY);
+				host->inputs().setPar("Tileoverlap", c.overlap);
+				const Stats	tiled = bench.run(op, label(res.name, c.name), *host, [&] { texture.advance(2, 1); });
+
+				// Enough cooks on the same frames for both to go through the download queue
+				for (int i = 0; i < 3; i++)
+				{
+					texture.advance(2, 1);
+					untiled->cook();
+					host->cook();
+				}
+
+				const FlowError	error = compareFlow(static_cast<const float*>(untiled->output().lastData()),
+													static_cast<const float*>(host->output().lastData()),
+													res.width, res.height, c.tilesX, c.tilesY);
+				std::printf("%-24s   seam error %.4f px, elsewhere %.4f px, speed-up %.2fx\n", "",
+							error.seams, error.elsewhere, tiled.median > 0.0 ? reference.median / tiled.median : 0.0);
+			}
+		}
+	}
+
+	void
+	benchObjectDetectorTOP(Benchmark& bench)
+	{
+		const char*	op = "ObjectDetectorTOP";
+		if (!bench.wants(op))
+			return;
+
+		if (bench.options().classifier.empty())
+			std::printf("%-24s no --classifier given, timing runs without a loaded cascade\n", op);
+
+		for (const Resolution& res : theResolutions)
+		{
+			if (res.width > 1920)
+				continue;
+
+			MockTOPInput	top(res.width, res.height);
+			MovingTexture	texture(top, 4);
+
+			std::unique_ptr<TOPHost>	host = bench.load<TOPHost>(op);
+			if (!host)
+				return;
+			host->inputs().setInput(0, &top);
+			host->inputs().setPar("Classifier", bench.options().classifier.c_str());
+			bench.run(op, label(res.name, "cascade"), *host, [&] { texture.advance(1, 0); });
+		}
+	}
+
+#pragma endregion
+
+#pragma region SOP
+
+	void
+	benchFilterSOP(Benchmark& bench)
+	{
+		const char*	op = "FilterSOP";
+		if (!bench.wants(op))
+			return;
+
+		for (int n : { 64, 256, 512 })
+		{
+			std::unique_ptr<MockSOPInput>	grid = MockSOPInput::grid(n, n);
+			std::unique_ptr<MockCHOPInput>	translate = noiseCHOP(3, 1, 5);
+			translate->setChannelName(0, "tx");
+			translate->setChannelName(1, "ty");
+			translate->setChannelName(2, "tz");
+
+			std::unique_ptr<SOPHost>	host = bench.load<SOPHost>(op);
+			if (!host)
+				return;
+			host->inputs().setInput(0, grid.get());
+			host->inputs().setParCHOP("Translatechop", translate.get());
+
+			// Static replays the cached result, cooking bumps the input's totalCooks
+			// before every cook so the operator has to redo its work
+			const std::string	name = "grid " + std::to_string(n) + "x" + std::to_string(n);
+			bench.run(op, label(name, "static"), *host);
+			bench.run(op, label(name, "cooking"), *host, [&]() { grid->touch(); });
+		}
+	}
+
+	void
+	benchIntersectPointsSOP(Benchmark& bench)
+	{
+		const char*	op = "IntersectPointsSOP";
+		if (!bench.wants(op))
+			return;
+
+		std::unique_ptr<MockSOPInput>	sphere = MockSOPInput::sphere(16, 32);
+		for (int n : { 32, 64, 128 })
+		{
+			std::unique_ptr<MockSOPInput>	grid = MockSOPInput::grid(n, n);
+
+			std::unique_ptr<SOPHost>	host = bench.load<SOPHost>(op);
+			if (!host)
+				return;
+			host->inputs().setInput(0, grid.get());
+			host->inputs().setInput(1, sphere.get());
+			const std::string	name = "grid " + std::to_string(n) + "x" + std::to_string(n) + " in sphere";
+			bench.run(op, label(name, "static"), *host);
+			bench.run(op, label(name, "cooking"), *host, [&]() { grid->touch(); });
+		}
+	}
+
+	void
+	benchWrapPointsSOP(Benchmark& bench)
+	{
+		const char*	op = "WrapPointsSOP";
+		if (!bench.wants(op))
+			return;
+
+		std::unique_ptr<MockSOPInput>	sphere = MockSOPInput::sphere(16, 32);
+		for (int n : { 32, 64, 128 })
+		{
+			std::unique_ptr<MockSOPInput>	grid = MockSOPInput::grid(n, n);
+
+			std::unique_ptr<SOPHost>	host = bench.load<SOPHost>(op);
+			if (!host)
+				return;
+			host->inputs().setInput(0, grid.get());
+			host->inputs().setInput(1, sphere.get());
+			const std::string	name = "grid " + std::to_string(n) + "x" + std::to_string(n) + " onto sphere";
+			bench.run(op, label(name, "static"), *host);
+			bench.run(op, label(name, "cooking"), *host, [&]() { grid->touch(); });
+		}
+	}
+
+	void
+	benchSprinkleSOP(Benchmark& bench)
+	{
+		const char*	op = "SprinkleSOP";
+		if (!bench.wants(op))
+			return;
+
+		std::unique_ptr<MockSOPInput>	sphere = MockSOPInput::sphere(32, 64);
+		for (const char* mode : { "Area", "Primitive", "Boundingbox", "Volume" })
+		{
+			for (int count : { 1000, 10000, 100000 })
+			{
+				// Volume calls isInside() per candidate, the brute force mock makes it slow
+				if (!std::strcmp(mode, "Volume") && count > 10000)
+					break;
+
+				std::unique_ptr<SOPHost>	host = bench.load<SOPHost>(op);
+				if (!host)
+					return;
+				host->inputs().setInput(0, sphere.get());
+				host->inputs().setPar("Generate", mode);
+				host->inputs().setPar("Pointcount", count);
+				const std::string	name = label(mode, std::to_string(count) + " points");
+				bench.run(op, label(name, "static"), *host);
+
+				// A new input rebuilds the volume tree, seconds per cook with the mock
+				if (std::strcmp(mode, "Volume"))
+					bench.run(op, label(name, "cooking"), *host, [&]() { sphere->touch(); });
+			}
+		}
+	}
+
+	void
+	benchAlphaShapesSOP(Benchmark& bench)
+	{
+		const char*	op = "AlphaShapesSOP";
+		if (!bench.wants(op))
+			return;
+
+		for (int count : { 1000, 10000, 50000 })
+		{
+			std::unique_ptr<MockSOPInput>	cloud = MockSOPInput::pointCloud(count, 6);
+
+			std::unique_ptr<SOPHost>	host = bench.load<SOPHost>(op);
+			if (!host)
+				return;
+			host->inputs().setInput(0, cloud.get());
+			const std::string	name = std::to_string(count) + " points";
+			bench.run(op, label(name, "static"), *host);
+			bench.run(op, label(name, "cooking"), *host, [&]() { cloud->touch(); });
+		}
+	}
+
+	void
+	benchGeneratorSOP(Benchmark& bench)
+	{
+		const char*	op = "GeneratorSOP";
+		if (!bench.wants(op))
+			return;
+
+		// Fixed shapes, the only ones executeVBO() implements
+		for (const char* shape : { "Point", "Line", "Square", "Cube" })
+		{
+			for (int gpu : { 0, 1 })
+			{
+				std::unique_ptr<SOPHost>	host = bench.load<SOPHost>(op);
+				if (!host)
+					return;
+				host->inputs().setPar("Shape", shape);
+				host->inputs().setPar("Gpudirect", gpu);
+				bench.run(op, label(shape, gpu ? "gpu" : "cpu"), *host);
+			}
+		}
+
+		// Shapes built from the points CHOP, the divider emits a box per cell
+		// of the n^3 grid the points span so it stops at 64 points
+		for (const char* shape : { "Divider", "Voronoi", "KDTree" })
+		{
+			for (int count : { 16, 64, 256 })
+			{
+				if (!std::strcmp(shape, "Divider") && count > 64)
+					break;
+
+				std::unique_ptr<MockCHOPInput>	points = randomPointsCHOP(count, 7);
+				std::unique_ptr<SOPHost>		host = bench.load<SOPHost>(op);
+				if (!host)
+					return;
+				host->inputs().setPar("Shape", shape);
+				host->inputs().setParCHOP("Inputpointschop", points.get());
+				bench.run(op, label(shape, std::to_string(count) + " points"), *host);
+			}
+		}
+	}
+
+	void
+	benchSpiralSOP(Benchmark& bench)
+	{
+		const char*	op = "SpiralSOP";
+		if (!bench.wants(op))
+			return;
+
+		for (const char* geometry : { "Line", "Trianglestrip" })
+		{
+			for (int divisions : { 1000, 10000, 100000 })
+			{
+				for (int gpu : { 0, 1 })
+				{
+					std::unique_ptr<SOPHost>	host = bench.load<SOPHost>(op);
+					if (!host)
+						return;
+					host->inputs().setPar("Outputgeometry", geometry);
+					host->inputs().setPar("Divisions", divisions);
+					host->inputs().setPar("Gpudirect", gpu);
+					bench.run(op, label(geometry, std::to_string(divisions) + " divisions" + (gpu ? " gpu" : "")), *host);
+				}
+			}
+		}
+	}
+
+#pragma endregion
+
+#pragma region CHOP
+
+	void
+	benchBasicFilterCHOP(Benchmark& bench)
+	{
+		const char*	op = "BasicFilterCHOP";
+		if (!bench.wants(op))
+			return;
+
+		for (int chans : { 16, 256 })
+		{
+			for (int samples : { 1000, 48000 })
+			{
+				std::unique_ptr<MockCHOPInput>	input = noiseCHOP(chans, samples, 8);
+
+				std::unique_ptr<CHOPHost>	host = bench.load<CHOPHost>(op);
+				if (!host)
+					return;
+				host->inputs().setInput(0, input.get());
+				host->inputs().setPar("Applyscale", 1);
+				host->inputs().setPar("Applyoffset", 1);
+				bench.run(op, std::to_string(chans) + " chans x " + std::to_string(samples), *host);
+			}
+		}
+	}
+
+	void
+	benchBasicGeneratorCHOP(Benchmark& bench)
+	{
+		const char*	op = "BasicGeneratorCHOP";
+		if (!bench.wants(op))
+			return;
+
+		for (int chans : { 16, 256 })
+		{
+			for (int length : { 1000, 48000 })
+			{
+				std::unique_ptr<CHOPHost>	host = bench.load<CHOPHost>(op);
+				if (!host)
+					return;
+				host->inputs().setPar("Numberofchannels", chans);
+				host->inputs().setPar("Length", length);
+				bench.run(op, std::to_string(chans) + " chans x " + std::to_string(length), *host);
+			}
+		}
+	}
+
+	void
+	benchOneEuroCHOP(Benchmark& bench)
+	{
+		const char*	op = "OneEuroCHOP";
+		if (!bench.wants(op))
+			return;
+
+		for (int chans : { 16, 1024 })
+		{
+			std::unique_ptr<MockCHOPInput>	input = noiseCHOP(chans, 1, 9);
+
+			std::unique_ptr<CHOPHost>	host = bench.load<CHOPHost>(op);
+			if (!host)
+				return;
+			host->inputs().setInput(0, input.get());
+			bench.run(op, std::to_string(chans) + " chans timeslice", *host, [&] { input->touch(); });
+		}
+	}
+
+	void
+	benchTimeSliceFilterCHOP(Benchmark& bench)
+	{
+		const char*	op = "TimeSliceFilterCHOP";
+		if (!bench.wants(op))
+			return;
+
+		for (int chans : { 16, 1024 })
+		{
+			std::unique_ptr<MockCHOPInput>	input0 = noiseCHOP(chans, 1, 10);
+			std::unique_ptr<MockCHOPInput>	input1 = noiseCHOP(chans, 1, 11);
+
+			std::unique_ptr<CHOPHost>	host = bench.load<CHOPHost>(op);
+			if (!host)
+				return;
+			host->inputs().setInput(0, input0.get());
+			host->inputs().setInput(1, input1.get());
+			bench.run(op, "2 inputs x " + std::to_string(chans) + " chans", *host);
+		}
+	}
+
+	void
+	benchTimeSliceGeneratorCHOP(Benchmark& bench)
+	{
+		const char*	op = "TimeSliceGeneratorCHOP";
+		if (!bench.wants(op))
+			return;
+
+		std::unique_ptr<CHOPHost>	host = bench.load<CHOPHost>(op);
+		if (!host)
+			return;
+		bench.run(op, "1 chan timeslice", *host);
+	}
+
+#pragma endregion
+
+#pragma region DAT
+
+	void
+	benchFilterDAT(Benchmark& bench)
+	{
+		const char*	op = "FilterDAT";
+		if (!bench.wants(op))
+			return;
+
+		const char*	words[] = { "hello world", "Custom Operator", "  spaced   text ", "TouchDesigner", "x" };
+		for (int rows : { 100, 10000 })
+		{
+			MockDATInput	input(rows, 8);
+			for (int r = 0; r < rows; r++)
+				for (int c = 0; c < 8; c++)
+					input.setCell(r, c, words[(r + c) % 5]);
+
+			std::unique_ptr<DATHost>	host = bench.load<DATHost>(op);
+			if (!host)
+				return;
+			host->inputs().setInput(0, &input);
+			bench.run(op, std::to_string(rows) + " rows x 8 cols", *host);
+		}
+	}
+
+	void
+	benchGeneratorDAT(Benchmark& bench)
+	{
+		const char*	op = "GeneratorDAT";
+		if (!bench.wants(op))
+			return;
+
+		for (int rows : { 100, 10000 })
+		{
+			std::unique_ptr<DATHost>	host = bench.load<DATHost>(op);
+			if (!host)
+				return;
+			host->inputs().setPar("Rows", rows);
+			host->inputs().setPar("Columns", 8);
+			bench.run(op, std::to_string(rows) + " rows x 8 cols", *host);
+		}
+	}
+
+#pragma endregion
+
+	bool
+	parseArgs(int argc, char** argv, Options& opts)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const std::string	arg = argv[i];
+			const bool			hasValue = i + 1 < argc;
+			if (arg == "--filter" && hasValue)
+				opts.filter = argv[++i];
+			else if (arg == "--iterations" && hasValue)
+				opts.iterations = std::max(1, std::atoi(argv[++i]));
+			else if (arg == "--warmup" && hasValue)
+				opts.warmup = std::max(0, std::atoi(argv[++i]));
+			else if (arg == "--plugins" && hasValue)
+				opts.pluginDir = argv[++i];
+			else if (arg == "--classifier" && hasValue)
+				opts.classifier = argv[++i];
+			else if (arg == "--info")
+				opts.info = true;
+			else
+				return false;
+		}
+		return true;
+	}
+}
+
+int
+main(int argc, char** argv)
+{
+	Options	opts;
+	if (!parseArgs(argc, argv, opts))
+	{
+		std::fprintf(stderr, "usage: %s [--filter <text>] [--iterations <n>] [--warmup <n>] "
+							"[--plugins <dir>] [--classifier <cascade.xml>] [--info]\n", argv[0]);
+		return 1;
+	}
+
+	Benchmark	bench(opts);
+	std::printf("%-24s %-40s %10s %10s %10s %10s\n", "operator", "case", "min ms", "median ms", "p95 ms", "mean ms");
+
+	benchBasicFilterTOP(bench);
+	benchDistanceTransformTOP(bench);
+	benchOpticalFlowCPUTOP(bench);
+	benchObjectDetectorTOP(bench);
+
+	benchFilterSOP(bench);
+	benchIntersectPointsSOP(bench);
+	benchWrapPointsSOP(bench);
+	benchSprinkleSOP(bench);
+	benchAlphaShapesSOP(bench);
+	benchGeneratorSOP(bench);
+	benchSpiralSOP(bench);
+
+	benchBasicFilterCHOP(bench);
+	benchBasicGeneratorCHOP(bench);
+	benchOneEuroCHOP(bench);
+	benchTimeSliceFilterCHOP(bench);
+	benchTimeSliceGeneratorCHOP(bench);
+
+	benchFilterDAT(bench);
+	benchGeneratorDAT(bench);
+	return 0;
+}
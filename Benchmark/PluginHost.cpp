@@ -0,0 +1,367 @@
+#include "PluginHost.h"
+
+#include <chrono>
+#include <dlfcn.h>
+
+using namespace TD;
+
+namespace
+{
+	typedef void	(*FillTOPFn)(TOP_PluginInfo*);
+	typedef TOP_CPlusPlusBase*	(*CreateTOPFn)(const OP_NodeInfo*, TOP_Context*);
+	typedef void	(*FillCHOPFn)(CHOP_PluginInfo*);
+	typedef CHOP_CPlusPlusBase*	(*CreateCHOPFn)(const OP_NodeInfo*);
+	typedef void	(*FillSOPFn)(SOP_PluginInfo*);
+	typedef SOP_CPlusPlusBase*	(*CreateSOPFn)(const OP_NodeInfo*);
+	typedef void	(*FillDATFn)(DAT_PluginInfo*);
+	typedef DAT_CPlusPlusBase*	(*CreateDATFn)(const OP_NodeInfo*);
+
+	template <class Fn>
+	double
+	timeMs(Fn fn)
+	{
+		const auto	start = std::chrono::steady_clock::now();
+		fn();
+		const auto	end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+}
+
+PluginLibrary::PluginLibrary(const std::string& path) :
+	myHandle{ nullptr }
+{
+	myHandle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (!myHandle)
+		myError = dlerror();
+}
+
+PluginLibrary::~PluginLibrary()
+{
+	if (myHandle)
+		dlclose(myHandle);
+}
+
+void*
+PluginLibrary::symbol(const char* name)
+{
+	if (!myHandle)
+		return nullptr;
+
+	void*	sym = dlsym(myHandle, name);
+	if (!sym)
+		myError = std::string("Missing entry point ") + name;
+	return sym;
+}
+
+OperatorHost::OperatorHost(const std::string& path) :
+	myLibrary{ path }, myInputs{}, myParameterManager{ &myInputs }, myNodeInfo{},
+	myPath{ path }, myLoaded{ false }, myError{ myLibrary.error() }
+{
+	myNodeInfo.opPath = "/mock/op";
+	myNodeInfo.opId = 100;
+	myNodeInfo.pluginPath = myPath.c_str();
+	myNodeInfo.context = nullptr;
+	myNodeInfo.cookCount = 0;
+}
+
+void
+OperatorHost::fillCustomOPInfo(OP_CustomOPInfo& info)
+{
+	info.opType = &myOpType;
+	info.opLabel = &myOpLabel;
+	info.opIcon = &myOpIcon;
+	info.authorName = &myAuthorName;
+	info.authorEmail = &myAuthorEmail;
+	info.pythonVersion = &myPythonVersion;
+}
+
+void
+OperatorHost::beginCook()
+{
+	myNodeInfo.cookCount++;
+	myInputs.nextFrame();
+}
+
+template <class Base>
+void
+OperatorHost::collectInfo(Base* instance, CookResult& res)
+{
+	const int32_t	numChans = instance->getNumInfoCHOPChans(nullptr);
+	for (int32_t i = 0; i < numChans; i++)
+	{
+		MockString		name;
+		OP_InfoCHOPChan	chan;
+		chan.name = &name;
+		chan.value = 0.0f;
+		instance->getInfoCHOPChan(i, &chan, nullptr);
+		res.infoCHOP.emplace_back(name.str(), chan.value);
+	}
+
+	OP_InfoDATSize	size;
+	size.rows = 0;
+	size.cols = 0;
+	size.byColumn = false;
+	if (instance->getInfoDATSize(&size, nullptr))
+	{
+		const int32_t	entries = size.byColumn ? size.rows : size.cols;
+		const int32_t	count = size.byColumn ? size.cols : size.rows;
+
+		std::vector<MockString>		strings(entries);
+		std::vector<OP_String*>		values(entries);
+		for (int32_t i = 0; i < entries; i++)
+			values[i] = &strings[i];
+
+		res.infoDAT.assign(size.rows, std::vector<std::string>(size.cols));
+		for (int32_t i = 0; i < count; i++)
+		{
+			OP_InfoDATEntries	info;
+			info.values = values.data();
+			instance->getInfoDATEntries(i, entries, &info, nullptr);
+			for (int32_t j = 0; j < entries; j++)
+			{
+				if (size.byColumn)
+					res.infoDAT[j][i] = strings[j].str();
+				else
+					res.infoDAT[i][j] = strings[j].str();
+			}
+		}
+	}
+
+	MockString	warning;
+	instance->getWarningString(&warning, nullptr);
+	res.warning = warning.str();
+
+	MockString	error;
+	instance->getErrorString(&error, nullptr);
+	res.error = error.str();
+}
+
+#pragma region TOP
+
+TOPHost::TOPHost(const std::string& path) :
+	OperatorHost{ path }, myInstance{ nullptr }, myDestroy{ nullptr }
+{
+	FillTOPFn	fill = reinterpret_cast<FillTOPFn>(myLibrary.symbol("FillTOPPluginInfo"));
+	CreateTOPFn	create = reinterpret_cast<CreateTOPFn>(myLibrary.symbol("CreateTOPInstance"));
+	myDestroy = reinterpret_cast<DestroyFn>(myLibrary.symbol("DestroyTOPInstance"));
+	if (!fill || !create || !myDestroy)
+	{
+		myError = myLibrary.error();
+		return;
+	}
+
+	TOP_PluginInfo	info;
+	fillCustomOPInfo(info.customOPInfo);
+	fill(&info);
+	if (info.executeMode != TOP_ExecuteMode::CPUMem)
+	{
+		myError = "Only CPU memory TOPs can run without a GPU";
+		return;
+	}
+
+	myNodeInfo.context = &myContext;
+	myInstance = create(&myNodeInfo, &myContext);
+	myInstance->setupParameters(&myParameterManager, nullptr);
+	myLoaded = true;
+}
+
+TOPHost::~TOPHost()
+{
+	if (myInstance)
+		myDestroy(myInstance, &myContext);
+}
+
+CookResult
+TOPHost::cook()
+{
+	CookResult	res;
+	beginCook();
+
+	TOP_GeneralInfo	ginfo{};
+	myInstance->getGeneralInfo(&ginfo, &myInputs, nullptr);
+
+	myOutput.reset();
+	res.executeMs = timeMs([&] { myInstance->execute(&myOutput, &myInputs, nullptr); });
+
+	collectInfo(myInstance, res);
+	return res;
+}
+
+#pragma endregion
+
+#pragma region CHOP
+
+CHOPHost::CHOPHost(const std::string& path) :
+	OperatorHost{ path }, myInstance{ nullptr }, myDestroy{ nullptr }
+{
+	FillCHOPFn		fill = reinterpret_cast<FillCHOPFn>(myLibrary.symbol("FillCHOPPluginInfo"));
+	CreateCHOPFn	create = reinterpret_cast<CreateCHOPFn>(myLibrary.symbol("CreateCHOPInstance"));
+	myDestroy = reinterpret_cast<DestroyFn>(myLibrary.symbol("DestroyCHOPInstance"));
+	if (!fill || !create || !myDestroy)
+	{
+		myError = myLibrary.error();
+		return;
+	}
+
+	CHOP_PluginInfo	info;
+	fillCustomOPInfo(info.customOPInfo);
+	fill(&info);
+
+	myInstance = create(&myNodeInfo);
+	myInstance->setupParameters(&myParameterManager, nullptr);
+	myLoaded = true;
+}
+
+CHOPHost::~CHOPHost()
+{
+	if (myInstance)
+		myDestroy(myInstance);
+}
+
+CookResult
+CHOPHost::cook()
+{
+	CookResult	res;
+	beginCook();
+
+	CHOP_GeneralInfo	ginfo{};
+	ginfo.inputMatchIndex = 0;
+	myInstance->getGeneralInfo(&ginfo, &myInputs, nullptr);
+
+	// Defaults come from the matched input, same as a CHOP with no
+	// getOutputInfo() override
+	const OP_CHOPInput*	match = myInputs.getInputCHOP(ginfo.inputMatchIndex);
+
+	CHOP_OutputInfo	oinfo{};
+	oinfo.numChannels = match ? match->numChannels : 1;
+	oinfo.numSamples = ginfo.timeslice ? static_cast<int32_t>(myInputs.getTimeInfo()->deltaFrames) :
+										(match ? match->numSamples : 1);
+	oinfo.sampleRate = static_cast<float>(match ? match->sampleRate : myInputs.getTimeInfo()->rate);
+	oinfo.startIndex = match ? static_cast<uint32_t>(match->startIndex) : 0;
+
+	const bool	custom = myInstance->getOutputInfo(&oinfo, &myInputs, nullptr);
+	CHOP_Output*	output = nullptr;
+	if (custom)
+	{
+		std::vector<MockString>&	names = myOutput.names();
+		names.resize(oinfo.numChannels);
+		for (int32_t i = 0; i < oinfo.numChannels; i++)
+			myInstance->getChannelName(i, &names[i], &myInputs, nullptr);
+		output = myOutput.allocate(oinfo.numChannels, oinfo.numSamples, oinfo.sampleRate, oinfo.startIndex);
+	}
+	else
+	{
+		std::vector<MockString>&	names = myOutput.names();
+		names.resize(oinfo.numChannels);
+		for (int32_t i = 0; i < oinfo.numChannels; i++)
+			names[i].setString(match ? match->getChannelName(i) : "chan1");
+		output = myOutput.allocate(oinfo.numChannels, oinfo.numSamples, oinfo.sampleRate, oinfo.startIndex);
+	}
+
+	res.executeMs = timeMs([&] { myInstance->execute(output, &myInputs, nullptr); });
+
+	collectInfo(myInstance, res);
+	return res;
+}
+
+#pragma endregion
+
+#pragma region SOP
+
+SOPHost::SOPHost(const std::string& path) :
+	OperatorHost{ path }, myInstance{ nullptr }, myDestroy{ nullptr }
+{
+	FillSOPFn	fill = reinterpret_cast<FillSOPFn>(myLibrary.symbol("FillSOPPluginInfo"));
+	CreateSOPFn	create = reinterpret_cast<CreateSOPFn>(myLibrary.symbol("CreateSOPInstance"));
+	myDestroy = reinterpret_cast<DestroyFn>(myLibrary.symbol("DestroySOPInstance"));
+	if (!fill || !create || !myDestroy)
+	{
+		myError = myLibrary.error();
+		return;
+	}
+
+	SOP_PluginInfo	info;
+	fillCustomOPInfo(info.customOPInfo);
+	fill(&info);
+
+	myInstance = create(&myNodeInfo);
+	myInstance->setupParameters(&myParameterManager, nullptr);
+	myLoaded = true;
+}
+
+SOPHost::~SOPHost()
+{
+	if (myInstance)
+		myDestroy(myInstance);
+}
+
+CookResult
+SOPHost::cook()
+{
+	CookResult	res;
+	beginCook();
+
+	SOP_GeneralInfo	ginfo{};
+	myInstance->getGeneralInfo(&ginfo, &myInputs, nullptr);
+
+	if (ginfo.directToGPU)
+	{
+		res.executeMs = timeMs([&] { myInstance->executeVBO(&myVBOOutput, &myInputs, nullptr); });
+	}
+	else
+	{
+		myOutput.clear();
+		res.executeMs = timeMs([&] { myInstance->execute(&myOutput, &myInputs, nullptr); });
+	}
+
+	collectInfo(myInstance, res);
+	return res;
+}
+
+#pragma endregion
+
+#pragma region DAT
+
+DATHost::DATHost(const std::string& path) :
+	OperatorHost{ path }, myInstance{ nullptr }, myDestroy{ nullptr }
+{
+	FillDATFn	fill = reinterpret_cast<FillDATFn>(myLibrary.symbol("FillDATPluginInfo"));
+	CreateDATFn	create = reinterpret_cast<CreateDATFn>(myLibrary.symbol("CreateDATInstance"));
+	myDestroy = reinterpret_cast<DestroyFn>(myLibrary.symbol("DestroyDATInstance"));
+	if (!fill || !create || !myDestroy)
+	{
+		myError = myLibrary.error();
+		return;
+	}
+
+	DAT_PluginInfo	info;
+	fillCustomOPInfo(info.customOPInfo);
+	fill(&info);
+
+	myInstance = create(&myNodeInfo);
+	myInstance->setupParameters(&myParameterManager, nullptr);
+	myLoaded = true;
+}
+
+DATHost::~DATHost()
+{
+	if (myInstance)
+		myDestroy(myInstance);
+}
+
+CookResult
+DATHost::cook()
+{
+	CookResult	res;
+	beginCook();
+
+	DAT_GeneralInfo	ginfo{};
+	myInstance->getGeneralInfo(&ginfo, &myInputs, nullptr);
+
+	res.executeMs = timeMs([&] { myInstance->execute(&myOutput, &myInputs, nullptr); });
+
+	collectInfo(myInstance, res);
+	return res;
+}
+
+#pragma endregion
@@ -0,0 +1,179 @@
+#ifndef __PluginHost__
+#define __PluginHost__
+
+#include "MockHost.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+Loads an operator plugin (.so) the way TouchDesigner loads the .dll: resolves
+Fill*PluginInfo/Create*Instance/Destroy*Instance, calls setupParameters() so the
+MockInputs hold the default values and then cooks the instance following the
+call order documented in the *_CPlusPlusBase.h headers.
+*/
+
+class PluginLibrary
+{
+public:
+	explicit PluginLibrary(const std::string& path);
+
+	~PluginLibrary();
+
+	PluginLibrary(const PluginLibrary&) = delete;
+
+	PluginLibrary&	operator=(const PluginLibrary&) = delete;
+
+	bool				isLoaded() const { return myHandle != nullptr; }
+
+	const std::string&	error() const { return myError; }
+
+	void*				symbol(const char* name);
+
+private:
+	void*			myHandle;
+	std::string		myError;
+};
+
+// What the node would show after a cook
+struct CookResult
+{
+	// Wall time of the execute() call alone
+	double		executeMs = 0.0;
+
+	std::vector<std::pair<std::string, float>>	infoCHOP;
+	std::vector<std::vector<std::string>>		infoDAT;
+
+	std::string	warning;
+	std::string	error;
+};
+
+class OperatorHost
+{
+public:
+	virtual ~OperatorHost() = default;
+
+	bool				isLoaded() const { return myLoaded; }
+
+	const std::string&	error() const { return myError; }
+
+	const std::string&	opType() const { return myOpType.str(); }
+
+	MockInputs&			inputs() { return myInputs; }
+
+	// Runs one full cook and advances the timeline by a frame
+	virtual CookResult	cook() = 0;
+
+protected:
+	explicit OperatorHost(const std::string& path);
+
+	void	fillCustomOPInfo(TD::OP_CustomOPInfo& info);
+
+	void	beginCook();
+
+	// Queries everything the node exposes after execute()
+	template <class Base>
+	void	collectInfo(Base* instance, CookResult& res);
+
+	PluginLibrary			myLibrary;
+	MockInputs				myInputs;
+	MockParameterManager	myParameterManager;
+	TD::OP_NodeInfo			myNodeInfo;
+	std::string				myPath;
+	bool					myLoaded;
+	std::string				myError;
+
+private:
+	MockString				myOpType;
+	MockString				myOpLabel;
+	MockString				myOpIcon;
+	MockString				myAuthorName;
+	MockString				myAuthorEmail;
+	MockString				myPythonVersion;
+};
+
+class TOPHost : public OperatorHost
+{
+public:
+	explicit TOPHost(const std::string& path);
+
+	virtual ~TOPHost();
+
+	virtual CookResult	cook() override;
+
+	MockTOPOutput&		output() { return myOutput; }
+
+	MockTOPContext&		context() { return myContext; }
+
+private:
+	typedef void	(*DestroyFn)(TD::TOP_CPlusPlusBase*, TD::TOP_Context*);
+
+	MockTOPContext				myContext;
+	MockTOPOutput				myOutput;
+	TD::TOP_CPlusPlusBase*		myInstance;
+	DestroyFn					myDestroy;
+};
+
+class CHOPHost : public OperatorHost
+{
+public:
+	explicit CHOPHost(const std::string& path);
+
+	virtual ~CHOPHost();
+
+	virtual CookResult	cook() override;
+
+	MockCHOPOutput&		output() { return myOutput; }
+
+private:
+	typedef void	(*DestroyFn)(TD::CHOP_CPlusPlusBase*);
+
+	MockCHOPOutput				myOutput;
+	TD::CHOP_CPlusPlusBase*		myInstance;
+	DestroyFn					myDestroy;
+};
+
+class SOPHost : public OperatorHost
+{
+public:
+	explicit SOPHost(const std::string& path);
+
+	virtual ~SOPHost();
+
+	// Cooks through executeVBO() when the operator asks for directToGPU
+	virtual CookResult	cook() override;
+
+	MockSOPOutput&		output() { return myOutput; }
+
+	MockSOPVBOOutput&	vboOutput() { return myVBOOutput; }
+
+private:
+	typedef void	(*DestroyFn)(TD::SOP_CPlusPlusBase*);
+
+	MockSOPOutput				myOutput;
+	MockSOPVBOOutput			myVBOOutput;
+	TD::SOP_CPlusPlusBase*		myInstance;
+	DestroyFn					myDestroy;
+};
+
+class DATHost : public OperatorHost
+{
+public:
+	explicit DATHost(const std::string& path);
+
+	virtual ~DATHost();
+
+	virtual CookResult	cook() override;
+
+	MockDATOutput&		output() { return myOutput; }
+
+private:
+	typedef void	(*DestroyFn)(TD::DAT_CPlusPlusBase*);
+
+	MockDATOutput				myOutput;
+	TD::DAT_CPlusPlusBase*		myInstance;
+	DestroyFn					myDestroy;
+};
+
+#endif
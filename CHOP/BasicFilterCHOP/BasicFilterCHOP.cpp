@@ -111,6 +111,8 @@ BasicFilterCHOP::execute(CHOP_Output* output,
 							  const OP_Inputs* inputs,
 							  void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	// Get all Parameters
 	bool	applyScale = inputs->getParInt("Applyscale") ? true : false;
 	double	scale = inputs->getParDouble("Scale");
@@ -197,3 +199,15 @@ BasicFilterCHOP::setupParameters(OP_ParameterManager* manager, void*)
 		assert(res == OP_ParAppendResult::Success);
 	}
 }
+
+int32_t
+BasicFilterCHOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+BasicFilterCHOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
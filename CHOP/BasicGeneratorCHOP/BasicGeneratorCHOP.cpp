@@ -124,6 +124,8 @@ BasicGeneratorCHOP::execute(CHOP_Output* output,
 							  const OP_Inputs* inputs,
 							  void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	// Get all Parameters
 	bool	applyScale = inputs->getParInt("Applyscale") ? true : false;
 	double	scale = inputs->getParDouble("Scale");
@@ -257,3 +259,15 @@ BasicGeneratorCHOP::setupParameters(OP_ParameterManager* manager, void*)
 		assert(res == OP_ParAppendResult::Success);
 	}
 }
+
+int32_t
+BasicGeneratorCHOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+BasicGeneratorCHOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
@@ -16,6 +16,7 @@
 #define __BasicGeneratorCHOP__
 
 #include "CHOP_CPlusPlusBase.h"
+#include "CookStats.h"
 
 using namespace TD;
 
@@ -30,10 +31,9 @@ This example implements a CHOP which takes the following parameters:
 The output values are: scale*(channel operation sample)
 
 This CHOP is a generator so it does not need an input and it is not time sliced.
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo.
+*/
 
 // To get more help about these functions, look at CHOP_CPlusPlusBase.h
 class BasicGeneratorCHOP : public CHOP_CPlusPlusBase
@@ -50,7 +50,12 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager* manager, void*) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 private:
+	CookStats			myCookStats;
 };
 
 #endif
@@ -117,6 +117,8 @@ OneEuroCHOP::execute(CHOP_Output* output,
 							  const OP_Inputs* inputs,
 							  void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	const OP_CHOPInput* chop = inputs->getInputCHOP(0);
 	if (!chop)
 		return;
@@ -189,6 +191,18 @@ OneEuroCHOP::setupParameters(OP_ParameterManager* manager, void*)
 	}
 }
 
+int32_t
+OneEuroCHOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+OneEuroCHOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
+
 void
 OneEuroCHOP::handleParameters(const OP_Inputs* input, const OP_CHOPInput* chop)
 {
@@ -15,6 +15,7 @@
 #define __OneEuroCHOP__
 
 #include "CHOP_CPlusPlusBase.h"
+#include "CookStats.h"
 #include <vector>
 
 class OneEuroImpl;
@@ -36,10 +37,9 @@ References:
 
 For more information about tuning the parameters check the paper mentioned.
 This CHOP is a filter and it takes exactly one input.
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo.
+*/
 
 // To get more help about these functions, look at CHOP_CPlusPlusBase.h
 class OneEuroCHOP : public CHOP_CPlusPlusBase
@@ -56,11 +56,17 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager* manager, void*) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 
 private:
 	void				handleParameters(const TD::OP_Inputs*, const OP_CHOPInput*);
 
 	std::vector<OneEuroImpl*>	myFiltersPerChannel;
+
+	CookStats			myCookStats;
 };
 
 #endif
@@ -205,6 +205,8 @@ TimeSliceFilterCHOP::execute(CHOP_Output* output,
 							  const TD::OP_Inputs* inputs,
 							  void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	OperationMenuItems operation = static_cast<OperationMenuItems>(inputs->getParInt("Operation"));
 
 	int numInputs = inputs->getNumInputs();
@@ -273,6 +275,18 @@ TimeSliceFilterCHOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 	}
 }
 
+int32_t
+TimeSliceFilterCHOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+TimeSliceFilterCHOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
+
 void
 TimeSliceFilterCHOP::pulsePressed(const char* name, void*)
 {
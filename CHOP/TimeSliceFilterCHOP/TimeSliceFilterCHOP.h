@@ -16,6 +16,7 @@
 #define __TimeSliceFilterCHOP__
 
 #include "CHOP_CPlusPlusBase.h"
+#include "CookStats.h"
 #include <vector>
 
 class FilterValues;
@@ -31,10 +32,9 @@ This example implements a CHOP which takes the following parameters:
 This CHOP is a filter and it takes at least one input.
 
 The output signal is: the current maximum, minimum, or average value of the input signal
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo.
+*/
 
 // To get more help about these functions, look at CHOP_CPlusPlusBase.h
 class TimeSliceFilterCHOP : public CHOP_CPlusPlusBase
@@ -50,10 +50,16 @@ public:
 	virtual void		execute(CHOP_Output*, const TD::OP_Inputs*, void*) override;
 
 	virtual void		setupParameters(TD::OP_ParameterManager* manager, void*) override;
+
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
 	virtual void		pulsePressed(const char* name, void* reserved1) override;
 
 private:
 	std::vector<FilterValues>	myValues;
+
+	CookStats			myCookStats;
 };
 
 #endif
@@ -123,6 +123,8 @@ TimeSliceGeneratorCHOP::execute(CHOP_Output* output,
 							  const OP_Inputs* inputs,
 							  void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	// Get all Parameters
 	bool	applyScale = inputs->getParInt("Applyscale") ? true : false;
 	double	scale = inputs->getParDouble("Scale");
@@ -241,3 +243,15 @@ TimeSliceGeneratorCHOP::setupParameters(OP_ParameterManager* manager, void*)
 		assert(res == OP_ParAppendResult::Success);
 	}
 }
+
+int32_t
+TimeSliceGeneratorCHOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+TimeSliceGeneratorCHOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
@@ -16,6 +16,7 @@
 #define __TimeSliceGeneratorCHOP__
 
 #include "CHOP_CPlusPlusBase.h"
+#include "CookStats.h"
 
 using namespace TD;
 
@@ -31,10 +32,9 @@ This CHOP is a generator so it does not need an input.
 The output signal is: scale*(shape value at current time). Note that this CHOP is 
 time sliced; therefore, we need to keep track of the current time to output the correct
 value.
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo.
+*/
 
 // To get more help about these functions, look at CHOP_CPlusPlusBase.h
 class TimeSliceGeneratorCHOP : public CHOP_CPlusPlusBase
@@ -51,8 +51,14 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager* manager, void*) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 private:
 	double myOffset;
+
+	CookStats			myCookStats;
 };
 
 #endif
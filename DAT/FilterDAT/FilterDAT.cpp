@@ -154,6 +154,8 @@ FilterDAT::getGeneralInfo(DAT_GeneralInfo* ginfo, const OP_Inputs*, void*)
 void
 FilterDAT::execute(DAT_Output* output, const OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	const OP_DATInput* dat	= inputs->getInputDAT(0);
 	if (!dat)
 		return;
@@ -203,6 +205,18 @@ FilterDAT::setupParameters(OP_ParameterManager* manager, void*)
 	}
 }
 
+int32_t
+FilterDAT::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+FilterDAT::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
+
 void
 FilterDAT::fillTable(const OP_Inputs* inputs, DAT_Output* out, const OP_DATInput* in)
 {
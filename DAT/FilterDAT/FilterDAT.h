@@ -16,6 +16,7 @@
 #define __FilterDAT__
 
 #include "DAT_CPlusPlusBase.h"
+#include "CookStats.h"
 
 using namespace TD;
 /*
@@ -25,10 +26,9 @@ It takes the following parameters:
 	- Case:	One of [Upper Camel Case, Lower Case, Upper Case]. Which determines how the 
 		content's case changes.
 	- Keep Spaces:	If On, the output will have white space.
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo.
+*/
 
 // To get more help about these functions, look at SOP_CPlusPlusBase.h
 
@@ -44,9 +44,15 @@ public:
 
 	virtual void		setupParameters(OP_ParameterManager*, void* reserved) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 
 private:
 	void				fillTable(const OP_Inputs*, DAT_Output*, const OP_DATInput*);
+
+	CookStats			myCookStats;
 };
 
 #endif
@@ -95,6 +95,8 @@ GeneratorDAT::getGeneralInfo(DAT_GeneralInfo* ginfo, const OP_Inputs*, void*)
 void
 GeneratorDAT::execute(DAT_Output* output, const OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	double mySeed = inputs->getParDouble("Seed");
 	unsigned int* tmp = reinterpret_cast<unsigned int*>(&mySeed);
 	myRNG.seed(*tmp);
@@ -178,6 +180,18 @@ GeneratorDAT::setupParameters(OP_ParameterManager* manager, void*)
 
 }
 
+int32_t
+GeneratorDAT::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+GeneratorDAT::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
+
 void
 GeneratorDAT::fillTable(const OP_Inputs* inputs, DAT_Output* out)
 {
@@ -16,6 +16,7 @@
 #define __GeneratorDAT__
 
 #include "DAT_CPlusPlusBase.h"
+#include "CookStats.h"
 
 #include <random>
 
@@ -30,10 +31,9 @@ It takes the following parameters:
 	- Rows:	The number of rows to output.
 	- Columns:	The number of columns to output.
 	- Length: The length of the text in each cell of the table.
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo.
+*/
 
 // To get more help about these functions, look at SOP_CPlusPlusBase.h
 
@@ -49,6 +49,10 @@ public:
 
 	virtual void		setupParameters(OP_ParameterManager*, void*) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 private:
 
 	void			fillTable(const OP_Inputs*, DAT_Output*);
@@ -56,6 +60,8 @@ private:
 	std::string		generateString(const OP_Inputs*);
 
 	std::mt19937	myRNG;
+
+	CookStats			myCookStats;
 };
 
 #endif
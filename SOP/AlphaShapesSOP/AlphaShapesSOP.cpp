@@ -100,7 +100,8 @@ DestroySOPInstance(SOP_CPlusPlusBase* instance)
 };
 
 
-AlphaShapesSOP::AlphaShapesSOP(const OP_NodeInfo*)
+AlphaShapesSOP::AlphaShapesSOP(const OP_NodeInfo*) :
+	myCookStats{ "triangulate", "classify", "emit" }
 {
 };
 
@@ -123,6 +124,8 @@ AlphaShapesSOP::getGeneralInfo(SOP_GeneralInfo* ginfo, const TD::OP_Inputs* inpu
 void
 AlphaShapesSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	const OP_SOPInput*	sop = inputs->getInputSOP(0);
 	if (!sop) return;
 
@@ -131,12 +134,27 @@ AlphaShapesSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 	bool skipInteriorPoints = myParms.evalSkipInteriorPoints(inputs);
 	double alpha = myParms.evalAlpha(inputs);
 
+	GeometryCache::Key key;
+	key.add(sop->totalCooks);
+	key.add(mode);
+	key.add(useOptimalAlpha);
+	key.add(skipInteriorPoints);
+	key.add(alpha);
+	if (myCache.replay(key, output))
+	{
+		myWarningString = myCache.getWarning();
+		return;
+	}
+
+	output = myCache.record(key, output);
 
+	myCookStats.beginPhase(CookPhase::Triangulate);
 	std::list<Point> lp;
 	const Position* inPos = sop->getPointPositions();
 	for (int i = 0; i < sop->getNumPoints(); ++i) {
 		lp.emplace_back(inPos[i].x, inPos[i].y, inPos[i].z);
 	}
+	myCookStats.addAllocated(lp.size() * (sizeof(Point) + 2 * sizeof(void*)));
 
 	// Alpha shape computed in REGULARIZED mode by default
 	Alpha_shape_3 as(lp.begin(), lp.end());
@@ -158,8 +176,11 @@ AlphaShapesSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 	} else {
 		as.set_alpha(alpha);
 	}
+	myCookStats.endPhase();
 	
+	myCookStats.beginPhase(CookPhase::Classify);
 	std::unordered_map<Alpha_shape_3::Vertex_handle, size_t> vertex_map;
+	std::vector<TD::Position> points;
 	size_t idx = 0;
 	for (auto vit = as.vertices_begin(); vit != as.vertices_end(); ++vit) {
 		
@@ -168,11 +189,11 @@ AlphaShapesSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 			continue;
 		
 		Point pt = vit->point();
-		output->addPoint(TD::Position(
+		points.emplace_back(
 			pt.x(),
 			pt.y(),
 			pt.z()
-		));
+		);
 		
 		// remember point indexes
 		vertex_map[vit] = idx++;
@@ -180,21 +201,27 @@ AlphaShapesSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 
 
 	// Iterate through all facets (triangles)
-	std::vector<std::array<Point, 3>> facets;
+	std::vector<int32_t> triangles;
 	for (Alpha_shape_3::Facet_iterator fit = as.facets_begin();
 		fit != as.facets_end(); ++fit) {
 		if (as.classify(*fit) == Alpha_shape_3::REGULAR) {
 			Alpha_shape_3::Cell_handle cell = fit->first;
 			int i = fit->second;
 
-			output->addTriangle(
-				vertex_map[cell->vertex((i + 1) & 3)],
-				vertex_map[cell->vertex((i + 2) & 3)],
-				vertex_map[cell->vertex((i + 3) & 3)]
-			);
-
+			triangles.push_back(static_cast<int32_t>(vertex_map[cell->vertex((i + 1) & 3)]));
+			triangles.push_back(static_cast<int32_t>(vertex_map[cell->vertex((i + 2) & 3)]));
+			triangles.push_back(static_cast<int32_t>(vertex_map[cell->vertex((i + 3) & 3)]));
 		}
 	}
+	myCookStats.addAllocated(points.capacity() * sizeof(TD::Position) + triangles.capacity() * sizeof(int32_t));
+	myCookStats.endPhase();
+
+	// Emit everything with one call per array instead of one per point and triangle
+	CookStats::Phase	emit(myCookStats, CookPhase::Emit);
+	output->addPoints(points.data(), static_cast<int32_t>(points.size()));
+	output->addTriangles(triangles.data(), static_cast<int32_t>(triangles.size() / 3));
+
+	myCache.commit(myWarningString);
 }
 
 void
@@ -209,6 +236,18 @@ AlphaShapesSOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 	myParms.setup(manager);
 }
 
+int32_t
+AlphaShapesSOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+AlphaShapesSOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
+
 void
 AlphaShapesSOP::getErrorString(TD::OP_String* error, void*)
 {
@@ -16,16 +16,21 @@
 #define __AlphaShapesSOP__
 
 #include "SOP_CPlusPlusBase.h"
+#include "CookStats.h"
+#include "GeometryCache.h"
 #include "Parameters.h"
 #include <string>
 
 
 /*
 This SOP takes one input SOP points, ignoring triangulated geometry
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo, with the
+triangulate, classify and emit phases.
+
+When the input has not cooked and the parameters are the same as in the last cook, the
+last output is emitted again from a GeometryCache instead of computing the alpha shape.
+*/
 
 // To get more help about these functions, look at SOP_CPlusPlusBase.h
 class AlphaShapesSOP : public TD::SOP_CPlusPlusBase
@@ -42,16 +47,31 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager* manager, void*) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 	virtual void		getErrorString(TD::OP_String*, void*) override;
 
 	virtual void		getWarningString(TD::OP_String*, void*) override;
 
 
 private:
+	enum class CookPhase
+	{
+		Triangulate,
+		Classify,
+		Emit
+	};
+
 	std::string			myWarningString;
 	std::string			myErrorString;
 
 	Parameters myParms;
+
+	CookStats			myCookStats;
+
+	GeometryCache		myCache;
 };
 
 #endif // !__AlphaShapesSOP__
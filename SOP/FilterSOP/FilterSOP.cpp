@@ -73,7 +73,8 @@ DestroySOPInstance(SOP_CPlusPlusBase* instance)
 };
 
 
-FilterSOP::FilterSOP(const OP_NodeInfo*)
+FilterSOP::FilterSOP(const OP_NodeInfo*) :
+	myCookStats{ "points", "attributes", "primitives" }
 {
 };
 
@@ -95,6 +96,8 @@ FilterSOP::getGeneralInfo(SOP_GeneralInfo* ginfo, const TD::OP_Inputs* inputs, v
 void
 FilterSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	const OP_SOPInput*	sop = inputs->getInputSOP(0);
 	if (!sop)
 		return;
@@ -106,9 +109,34 @@ FilterSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 	else
 		t = getTranslate(chop);
 
+	// The channel count is part of the key since it decides the warning
+	GeometryCache::Key key;
+	key.add(sop->totalCooks);
+	key.add(chop ? chop->numChannels : -1);
+	key.add(t);
+	if (myCache.replay(key, output))
+	{
+		myWarningString = myCache.getWarning();
+		return;
+	}
+
+	output = myCache.record(key, output);
+
+	myCookStats.beginPhase(CookPhase::Points);
 	copyPointsTranslated(output, sop, t);
+	myCookStats.endPhase();
+
+	myCookStats.beginPhase(CookPhase::Attributes);
 	copyAttributes(output, sop);
-	copyPrimitives(output, sop);
+	myCookStats.endPhase();
+
+	myCookStats.beginPhase(CookPhase::Primitives);
+	if (!myPassThrough.copyPrimitives(output, sop))
+		myWarningString = "Input geometry is not a triangulated polygon.";
+	myCookStats.addAllocated(myPassThrough.getAllocated());
+	myCookStats.endPhase();
+
+	myCache.commit(myWarningString);
 }
 
 void
@@ -123,6 +151,18 @@ FilterSOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 	myParms.setup(manager);
 }
 
+int32_t
+FilterSOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+FilterSOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
+
 void 
 FilterSOP::getWarningString(OP_String* warning, void*)
 {
@@ -196,58 +236,6 @@ FilterSOP::copyCustomAttributes(SOP_Output* out, const OP_SOPInput* in) const
 	}
 }
 
-void 
-FilterSOP::copyPrimitives(SOP_Output* out, const OP_SOPInput* in)
-{
-	const SOP_PrimitiveInfo* prims = in->myPrimsInfo;
-	bool isTriangulated = true;
-
-	for (int i = 0; i < in->getNumPrimitives(); ++i)
-	{
-		int				nVertices = prims[i].numVertices;
-		const int32_t*	indices = prims[i].pointIndices;
-
-		if (prims[i].type != PrimitiveType::Polygon || nVertices > 3)
-		{
-			isTriangulated = false;
-		}
-
-		switch (nVertices)
-		{
-			
-			case 1:
-			{
-				out->addParticleSystem(1, indices[0]);
-				break;
-			}
-			case 2:
-			{
-				out->addLine(indices, 2);
-				break;
-			}
-			case 3:
-			{
-				out->addTriangles(indices, 1);
-			}
-			default:
-			{
-				int32_t* tmp = new int32_t[nVertices + 1];
-				memcpy(tmp, indices, nVertices * sizeof(int32_t));
-				tmp[nVertices] = indices[0];
-
-				out->addLine(tmp, nVertices + 1);
-
-				delete[] tmp;
-			}
-		}
-	}
-
-	if (!isTriangulated)
-	{
-		myWarningString = "Input geometry is not a triangulated polygon.";
-	}
-}
-
 Vector 
 FilterSOP::getTranslate(const OP_CHOPInput* chop)
 {
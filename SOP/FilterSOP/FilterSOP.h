@@ -16,6 +16,9 @@
 #define __FilterSOP__
 
 #include "SOP_CPlusPlusBase.h"
+#include "CookStats.h"
+#include "GeometryCache.h"
+#include "GeometryPassThrough.h"
 #include "Parameters.h"
 #include <string>
 
@@ -25,10 +28,13 @@ This example implements a SOP which takes the following parameters:
 	- Translate CHOP: A CHOP with 3 channels whose value determines a translation for the input SOP.
 
 This SOP is a filter and it takes one input SOP with triangulated geometry.
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo, with the
+points, attributes and primitives phases.
+
+When the input SOP has not cooked and the translation is the same as in the last cook,
+the last output is emitted again from a GeometryCache.
+*/
 
 // To get more help about these functions, look at SOP_CPlusPlusBase.h
 class FilterSOP : public TD::SOP_CPlusPlusBase
@@ -45,10 +51,21 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager* manager, void*) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 	virtual void		getWarningString(TD::OP_String*, void*) override;
 
 
 private:
+	enum class CookPhase
+	{
+		Points,
+		Attributes,
+		Primitives
+	};
+
 	void		copyPointsTranslated(TD::SOP_Output*, const TD::OP_SOPInput*, const TD::Vector&) const;
 
 	// Before calling this functions SOP_Output should contain as many points as OP_SOPInput
@@ -61,14 +78,18 @@ private:
 	void		copyTextures(TD::SOP_Output*, const TD::OP_SOPInput*) const;
 
 	void		copyCustomAttributes(TD::SOP_Output*, const TD::OP_SOPInput*) const;
-	// This method returns true if the input geometry only has triangles and lines
-	void		copyPrimitives(TD::SOP_Output*, const TD::OP_SOPInput*);
 
 	TD::Vector		getTranslate(const TD::OP_CHOPInput*);
 
 	std::string			myWarningString;
 	
 	Parameters myParms;
+
+	CookStats			myCookStats;
+
+	GeometryCache		myCache;
+
+	GeometryPassThrough	myPassThrough;
 };
 
 #endif // !__FilterSOP__
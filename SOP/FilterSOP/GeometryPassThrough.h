@@ -0,0 +1,61 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#ifndef __GeometryPassThrough__
+#define __GeometryPassThrough__
+
+#include "SOP_CPlusPlusBase.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+Copies the primitives of an input SOP to a SOP_Output for the filter SOPs that pass
+their input geometry through. The same files are copied in every SOP folder that uses it.
+
+The primitives are scanned once and grouped by kind, then emitted with one addTriangles
+call for all the triangles, one addLines call for all the polylines and one
+addParticleSystem call per run of consecutive particle points. The output has the
+triangles first, then the lines, then the particles.
+
+Primitives with 3 vertices become triangles, with 2 vertices open lines, with 1 vertex
+particles. Larger primitives become polylines, closed if the input primitive is closed.
+
+The index arrays are kept between cooks, an operator should own one GeometryPassThrough
+for its whole life.
+*/
+class GeometryPassThrough
+{
+public:
+	GeometryPassThrough();
+
+	// Returns false if the input has primitives that are not triangles, lines or particles
+	bool		copyPrimitives(TD::SOP_Output* out, const TD::OP_SOPInput* in);
+
+	// Bytes the last copyPrimitives() had to allocate to grow its index arrays
+	size_t		getAllocated() const;
+
+private:
+	// Bytes held by the index arrays
+	size_t		getCapacity() const;
+
+	std::vector<int32_t>	myTriangles;
+	std::vector<int32_t>	myLineIndices;
+	std::vector<int32_t>	myLineSizes;
+	std::vector<int32_t>	myParticles;
+	size_t					myAllocated;
+};
+
+#endif
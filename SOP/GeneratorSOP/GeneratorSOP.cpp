@@ -96,6 +96,8 @@ GeneratorSOP::getGeneralInfo(SOP_GeneralInfo* ginfo, const TD::OP_Inputs* inputs
 void
 GeneratorSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	ShapeMenuItems shape = myParms.evalShape(inputs);
 	Color color = myParms.evalColor(inputs);
 	float scale = myParms.evalScale(inputs);
@@ -197,6 +199,8 @@ GeneratorSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 void
 GeneratorSOP::executeVBO(SOP_VBOOutput* output, const TD::OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	ShapeMenuItems shape = myParms.evalShape(inputs);
 	Color color = myParms.evalColor(inputs);
 
@@ -261,4 +265,16 @@ void
 GeneratorSOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 {
 	myParms.setup(manager);
-}
\ No newline at end of file
+}
+
+int32_t
+GeneratorSOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+GeneratorSOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
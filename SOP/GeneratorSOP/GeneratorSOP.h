@@ -16,6 +16,7 @@
 #define __GeneratorSOP__
 
 #include "SOP_CPlusPlusBase.h"
+#include "CookStats.h"
 #include "ShapeGenerator.h"
 #include "Parameters.h"
 
@@ -28,10 +29,9 @@ This example implements a SOP which takes the following parameters:
 	- GPU Direct: Whether the shape is loaded to the GPU.
 
 This SOP is a generator and it takes no input.
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo.
+*/
 
 // To get more help about these functions, look at SOP_CPlusPlusBase.h
 class GeneratorSOP : public TD::SOP_CPlusPlusBase
@@ -48,6 +48,10 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager*, void*) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 	virtual void		getErrorString(TD::OP_String*, void*) override;
 
 	virtual void		getWarningString(TD::OP_String*, void*) override;
@@ -62,6 +66,8 @@ private:
 
 
 	Parameters myParms;
+
+	CookStats			myCookStats;
 };
 
 #endif // !__GeneratorSOP__
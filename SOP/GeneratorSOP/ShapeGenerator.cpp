@@ -844,7 +844,7 @@ ShapeGenerator::outputSquareVBO(SOP_VBOOutput* output)
 		outN[i] = Vector(theSquareNormals.at(i)) * -1.0f;
 	}
 	memcpy(output->getTexCoords(), theSquareTexture.data(), theSquareNumPts * sizeof(TexCoord));
-	memcpy(output->addTriangles(theSquareNumPrim), theSquareVertices.data(), theSquareNumPts * 3 * sizeof(int32_t));
+	memcpy(output->addTriangles(theSquareNumPrim), theSquareVertices.data(), theSquareNumPrim * 3 * sizeof(int32_t));
 }
 
 void 
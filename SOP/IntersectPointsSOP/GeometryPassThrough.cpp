@@ -0,0 +1,117 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "GeometryPassThrough.h"
+
+using namespace TD;
+
+GeometryPassThrough::GeometryPassThrough() :
+	myAllocated{ 0 }
+{
+}
+
+bool
+GeometryPassThrough::copyPrimitives(SOP_Output* out, const OP_SOPInput* in)
+{
+	const SOP_PrimitiveInfo*	prims = in->myPrimsInfo;
+	const int32_t				numPrims = in->getNumPrimitives();
+	bool						isTriangulated = true;
+
+	const size_t				previousCapacity = getCapacity();
+
+	myTriangles.clear();
+	myLineIndices.clear();
+	myLineSizes.clear();
+	myParticles.clear();
+
+	// Most inputs are all triangles, size for that case so a triangle mesh
+	// never reallocates
+	myTriangles.reserve(3 * static_cast<size_t>(numPrims));
+
+	for (int i = 0; i < numPrims; ++i)
+	{
+		const SOP_PrimitiveInfo&	prim = prims[i];
+		const int32_t				nVertices = prim.numVertices;
+		const int32_t*				indices = prim.pointIndices;
+
+		if (prim.type != PrimitiveType::Polygon || nVertices > 3)
+			isTriangulated = false;
+
+		switch (nVertices)
+		{
+			case 0:
+			{
+				break;
+			}
+			case 1:
+			{
+				myParticles.push_back(indices[0]);
+				break;
+			}
+			case 2:
+			{
+				myLineIndices.insert(myLineIndices.end(), indices, indices + 2);
+				myLineSizes.push_back(2);
+				break;
+			}
+			case 3:
+			{
+				myTriangles.insert(myTriangles.end(), indices, indices + 3);
+				break;
+			}
+			default:
+			{
+				myLineIndices.insert(myLineIndices.end(), indices, indices + nVertices);
+				if (prim.isClosed)
+					myLineIndices.push_back(indices[0]);
+				myLineSizes.push_back(prim.isClosed ? nVertices + 1 : nVertices);
+				break;
+			}
+		}
+	}
+
+	if (!myTriangles.empty())
+		out->addTriangles(myTriangles.data(), static_cast<int32_t>(myTriangles.size() / 3));
+
+	if (!myLineSizes.empty())
+		out->addLines(myLineIndices.data(), myLineSizes.data(), static_cast<int32_t>(myLineSizes.size()));
+
+	// A particle system takes a range of points, merge particles on consecutive points
+	for (size_t i = 0; i < myParticles.size();)
+	{
+		size_t j = i + 1;
+		while (j < myParticles.size() && myParticles[j] == myParticles[j - 1] + 1)
+			++j;
+
+		out->addParticleSystem(static_cast<int32_t>(j - i), myParticles[i]);
+		i = j;
+	}
+
+	myAllocated = getCapacity() - previousCapacity;
+
+	return isTriangulated;
+}
+
+size_t
+GeometryPassThrough::getAllocated() const
+{
+	return myAllocated;
+}
+
+size_t
+GeometryPassThrough::getCapacity() const
+{
+	return (myTriangles.capacity() + myLineIndices.capacity() + myLineSizes.capacity() +
+		myParticles.capacity()) * sizeof(int32_t);
+}
@@ -74,7 +74,8 @@ DestroySOPInstance(SOP_CPlusPlusBase* instance)
 
 };
 
-IntersectPointsSOP::IntersectPointsSOP(const OP_NodeInfo*)
+IntersectPointsSOP::IntersectPointsSOP(const OP_NodeInfo*) :
+	myCookStats{ "copy", "inside" }
 {
 };
 
@@ -95,22 +96,43 @@ IntersectPointsSOP::getGeneralInfo(SOP_GeneralInfo* ginfo, const TD::OP_Inputs*
 void
 IntersectPointsSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	const OP_SOPInput* sop0 = inputs->getInputSOP(0);
 	const OP_SOPInput* sop1 = inputs->getInputSOP(1);
 	if (!sop0 || !sop1)
 		return;
 
+	Color inside = myParms.evalInsidecolor(inputs);
+	Color outside = myParms.evalOutsidecolor(inputs);
+
+	GeometryCache::Key key;
+	key.add(sop0->totalCooks);
+	key.add(sop1->totalCooks);
+	key.add(inside);
+	key.add(outside);
+	if (myCache.replay(key, output))
+	{
+		myWarningString = myCache.getWarning();
+		return;
+	}
+
+	output = myCache.record(key, output);
+
+	myCookStats.beginPhase(CookPhase::Copy);
 	copyPoints(output, sop0);
 	copyAttributes(output, sop0);
-	copyPrimitives(output, sop0);
+	if (!myPassThrough.copyPrimitives(output, sop0))
+		myWarningString = "Input geometry is not a triangulated polygon.";
+	myCookStats.addAllocated(myPassThrough.getAllocated());
+	myCookStats.endPhase();
 
+	CookStats::Phase	phase(myCookStats, CookPhase::Inside);
 	const Position* pos = sop0->getPointPositions();
 
-	Color inside = myParms.evalInsidecolor(inputs);
-	Color outside = myParms.evalOutsidecolor(inputs);
-
 	std::vector<int> insideAttrib;
 	insideAttrib.reserve(sop0->getNumPoints());
+	myCookStats.addAllocated(sop0->getNumPoints() * sizeof(int));
 	for (int i = 0; i < sop0->getNumPoints(); ++i)
 	{
 		// OP_SOPInput* cp = sop1;
@@ -124,6 +146,8 @@ IntersectPointsSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, voi
 	SOP_CustomAttribData attrib{ "Inside", 1, AttribType::Int };
 	attrib.intData = insideAttrib.data();
 	output->setCustomAttribute(&attrib, sop0->getNumPoints());
+
+	myCache.commit(myWarningString);
 }
 
 void
@@ -137,6 +161,18 @@ IntersectPointsSOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 	myParms.setup(manager);
 }
 
+int32_t
+IntersectPointsSOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+IntersectPointsSOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
+
 void
 IntersectPointsSOP::getWarningString(OP_String* warning, void*)
 {
@@ -203,56 +239,4 @@ IntersectPointsSOP::copyAttributes(SOP_Output* output, const OP_SOPInput* sop) c
 	//copyColors(output, sop); // We do not need to copy colors for this SOP
 	copyTextures(output, sop);
 	copyCustomAttributes(output, sop);
-}
-
-void
-IntersectPointsSOP::copyPrimitives(SOP_Output* out, const OP_SOPInput* in)
-{
-	const SOP_PrimitiveInfo* prims = in->myPrimsInfo;
-	bool isTriangulated = true;
-
-	for (int i = 0; i < in->getNumPrimitives(); ++i)
-	{
-		int				nVertices = prims[i].numVertices;
-		const int32_t*	indices = prims[i].pointIndices;
-
-		if (prims[i].type != PrimitiveType::Polygon || nVertices > 3)
-		{
-			isTriangulated = false;
-		}
-
-		switch (nVertices)
-		{
-
-		case 1:
-		{
-			out->addParticleSystem(1, indices[0]);
-			break;
-		}
-		case 2:
-		{
-			out->addLine(indices, 2);
-			break;
-		}
-		case 3:
-		{
-			out->addTriangles(indices, 1);
-		}
-		default:
-		{
-			int32_t* tmp = new int32_t[nVertices + 1];
-			memcpy(tmp, indices, nVertices * sizeof(int32_t));
-			tmp[nVertices] = indices[0];
-
-			out->addLine(tmp, nVertices + 1);
-
-			delete[] tmp;
-		}
-		}
-	}
-
-	if (!isTriangulated)
-	{
-		myWarningString = "Input geometry is not a triangulated polygon.";
-	}
 }
\ No newline at end of file
@@ -16,6 +16,9 @@
 #define __IntersectPointsSOP__
 
 #include "SOP_CPlusPlusBase.h"
+#include "CookStats.h"
+#include "GeometryCache.h"
+#include "GeometryPassThrough.h"
 #include "Parameters.h"
 
 #include <string>
@@ -32,10 +35,13 @@ Inside. 1 if the point is inside, 0 otherwise.
 This SOP takes two inputs:
 	- First: Points to be colored.
 	- Second: Geometry to test whether points are inside or not.
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo, with the
+copy and inside phases.
+
+When neither input has cooked and the colors are the same as in the last cook, the
+last output is emitted again from a GeometryCache instead of testing every point.
+*/
 
 // To get more help about these functions, look at SOP_CPlusPlusBase.h
 class IntersectPointsSOP : public TD::SOP_CPlusPlusBase
@@ -52,17 +58,24 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager*, void*) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 	virtual void		getWarningString(TD::OP_String*, void*) override;
 
 private:
+	enum class CookPhase
+	{
+		Copy,
+		Inside
+	};
+
 	void		copyPoints(TD::SOP_Output*, const TD::OP_SOPInput*) const;
 
 	// Before calling this functions SOP_Output should contain as many points as OP_SOPInput
 	void		copyAttributes(TD::SOP_Output*, const TD::OP_SOPInput*) const;
 
-	// This method returns true if the input geometry only has triangles and lines
-	void		copyPrimitives(TD::SOP_Output*, const TD::OP_SOPInput*);
-
 	void		copyNormals(TD::SOP_Output*, const TD::OP_SOPInput*) const;
 
 	void		copyColors(TD::SOP_Output*, const TD::OP_SOPInput*) const;
@@ -74,6 +87,12 @@ private:
 	std::string	myWarningString;
 	
 	Parameters myParms;
+
+	CookStats			myCookStats;
+
+	GeometryCache		myCache;
+
+	GeometryPassThrough	myPassThrough;
 };
 
 #endif // !__IntersectPointsSOP__
@@ -112,6 +112,8 @@ SpiralSOP::getGeneralInfo(SOP_GeneralInfo* ginfo, const TD::OP_Inputs* inputs, v
 void
 SpiralSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	handleParameters(inputs);
 
 	calculateOutputPoints();
@@ -128,6 +130,7 @@ SpiralSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 		case OutputgeometryMenuItems::Line:
 		{
 			std::vector<int32_t> line(myNumPoints);
+			myCookStats.addAllocated(myNumPoints * sizeof(int32_t));
 			std::iota(line.begin(), line.end(), 0); // Fill a vector with sequencial indices starting at 0
 			output->addLine(line.data(), myNumPoints);
 			break;
@@ -153,6 +156,8 @@ SpiralSOP::execute(SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 void
 SpiralSOP::executeVBO(SOP_VBOOutput* output, const TD::OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	handleParameters(inputs);
 
 	output->enableNormal();
@@ -176,6 +181,7 @@ SpiralSOP::executeVBO(SOP_VBOOutput* output, const TD::OP_Inputs* inputs, void*)
 	}
 
 	std::vector<int32_t> seqNum(myNumPoints);
+	myCookStats.addAllocated(myNumPoints * sizeof(int32_t));
 	std::iota(seqNum.begin(), seqNum.end(), 0); // Fill a vector with sequencial indices starting at 0
 	
 	switch (myOutput)
@@ -209,6 +215,18 @@ SpiralSOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 	myParms.setup(manager);
 }
 
+int32_t
+SpiralSOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+SpiralSOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
+
 void 
 SpiralSOP::handleParameters(const TD::OP_Inputs* inputs)
 {
@@ -269,7 +287,7 @@ SpiralSOP::calculateOutputPoints()
 }
 
 void 
-SpiralSOP::calculateSpiralPoints(std::vector<Position>::iterator& it, int numPts)
+SpiralSOP::calculateSpiralPoints(std::vector<Position>::iterator it, int numPts)
 {
 	const double deltaA = (2 * PI * myTurns) / numPts;
 	const double deltaR = (myTopRad - myBotRad) / numPts;
@@ -299,7 +317,7 @@ SpiralSOP::calculateSpiralPoints(std::vector<Position>::iterator& it, int numPts
 }
 
 void
-SpiralSOP::calculateNormals(std::vector<Vector>::iterator& N, std::vector<Position>::const_iterator& pts, int numPts)
+SpiralSOP::calculateNormals(std::vector<Vector>::iterator N, std::vector<Position>::const_iterator pts, int numPts)
 {
 	Vector reference;
 	switch (myOrientation)
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "SOP_CPlusPlusBase.h"
+#include "CookStats.h"
 #include "Parameters.h"
 
 /*
@@ -36,10 +37,9 @@ parameters:
 	- GPU Direct:	If On, load geometry directly to GPU.
 
 This SOP is a generator and it takes no input.
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo.
+*/
 
 // To get more help about these functions, look at SOP_CPlusPlusBase.h
 class SpiralSOP : public TD::SOP_CPlusPlusBase
@@ -56,14 +56,18 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager*, void*) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 private:
 	void		handleParameters(const TD::OP_Inputs*);
 
 	void		calculateOutputPoints();
 
-	void		calculateSpiralPoints(std::vector<TD::Position>::iterator&, int numPts);
+	void		calculateSpiralPoints(std::vector<TD::Position>::iterator, int numPts);
 
-	void		calculateNormals(std::vector<TD::Vector>::iterator&, std::vector<TD::Position>::const_iterator&, int numPts);
+	void		calculateNormals(std::vector<TD::Vector>::iterator, std::vector<TD::Position>::const_iterator, int numPts);
 
 	void		calculateTriangleStrip();
 
@@ -84,6 +88,8 @@ private:
 	double						myStripWidth;
 	
 	Parameters myParms;
+
+	CookStats			myCookStats;
 };
 
 #endif // !__SpiralSOP__
@@ -0,0 +1,438 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "GeometryCache.h"
+
+#include <algorithm>
+
+using namespace TD;
+
+GeometryCache::GeometryCache() :
+	myValid{ false }, myNumTexCoordLayers{ 0 }, myHasBoundingBox{ false },
+	myBoundingBox{ 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }, myRecorder{ *this }
+{
+}
+
+bool
+GeometryCache::replay(const Key& key, SOP_Output* output)
+{
+	if (!myValid || !(key == myKey))
+		return false;
+
+	int32_t numPoints = static_cast<int32_t>(myPoints.size());
+	output->addPoints(myPoints.data(), numPoints);
+
+	if (!myNormals.empty())
+		output->setNormals(myNormals.data(), static_cast<int32_t>(myNormals.size()), 0);
+
+	if (!myColors.empty())
+		output->setColors(myColors.data(), static_cast<int32_t>(myColors.size()), 0);
+
+	if (myNumTexCoordLayers > 0 && !myTexCoords.empty())
+	{
+		int32_t numTexPoints = static_cast<int32_t>(myTexCoords.size() / myNumTexCoordLayers);
+		output->setTexCoords(myTexCoords.data(), numTexPoints, myNumTexCoordLayers, 0);
+	}
+
+	for (CustomAttribute& attrib : myCustomAttributes)
+	{
+		SOP_CustomAttribData data{ attrib.name.c_str(), attrib.numComponents, attrib.type };
+		size_t size;
+		if (attrib.type == AttribType::Float)
+		{
+			data.floatData = attrib.floatData.data();
+			size = attrib.floatData.size();
+		}
+		else
+		{
+			data.intData = attrib.intData.data();
+			size = attrib.intData.size();
+		}
+		output->setCustomAttribute(&data, static_cast<int32_t>(size / attrib.numComponents));
+	}
+
+	size_t lineOffset = 0;
+	for (const PrimitiveRun& run : myRuns)
+	{
+		switch (run.kind)
+		{
+			case PrimitiveKind::Triangles:
+			{
+				output->addTriangles(myTriangles.data() + 3 * static_cast<size_t>(run.first), run.count);
+				break;
+			}
+			case PrimitiveKind::Lines:
+			{
+				int32_t* sizes = myLineSizes.data() + run.first;
+				output->addLines(myLineIndices.data() + lineOffset, sizes, run.count);
+				for (int32_t i = 0; i < run.count; ++i)
+					lineOffset += sizes[i];
+				break;
+			}
+			case PrimitiveKind::Particles:
+			{
+				output->addParticleSystem(run.count, run.first);
+				break;
+			}
+		}
+	}
+
+	if (myHasBoundingBox)
+		output->setBoundingBox(myBoundingBox);
+
+	for (const GroupOp& op : myGroupOps)
+	{
+		switch (op.call)
+		{
+			case GroupCall::Add:
+				output->addGroup(op.type, op.name.c_str());
+				break;
+			case GroupCall::Destroy:
+				output->destroyGroup(op.type, op.name.c_str());
+				break;
+			case GroupCall::AddTo:
+				output->addToGroup(op.index, op.type, op.name.c_str());
+				break;
+			case GroupCall::DiscardFrom:
+				output->discardFromGroup(op.index, op.type, op.name.c_str());
+				break;
+		}
+	}
+
+	return true;
+}
+
+SOP_Output*
+GeometryCache::record(const Key& key, SOP_Output* output)
+{
+	clear();
+	myKey = key;
+	myRecorder.setOutput(output);
+	return &myRecorder;
+}
+
+void
+GeometryCache::commit(const std::string& warning)
+{
+	myWarning = warning;
+	myValid = true;
+}
+
+void
+GeometryCache::invalidate()
+{
+	clear();
+}
+
+const std::string&
+GeometryCache::getWarning() const
+{
+	return myWarning;
+}
+
+void
+GeometryCache::clear()
+{
+	// Keep the capacity, the next cook usually emits as much geometry as the last one
+	myValid = false;
+	myWarning.clear();
+	myPoints.clear();
+	myNormals.clear();
+	myColors.clear();
+	myTexCoords.clear();
+	myNumTexCoordLayers = 0;
+	myCustomAttributes.clear();
+	myTriangles.clear();
+	myLineIndices.clear();
+	myLineSizes.clear();
+	myRuns.clear();
+	myHasBoundingBox = false;
+	myGroupOps.clear();
+}
+
+GeometryCache::PrimitiveRun&
+GeometryCache::runFor(PrimitiveKind kind)
+{
+	if (myRuns.empty() || myRuns.back().kind != kind || kind == PrimitiveKind::Particles)
+	{
+		int32_t first = 0;
+		if (kind == PrimitiveKind::Triangles)
+			first = static_cast<int32_t>(myTriangles.size() / 3);
+		else if (kind == PrimitiveKind::Lines)
+			first = static_cast<int32_t>(myLineSizes.size());
+		myRuns.push_back(PrimitiveRun{ kind, first, 0 });
+	}
+	return myRuns.back();
+}
+
+template <class T>
+void
+GeometryCache::store(std::vector<T>& dst, const T* src, int32_t count, int32_t start, size_t stride)
+{
+	if (count <= 0 || start < 0)
+		return;
+
+	size_t end = (static_cast<size_t>(start) + count) * stride;
+	if (dst.size() < end)
+		dst.resize(end);
+	std::copy(src, src + count * stride, dst.begin() + start * stride);
+}
+
+#pragma region Recorder
+
+int32_t
+GeometryCache::Recorder::addPoint(const Position& pos)
+{
+	myCache.myPoints.push_back(pos);
+	return myOutput->addPoint(pos);
+}
+
+bool
+GeometryCache::Recorder::addPoints(const Position* pos, int32_t numPoints)
+{
+	if (numPoints > 0)
+		myCache.myPoints.insert(myCache.myPoints.end(), pos, pos + numPoints);
+	return myOutput->addPoints(pos, numPoints);
+}
+
+int32_t
+GeometryCache::Recorder::getNumPoints()
+{
+	return myOutput->getNumPoints();
+}
+
+bool
+GeometryCache::Recorder::setNormal(const Vector& n, int32_t pointIdx)
+{
+	store(myCache.myNormals, &n, 1, pointIdx);
+	return myOutput->setNormal(n, pointIdx);
+}
+
+bool
+GeometryCache::Recorder::setNormals(const Vector* n, int32_t numPoints, int32_t startPointIdx)
+{
+	store(myCache.myNormals, n, numPoints, startPointIdx);
+	return myOutput->setNormals(n, numPoints, startPointIdx);
+}
+
+bool
+GeometryCache::Recorder::hasNormal()
+{
+	return myOutput->hasNormal();
+}
+
+bool
+GeometryCache::Recorder::setColor(const Color& c, int32_t pointIdx)
+{
+	store(myCache.myColors, &c, 1, pointIdx);
+	return myOutput->setColor(c, pointIdx);
+}
+
+bool
+GeometryCache::Recorder::setColors(const Color* colors, int32_t numPoints, int32_t startPointIdx)
+{
+	store(myCache.myColors, colors, numPoints, startPointIdx);
+	return myOutput->setColors(colors, numPoints, startPointIdx);
+}
+
+bool
+GeometryCache::Recorder::hasColor()
+{
+	return myOutput->hasColor();
+}
+
+bool
+GeometryCache::Recorder::setTexCoord(const TexCoord* tex, int32_t numLayers, int32_t pointIdx)
+{
+	return setTexCoords(tex, 1, numLayers, pointIdx);
+}
+
+bool
+GeometryCache::Recorder::setTexCoords(const TexCoord* t, int32_t numPoints, int32_t numLayers, int32_t startPointIdx)
+{
+	// Like the output, the first call decides the number of layers for the cook
+	if (myCache.myNumTexCoordLayers == 0)
+		myCache.myNumTexCoordLayers = std::max(numLayers, 0);
+
+	if (numLayers == myCache.myNumTexCoordLayers)
+		store(myCache.myTexCoords, t, numPoints, startPointIdx, numLayers);
+
+	return myOutput->setTexCoords(t, numPoints, numLayers, startPointIdx);
+}
+
+bool
+GeometryCache::Recorder::hasTexCoord()
+{
+	return myOutput->hasTexCoord();
+}
+
+int32_t
+GeometryCache::Recorder::getNumTexCoordLayers()
+{
+	return myOutput->getNumTexCoordLayers();
+}
+
+bool
+GeometryCache::Recorder::setCustomAttribute(const SOP_CustomAttribData* cu, int32_t numPoints)
+{
+	std::vector<CustomAttribute>& attribs = myCache.myCustomAttributes;
+	auto it = std::find_if(attribs.begin(), attribs.end(),
+		[cu](const CustomAttribute& a) { return a.name == cu->name; });
+	if (it == attribs.end())
+		it = attribs.insert(attribs.end(), CustomAttribute{ cu->name, 0, cu->attribType, {}, {} });
+
+	size_t size = static_cast<size_t>(std::max(numPoints, 0)) * cu->numComponents;
+	it->numComponents = cu->numComponents;
+	it->type = cu->attribType;
+	if (cu->attribType == AttribType::Float)
+	{
+		it->floatData.assign(cu->floatData, cu->floatData + size);
+		it->intData.clear();
+	}
+	else
+	{
+		it->intData.assign(cu->intData, cu->intData + size);
+		it->floatData.clear();
+	}
+
+	return myOutput->setCustomAttribute(cu, numPoints);
+}
+
+bool
+GeometryCache::Recorder::hasCustomAttibutes()
+{
+	return myOutput->hasCustomAttibutes();
+}
+
+bool
+GeometryCache::Recorder::addTriangle(int32_t ptIdx1, int32_t ptIdx2, int32_t ptIdx3)
+{
+	int32_t indices[3] = { ptIdx1, ptIdx2, ptIdx3 };
+	myCache.runFor(PrimitiveKind::Triangles).count++;
+	myCache.myTriangles.insert(myCache.myTriangles.end(), indices, indices + 3);
+	return myOutput->addTriangle(ptIdx1, ptIdx2, ptIdx3);
+}
+
+bool
+GeometryCache::Recorder::addTriangles(const int32_t* indices, int32_t size)
+{
+	if (size > 0)
+	{
+		myCache.runFor(PrimitiveKind::Triangles).count += size;
+		myCache.myTriangles.insert(myCache.myTriangles.end(), indices, indices + 3 * static_cast<size_t>(size));
+	}
+	return myOutput->addTriangles(indices, size);
+}
+
+bool
+GeometryCache::Recorder::addParticleSystem(int32_t numParticles, int32_t startIndex)
+{
+	PrimitiveRun& run = myCache.runFor(PrimitiveKind::Particles);
+	run.first = startIndex;
+	run.count = numParticles;
+	return myOutput->addParticleSystem(numParticles, startIndex);
+}
+
+bool
+GeometryCache::Recorder::addLine(const int32_t* indices, int32_t size)
+{
+	myCache.runFor(PrimitiveKind::Lines).count++;
+	myCache.myLineSizes.push_back(size);
+	myCache.myLineIndices.insert(myCache.myLineIndices.end(), indices, indices + size);
+	return myOutput->addLine(indices, size);
+}
+
+bool
+GeometryCache::Recorder::addLines(const int32_t* indices, int32_t* sizeOfEachLine, int32_t numOfLines)
+{
+	if (numOfLines > 0)
+	{
+		size_t numIndices = 0;
+		for (int32_t i = 0; i < numOfLines; ++i)
+			numIndices += sizeOfEachLine[i];
+
+		myCache.runFor(PrimitiveKind::Lines).count += numOfLines;
+		myCache.myLineSizes.insert(myCache.myLineSizes.end(), sizeOfEachLine, sizeOfEachLine + numOfLines);
+		myCache.myLineIndices.insert(myCache.myLineIndices.end(), indices, indices + numIndices);
+	}
+	return myOutput->addLines(indices, sizeOfEachLine, numOfLines);
+}
+
+int32_t
+GeometryCache::Recorder::getNumPrimitives()
+{
+	return myOutput->getNumPrimitives();
+}
+
+bool
+GeometryCache::Recorder::setBoundingBox(const BoundingBox& bbox)
+{
+	myCache.myHasBoundingBox = true;
+	myCache.myBoundingBox = bbox;
+	return myOutput->setBoundingBox(bbox);
+}
+
+bool
+GeometryCache::Recorder::addGroup(const SOP_GroupType& type, const char* name)
+{
+	myCache.myGroupOps.push_back(GroupOp{ GroupCall::Add, type, name, 0 });
+	return myOutput->addGroup(type, name);
+}
+
+bool
+GeometryCache::Recorder::destroyGroup(const SOP_GroupType& type, const char* name)
+{
+	myCache.myGroupOps.push_back(GroupOp{ GroupCall::Destroy, type, name, 0 });
+	return myOutput->destroyGroup(type, name);
+}
+
+bool
+GeometryCache::Recorder::addPointToGroup(int index, const char* name)
+{
+	return addToGroup(index, SOP_GroupType::Point, name);
+}
+
+bool
+GeometryCache::Recorder::addPrimToGroup(int index, const char* name)
+{
+	return addToGroup(index, SOP_GroupType::Primitive, name);
+}
+
+bool
+GeometryCache::Recorder::addToGroup(int index, const SOP_GroupType& type, const char* name)
+{
+	myCache.myGroupOps.push_back(GroupOp{ GroupCall::AddTo, type, name, index });
+	return myOutput->addToGroup(index, type, name);
+}
+
+bool
+GeometryCache::Recorder::discardFromPointGroup(int index, const char* name)
+{
+	return discardFromGroup(index, SOP_GroupType::Point, name);
+}
+
+bool
+GeometryCache::Recorder::discardFromPrimGroup(int index, const char* name)
+{
+	return discardFromGroup(index, SOP_GroupType::Primitive, name);
+}
+
+bool
+GeometryCache::Recorder::discardFromGroup(int index, const SOP_GroupType& type, const char* name)
+{
+	myCache.myGroupOps.push_back(GroupOp{ GroupCall::DiscardFrom, type, name, index });
+	return myOutput->discardFromGroup(index, type, name);
+}
+
+#pragma endregion
@@ -177,7 +177,8 @@ DestroySOPInstance(SOP_CPlusPlusBase* instance)
 };
 
 SprinkleSOP::SprinkleSOP(const OP_NodeInfo*) : 
-	myRNG{}, myPointCount{0}, myPoints{ nullptr }, myVolSprinkleTree{ nullptr }, myInputCook{}
+	myPointCount{0}, myInputCook{}, myRNG{}, myPoints{ nullptr }, myVolSprinkleTree{ nullptr },
+	myCookStats{ "scatter", "emit" }
 {
 };
 
@@ -199,6 +200,8 @@ SprinkleSOP::getGeneralInfo(SOP_GeneralInfo* ginfo, const TD::OP_Inputs* inputs,
 void
 SprinkleSOP::execute(TD::SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	const OP_SOPInput* sop = inputs->getInputSOP(0);
 	if (!sop)
 		return;
@@ -206,6 +209,22 @@ SprinkleSOP::execute(TD::SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 	myPointCount = myParms.evalPointcount(inputs);
 	
 	double seed = myParms.evalSeed(inputs);
+	bool separatePoints = myParms.evalSeparatepoints(inputs);
+	double minimumDistance = myParms.evalMinimumdistance(inputs);
+	GenerateMenuItems generate = myParms.evalGenerate(inputs);
+	const OP_SOPInput* sop1 = inputs->getInputSOP(1);
+
+	// The scatter is seeded, same inputs and parameters give the same points
+	GeometryCache::Key key;
+	key.add(sop->totalCooks);
+	key.add(sop1 ? sop1->totalCooks : -1);
+	key.add(myPointCount);
+	key.add(seed);
+	key.add(separatePoints);
+	key.add(minimumDistance);
+	key.add(generate);
+	if (myCache.replay(key, output))
+		return;
 
 	unsigned int* seedInt = reinterpret_cast<unsigned int*>(&seed);
 	myRNG.seed(*seedInt);
@@ -216,13 +235,14 @@ SprinkleSOP::execute(TD::SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 		return;
 	}
 
+	output = myCache.record(key, output);
+
 	//if (!myPoints || myParms.changed || myInputCook != sop->totalCooks)
 	//{
+	myCookStats.beginPhase(CookPhase::Scatter);
 	delete myPoints;
 	mySurfaceAttribute.clear();
-	myPoints = new RandomPointsBuffer(myParms.evalSeparatepoints(inputs), myParms.evalMinimumdistance(inputs));
-
-	GenerateMenuItems generate = myParms.evalGenerate(inputs);
+	myPoints = new RandomPointsBuffer(separatePoints, minimumDistance);
 
 	switch (generate)
 	{
@@ -241,11 +261,13 @@ SprinkleSOP::execute(TD::SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 	}
 
 	myInputCook = sop->totalCooks;
+	myCookStats.addAllocated(myPoints->getVector().capacity() * sizeof(TD::Position) + mySurfaceAttribute.capacity() * sizeof(float));
+	myCookStats.endPhase();
 	//}
 
 	bool surfaceGen = generate == GenerateMenuItems::Area || generate == GenerateMenuItems::Primitive;
 
-	const OP_SOPInput* sop1 = inputs->getInputSOP(1);
+	CookStats::Phase	emit(myCookStats, CookPhase::Emit);
 	if (surfaceGen && sop1)
 	{
 		std::vector<TD::Position>&& vec = mapSurfaceToSOP(sop1);
@@ -263,6 +285,8 @@ SprinkleSOP::execute(TD::SOP_Output* output, const TD::OP_Inputs* inputs, void*)
 		data.floatData = mySurfaceAttribute.data();
 		output->setCustomAttribute(&data, output->getNumPoints());
 	}
+
+	myCache.commit();
 }
 
 void
@@ -276,6 +300,18 @@ SprinkleSOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 	myParms.setup(manager);
 }
 
+int32_t
+SprinkleSOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+SprinkleSOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
+
 void
 SprinkleSOP::getErrorString(OP_String* error, void*)
 {
@@ -16,6 +16,8 @@
 #define __SprinkleSOP__
 
 #include "SOP_CPlusPlusBase.h"
+#include "CookStats.h"
+#include "GeometryCache.h"
 #include "Parameters.h"
 
 #include <random>
@@ -48,10 +50,13 @@ This SOP takes one to two inputs:
 
 Note, if Generate is [Surface Area, Per Primitive] a point float attribute named Surface will be setted with values
 [primNumber, r1, r2] where r1, r2 are uniform random numbers from 0 to 1.
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo, with the
+scatter and emit phases.
+
+When neither input has cooked and the parameters are the same as in the last cook, the
+last output is emitted again from a GeometryCache instead of scattering the points.
+*/
 
 // To get more help about these functions, look at SOP_CPlusPlusBase.h
 class SprinkleSOP : public TD::SOP_CPlusPlusBase
@@ -68,9 +73,19 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager*, void*) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 	virtual void		getErrorString(TD::OP_String*, void*) override;
 
 private:
+	enum class CookPhase
+	{
+		Scatter,
+		Emit
+	};
+
 	void				executeAreaScatter(const TD::OP_SOPInput*);
 
 	void				executePrimScatter(const TD::OP_SOPInput*);
@@ -99,6 +114,10 @@ private:
 	std::vector<float>	mySurfaceAttribute;
 	
 	Parameters		myParms;
+
+	CookStats			myCookStats;
+
+	GeometryCache		myCache;
 };
 
 #endif // !__SprinkleSOP__
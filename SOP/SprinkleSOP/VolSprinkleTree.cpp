@@ -17,6 +17,7 @@
 #include "SOP_CPlusPlusBase.h"
 #include <random>
 #include <array>
+#include <algorithm>
 
 using namespace TD;
 
@@ -64,7 +65,8 @@ VolSprinkleTree::VolSprinkleTree(const TD::OP_SOPInput* sop, BoundingBox& bb)
 			for (float z = bb.minZ; z < bb.maxZ; z += boxSize)
 			{
 				Position origin = Position(x, y, z);
-				processBox(BoundingBox(origin, origin + boxSizeV), sop);
+				BoundingBox box = BoundingBox(origin, origin + boxSizeV);
+				processBox(box, sop);
 			}
 		}
 	}
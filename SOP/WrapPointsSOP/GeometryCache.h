@@ -0,0 +1,223 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#ifndef __GeometryCache__
+#define __GeometryCache__
+
+#include "SOP_CPlusPlusBase.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+Keeps the output of the last cook of a SOP so it can be emitted again when nothing
+the cook depends on has changed. The same files are copied in every SOP folder that
+uses it.
+
+The operator builds a Key from its inputs' totalCooks and its evaluated parameters.
+If replay() finds the same key it re-emits the stored geometry with one batched call
+per array and the cook is done. Otherwise the operator cooks into the SOP_Output
+returned by record(), which forwards every call to the real output and keeps a copy,
+and calls commit() once the cook succeeded.
+
+Consecutive primitives of the same kind are replayed with a single addTriangles or
+addLines call, so primitive order is the same as in the recorded cook.
+*/
+class GeometryCache
+{
+public:
+	// FNV-1a hash of everything the output of a cook depends on
+	class Key
+	{
+	public:
+		Key() : myHash{ 14695981039346656037ull } {}
+
+		template <class T>
+		void
+		add(const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Key::add needs a plain value");
+			addBytes(&value, sizeof(T));
+		}
+
+		void
+		add(const char* str)
+		{
+			addBytes(str, str ? std::strlen(str) + 1 : 0);
+		}
+
+		bool	operator==(const Key& other) const { return myHash == other.myHash; }
+
+	private:
+		void
+		addBytes(const void* data, size_t size)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < size; ++i)
+			{
+				myHash ^= bytes[i];
+				myHash *= 1099511628211ull;
+			}
+		}
+
+		uint64_t	myHash;
+	};
+
+	GeometryCache();
+
+	// Emits the stored geometry to output and returns true if key matches the
+	// last committed cook
+	bool		replay(const Key& key, TD::SOP_Output* output);
+
+	// Drops the stored geometry and returns an output that records the cook
+	// while forwarding it to output. Valid until the next call to record()
+	TD::SOP_Output*	record(const Key& key, TD::SOP_Output* output);
+
+	// Marks the recorded cook as complete, warning is given back by getWarning()
+	// on the cooks that replay it
+	void		commit(const std::string& warning = std::string());
+
+	void		invalidate();
+
+	const std::string&	getWarning() const;
+
+private:
+	enum class PrimitiveKind
+	{
+		Triangles,
+		Lines,
+		Particles
+	};
+
+	// A run of consecutive primitives of the same kind. For triangles and lines
+	// first and count index myTriangles/myLineSizes, for particles they are the
+	// arguments of addParticleSystem
+	struct PrimitiveRun
+	{
+		PrimitiveKind	kind;
+		int32_t			first;
+		int32_t			count;
+	};
+
+	struct CustomAttribute
+	{
+		std::string				name;
+		int32_t					numComponents;
+		TD::AttribType			type;
+		std::vector<float>		floatData;
+		std::vector<int32_t>	intData;
+	};
+
+	enum class GroupCall
+	{
+		Add,
+		Destroy,
+		AddTo,
+		DiscardFrom
+	};
+
+	struct GroupOp
+	{
+		GroupCall			call;
+		TD::SOP_GroupType	type;
+		std::string			name;
+		int					index;
+	};
+
+	class Recorder : public TD::SOP_Output
+	{
+	public:
+		Recorder(GeometryCache& cache) : myCache(cache), myOutput{ nullptr } {}
+
+		void	setOutput(TD::SOP_Output* output) { myOutput = output; }
+
+		virtual int32_t	addPoint(const TD::Position& pos) override;
+		virtual bool	addPoints(const TD::Position* pos, int32_t numPoints) override;
+		virtual int32_t	getNumPoints() override;
+
+		virtual bool	setNormal(const TD::Vector& n, int32_t pointIdx) override;
+		virtual bool	setNormals(const TD::Vector* n, int32_t numPoints, int32_t startPointIdx) override;
+		virtual bool	hasNormal() override;
+
+		virtual bool	setColor(const TD::Color& c, int32_t pointIdx) override;
+		virtual bool	setColors(const TD::Color* colors, int32_t numPoints, int32_t startPointIdx) override;
+		virtual bool	hasColor() override;
+
+		virtual bool	setTexCoord(const TD::TexCoord* tex, int32_t numLayers, int32_t pointIdx) override;
+		virtual bool	setTexCoords(const TD::TexCoord* t, int32_t numPoints, int32_t numLayers, int32_t startPointIdx) override;
+		virtual bool	hasTexCoord() override;
+		virtual int32_t	getNumTexCoordLayers() override;
+
+		virtual bool	setCustomAttribute(const TD::SOP_CustomAttribData* cu, int32_t numPoints) override;
+		virtual bool	hasCustomAttibutes() override;
+
+		virtual bool	addTriangle(int32_t ptIdx1, int32_t ptIdx2, int32_t ptIdx3) override;
+		virtual bool	addTriangles(const int32_t* indices, int32_t size) override;
+		virtual bool	addParticleSystem(int32_t numParticles, int32_t startIndex) override;
+		virtual bool	addLine(const int32_t* indices, int32_t size) override;
+		virtual bool	addLines(const int32_t* indices, int32_t* sizeOfEachLine, int32_t numOfLines) override;
+		virtual int32_t	getNumPrimitives() override;
+
+		virtual bool	setBoundingBox(const TD::BoundingBox& bbox) override;
+
+		virtual bool	addGroup(const TD::SOP_GroupType& type, const char* name) override;
+		virtual bool	destroyGroup(const TD::SOP_GroupType& type, const char* name) override;
+		virtual bool	addPointToGroup(int index, const char* name) override;
+		virtual bool	addPrimToGroup(int index, const char* name) override;
+		virtual bool	addToGroup(int index, const TD::SOP_GroupType& type, const char* name) override;
+		virtual bool	discardFromPointGroup(int index, const char* name) override;
+		virtual bool	discardFromPrimGroup(int index, const char* name) override;
+		virtual bool	discardFromGroup(int index, const TD::SOP_GroupType& type, const char* name) override;
+
+	private:
+		GeometryCache&		myCache;
+		TD::SOP_Output*		myOutput;
+	};
+
+	void		clear();
+
+	// Returns the run new primitives of kind have to be appended to
+	PrimitiveRun&	runFor(PrimitiveKind kind);
+
+	template <class T>
+	static void	store(std::vector<T>& dst, const T* src, int32_t count, int32_t start, size_t stride = 1);
+
+	Key									myKey;
+	bool								myValid;
+	std::string							myWarning;
+
+	std::vector<TD::Position>			myPoints;
+	std::vector<TD::Vector>				myNormals;
+	std::vector<TD::Color>				myColors;
+	std::vector<TD::TexCoord>			myTexCoords;
+	int32_t								myNumTexCoordLayers;
+	std::vector<CustomAttribute>		myCustomAttributes;
+
+	std::vector<int32_t>				myTriangles;
+	std::vector<int32_t>				myLineIndices;
+	std::vector<int32_t>				myLineSizes;
+	std::vector<PrimitiveRun>			myRuns;
+
+	bool								myHasBoundingBox;
+	TD::BoundingBox						myBoundingBox;
+	std::vector<GroupOp>				myGroupOps;
+
+	Recorder							myRecorder;
+};
+
+#endif
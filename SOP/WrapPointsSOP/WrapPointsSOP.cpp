@@ -101,7 +101,8 @@ DestroySOPInstance(SOP_CPlusPlusBase* instance)
 
 };
 
-WrapPointsSOP::WrapPointsSOP(const OP_NodeInfo*)
+WrapPointsSOP::WrapPointsSOP(const OP_NodeInfo*) :
+	myCookStats{ "cast", "copy" }
 {
 };
 
@@ -122,6 +123,8 @@ WrapPointsSOP::getGeneralInfo(SOP_GeneralInfo* ginfo, const OP_Inputs* inputs, v
 void
 WrapPointsSOP::execute(SOP_Output* output, const OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
+
 	const OP_SOPInput* sop0 = inputs->getInputSOP(0);
 	const OP_SOPInput* sop1 = inputs->getInputSOP(1);
 	if (!sop0 || !sop1)
@@ -132,33 +135,57 @@ WrapPointsSOP::execute(SOP_Output* output, const OP_Inputs* inputs, void*)
 	double scale = myParms.evalScale(inputs);
 	Color hitColor = myParms.evalHitcolor(inputs);
 	Color missColor = myParms.evalMisscolor(inputs);
+	std::array<double, 3> directionArray = myParms.evalDirection(inputs);
+	std::array<double, 3> originArray = myParms.evalDestination(inputs);
+
+	inputs->enablePar("Direction", rays != RaysMenuItems::Radial);
+	inputs->enablePar("Destination", rays == RaysMenuItems::Radial);
+
+	GeometryCache::Key key;
+	key.add(sop0->totalCooks);
+	key.add(sop1->totalCooks);
+	key.add(rays);
+	key.add(reverse);
+	key.add(scale);
+	key.add(hitColor);
+	key.add(missColor);
+	key.add(rays == RaysMenuItems::Radial ? originArray : directionArray);
+	if (myCache.replay(key, output))
+	{
+		myWarningString = myCache.getWarning();
+		return;
+	}
+
+	output = myCache.record(key, output);
 
+	myCookStats.beginPhase(CookPhase::Cast);
 	switch (rays)
 	{
 		default:
 		case RaysMenuItems::Parallel:
 		{
-			inputs->enablePar("Direction", true);
-			inputs->enablePar("Destination", false);
-			std::array<double, 3> directionArray = myParms.evalDirection(inputs);
 			Vector direction = Vector((float)directionArray[0], (float)directionArray[1], (float)directionArray[2]);
 			castParallel(output, sop0, sop1, direction, reverse, scale, hitColor, missColor);
 			break;
 		}
 		case RaysMenuItems::Radial:
 		{
-			inputs->enablePar("Direction", false);
-			inputs->enablePar("Destination", true);
-			std::array<double, 3> originArray = myParms.evalDestination(inputs);
 			Position origin = Position((float)originArray[0], (float)originArray[1], (float)originArray[2]);
-			bool reverse = myParms.evalReverse(inputs);
 			castRadial(output, sop0, sop1, origin, reverse, scale, hitColor, missColor);
 			break;
 		}
 	}
 
+	myCookStats.endPhase();
+
+	myCookStats.beginPhase(CookPhase::Copy);
 	copyAttributes(output, sop0);
-	copyPrimitives(output, sop0);
+	if (!myPassThrough.copyPrimitives(output, sop0))
+		myWarningString = "Input geometry is not a triangulated polygon.";
+	myCookStats.addAllocated(myPassThrough.getAllocated());
+	myCookStats.endPhase();
+
+	myCache.commit(myWarningString);
 }
 
 void
@@ -172,6 +199,18 @@ WrapPointsSOP::setupParameters(OP_ParameterManager* manager, void*)
 	myParms.setup(manager);
 }
 
+int32_t
+WrapPointsSOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+WrapPointsSOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
+
 void
 WrapPointsSOP::getWarningString(OP_String* warning, void*)
 {
@@ -253,58 +292,6 @@ WrapPointsSOP::copyCustomAttributes(SOP_Output* out, const OP_SOPInput* in) cons
 	}
 }
 
-void
-WrapPointsSOP::copyPrimitives(SOP_Output* out, const OP_SOPInput* in)
-{
-	const SOP_PrimitiveInfo* prims = in->myPrimsInfo;
-	bool isTriangulated = true;
-
-	for (int i = 0; i < in->getNumPrimitives(); ++i)
-	{
-		int				nVertices = prims[i].numVertices;
-		const int32_t*	indices = prims[i].pointIndices;
-
-		if (prims[i].type != PrimitiveType::Polygon || nVertices > 3)
-		{
-			isTriangulated = false;
-		}
-
-		switch (nVertices)
-		{
-
-		case 1:
-		{
-			out->addParticleSystem(1, indices[0]);
-			break;
-		}
-		case 2:
-		{
-			out->addLine(indices, 2);
-			break;
-		}
-		case 3:
-		{
-			out->addTriangles(indices, 1);
-		}
-		default:
-		{
-			int32_t* tmp = new int32_t[nVertices + 1];
-			memcpy(tmp, indices, nVertices * sizeof(int32_t));
-			tmp[nVertices] = indices[0];
-
-			out->addLine(tmp, nVertices + 1);
-
-			delete[] tmp;
-		}
-		}
-	}
-
-	if (!isTriangulated)
-	{
-		myWarningString = "Input geometry is not a triangulated polygon.";
-	}
-}
-
 void
 WrapPointsSOP::castPoint(SOP_Output* output, const Position* pos, const Vector* normals, int index, const OP_SOPInput* geo, Vector dir, double scale, Color hitColor, Color missColor)
 {
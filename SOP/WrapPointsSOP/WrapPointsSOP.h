@@ -16,6 +16,9 @@
 #define __WrapPointsSOP__
 
 #include "SOP_CPlusPlusBase.h"
+#include "CookStats.h"
+#include "GeometryCache.h"
+#include "GeometryPassThrough.h"
 #include "CPlusPlus_Common.h"
 #include "Parameters.h"
 
@@ -33,10 +36,13 @@ This example implements a SOP which uses sendRay to wrap input 1 to input 2.
 		where it hit the second input.
 
 This SOP takes two inputs and wraps the first one onto the second one.
-*/
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
+It outputs the cook time statistics described in CookStats.h to CHOPInfo, with the
+cast and copy phases.
+
+When neither input has cooked and the parameters are the same as in the last cook, the
+last output is emitted again from a GeometryCache instead of casting the rays.
+*/
 
 // To get more help about these functions, look at SOP_CPlusPlusBase.h
 class WrapPointsSOP : public TD::SOP_CPlusPlusBase
@@ -53,16 +59,23 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager*, void*) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void*) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*) override;
+
 	virtual void		getWarningString(TD::OP_String*, void*) override;
 
 private:
+	enum class CookPhase
+	{
+		Cast,
+		Copy
+	};
+
 	void		castParallel(TD::SOP_Output*, const TD::OP_SOPInput*, const TD::OP_SOPInput*, TD::Vector, bool, double, TD::Color, TD::Color);
 
 	void		castRadial(TD::SOP_Output*, const TD::OP_SOPInput*, const TD::OP_SOPInput*, TD::Position, bool, double, TD::Color, TD::Color);
 
-	// This method returns true if the input geometry only has triangles and lines
-	void		copyPrimitives(TD::SOP_Output*, const TD::OP_SOPInput*);
-
 	// Before calling this functions SOP_Output should contain as many points as OP_SOPInput
 	void		copyAttributes(TD::SOP_Output*, const TD::OP_SOPInput*) const;
 
@@ -77,6 +90,12 @@ private:
 	std::string	myWarningString;
 	
 	Parameters	myParms;
+
+	CookStats			myCookStats;
+
+	GeometryCache		myCache;
+
+	GeometryPassThrough	myPassThrough;
 };
 
 #endif // !__WrapPointsSOP__
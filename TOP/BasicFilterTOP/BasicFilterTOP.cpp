@@ -16,7 +16,9 @@
 
 #include "ThreadManager.h"
 #include "FilterWork.h"
+#include "Quantize.h"
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 #include <cstdlib>
@@ -75,14 +77,19 @@ DestroyTOPInstance(TOP_CPlusPlusBase* instance, TOP_Context *context)
 };
 
 BasicFilterTOP::BasicFilterTOP(const OP_NodeInfo* info, TOP_Context* context) :
-	myThreadManagers{}, myThreadQueue{}, myExecuteCount{ 0 }, myMultiThreaded{ false },
 	myContext{ context},
-	myPrevDownRes{nullptr}
+	myFrameDownRes{nullptr},
+	myDownloads{ 0 },
+	myThreadManagers{}, myThreadQueue{}, myExecuteCount{ 0 }, myMultiThreaded{ false },
+	myCookStats{ "download", "filter", "upload" }
 {
 }
 
 BasicFilterTOP::~BasicFilterTOP()
 {
+	// Joins the worker threads, they would outlive the node otherwise
+	if (myMultiThreaded)
+		switchToSingleThreaded();
 }
 
 void
@@ -97,36 +104,52 @@ BasicFilterTOP::getGeneralInfo(TOP_GeneralInfo* ginfo, const TD::OP_Inputs*, voi
 void
 BasicFilterTOP::execute(TOP_Output* output, const TD::OP_Inputs* inputs, void* reserved)
 {
+	CookStats::Cook	cook(myCookStats);
 	myExecuteCount++;
 	const OP_TOPInput*	top = inputs->getInputTOP(0);
 
 	if (!top)
+	{
+		myDownloads.clear();
 		return;
-
-	int inHeight = top->textureDesc.height;
-	int inWidth = top->textureDesc.width;
+	}
 
 	OP_TOPInputDownloadOptions	opts;
 	opts.pixelFormat = top->textureDesc.pixelFormat;
 
 
-	OP_SmartRef<OP_TOPDownloadResult> downRes = top->downloadTexture(opts,nullptr);
+	myCookStats.beginPhase(CookPhase::Download);
+	myDownloads.setDepth(inputs->getParInt("Downloaddepth"));
+	OP_SmartRef<OP_TOPDownloadResult> downRes = myDownloads.push(top, opts);
+	myCookStats.endPhase();
 
 	if (!downRes)
 		return;
 
-
-	bool doDither = inputs->getParInt("Dither");
-	int bitsPerColor = inputs->getParInt("Bitspercolor");
-	myPrevDownRes = std::move(downRes);
-	if (myPrevDownRes)
+	// The frame may be from a few cooks ago, its size is the one it was downloaded with
+	int inHeight = downRes->textureDesc.height;
+	int inWidth = downRes->textureDesc.width;
+
+
+	Filter::Settings settings;
+	settings.doDither = inputs->getParInt("Dither");
+	settings.ditherMode = static_cast<Filter::DitherMode>(inputs->getParInt("Dithermode"));
+	settings.serpentine = inputs->getParInt("Serpentine");
+	settings.bitsPerColor = inputs->getParInt("Bitspercolor");
+	settings.resizeFilter = static_cast<Filter::ResizeFilter>(inputs->getParInt("Resizefilter"));
+	int numThreads = inputs->getParInt("Threads");
+	int downscale = inputs->getParInt("Downscale");
+	int outWidth = std::max(inWidth / downscale, 1);
+	int outHeight = std::max(inHeight / downscale, 1);
+	myFrameDownRes = std::move(downRes);
+	if (myFrameDownRes)
 	{
 		if (myMultiThreaded)
 		{
 			if (myThreadQueue.empty())
 			{
 				ThreadManager* threadForWork = myThreadManagers.at(0);
-				threadForWork->sync(doDither, bitsPerColor, inWidth, inHeight, myPrevDownRes, myContext);
+				threadForWork->sync(settings, inWidth, inHeight, outWidth, outHeight, myFrameDownRes, myContext);
 				myThreadQueue.push(threadForWork);
 			}
 			else if (myThreadQueue.front()->getStatus() == ThreadStatus::Done)
@@ -136,9 +159,12 @@ BasicFilterTOP::execute(TOP_Output* output, const TD::OP_Inputs* inputs, void* r
 				OP_SmartRef<TOP_Buffer> outBuffer = nullptr;
 				TOP_UploadInfo info;
 				threadForWork->popOutBuffer(outBuffer, info);
+				myCookStats.addAllocated(outBuffer->size);
+				myCookStats.beginPhase(CookPhase::Upload);
 				output->uploadBuffer(&outBuffer, info, nullptr);
+				myCookStats.endPhase();
 
-				threadForWork->sync(doDither, bitsPerColor, inWidth, inHeight, myPrevDownRes, myContext);
+				threadForWork->sync(settings, inWidth, inHeight, outWidth, outHeight, myFrameDownRes, myContext);
 				myThreadQueue.push(threadForWork);
 			}
 			else
@@ -147,7 +173,7 @@ BasicFilterTOP::execute(TOP_Output* output, const TD::OP_Inputs* inputs, void* r
 				{
 					if (tm->getStatus() == ThreadStatus::Waiting)
 					{
-						tm->sync(doDither, bitsPerColor, inWidth, inHeight, myPrevDownRes, myContext);
+						tm->sync(settings, inWidth, inHeight, outWidth, outHeight, myFrameDownRes, myContext);
 						myThreadQueue.push(tm);
 						break;
 					}
@@ -162,30 +188,40 @@ BasicFilterTOP::execute(TOP_Output* output, const TD::OP_Inputs* inputs, void* r
 
 
 			TOP_UploadInfo info;
-			info.textureDesc = myPrevDownRes->textureDesc;
+			info.textureDesc = myFrameDownRes->textureDesc;
+			info.textureDesc.width = outWidth;
+			info.textureDesc.height = outHeight;
 			info.colorBufferIndex = 0;
 
-			uint64_t byteSize = myPrevDownRes->size;
+			uint64_t byteSize = static_cast<uint64_t>(outWidth) * outHeight * sizeof(uint32_t);
 			OP_SmartRef<TOP_Buffer> outbuf = myContext->createOutputBuffer(byteSize, TOP_BufferFlags::None, nullptr);
+			myCookStats.addAllocated(byteSize);
 
 
-			uint32_t* inBuffer = (uint32_t*)myPrevDownRes->getData();
+			uint32_t* inBuffer = (uint32_t*)myFrameDownRes->getData();
 			uint32_t* outBuffer = (uint32_t*)outbuf->data;
 
-			int outWidth = info.textureDesc.width;
-			int outHeight = info.textureDesc.height;
+			myWorkerPool.setNumThreads(numThreads);
 
+			myCookStats.beginPhase(CookPhase::Filter);
 			Filter::doFilterWork(
 				inBuffer, inWidth, inHeight, outBuffer, outWidth,
-				outHeight, doDither, bitsPerColor
+				outHeight, settings, myScratch, &myWorkerPool
 			);
+			myCookStats.addAllocated(myScratch.getAllocated());
+			myCookStats.endPhase();
 
+			myCookStats.beginPhase(CookPhase::Upload);
 			output->uploadBuffer(&outbuf, info, nullptr);
+			myCookStats.endPhase();
 		}
 	}
-	// myPrevDownRes = std::move(downRes);
 
 	bool threaded = inputs->getParInt("Multithreaded");
+	inputs->enablePar("Threads", !threaded);
+	inputs->enablePar("Dithermode", settings.doDither);
+	inputs->enablePar("Serpentine", settings.doDither && settings.ditherMode == Filter::DitherMode::FloydSteinberg);
+	inputs->enablePar("Resizefilter", downscale > 1);
 
 	if (threaded & !myMultiThreaded)
 		switchToMultiThreaded();
@@ -226,6 +262,45 @@ BasicFilterTOP::setupParameters(OP_ParameterManager* manager, void* reserved)
 		assert(res == OP_ParAppendResult::Success);
 	}
 
+	{
+		OP_StringParameter sp;
+		sp.name = "Dithermode";
+		sp.label = "Dither Mode";
+		sp.page = "Filter";
+		sp.defaultValue = "Floydsteinberg";
+		std::array<const char*, 5> Names =
+		{
+			"Floydsteinberg",
+			"Bayer2",
+			"Bayer4",
+			"Bayer8",
+			"Bluenoise"
+		};
+		std::array<const char*, 5> Labels =
+		{
+			"Floyd-Steinberg",
+			"Bayer 2x2",
+			"Bayer 4x4",
+			"Bayer 8x8",
+			"Blue Noise"
+		};
+		OP_ParAppendResult res = manager->appendMenu(sp, int(Names.size()), Names.data(), Labels.data());
+
+		assert(res == OP_ParAppendResult::Success);
+	}
+
+	{
+		OP_NumericParameter np;
+		np.name = "Serpentine";
+		np.label = "Serpentine";
+		np.page = "Filter";
+		np.defaultValues[0] = false;
+
+		OP_ParAppendResult res = manager->appendToggle(np);
+
+		assert(res == OP_ParAppendResult::Success);
+	}
+
 	{
 		OP_NumericParameter np;
 		np.name = "Multithreaded";
@@ -238,6 +313,112 @@ BasicFilterTOP::setupParameters(OP_ParameterManager* manager, void* reserved)
 		assert(res == OP_ParAppendResult::Success);
 	}
 
+	{
+		OP_NumericParameter np;
+		np.name = "Threads";
+		np.label = "Threads";
+		np.page = "Filter";
+		np.defaultValues[0] = 1;
+		np.minSliders[0] = 1.0;
+		np.maxSliders[0] = 16.0;
+		np.minValues[0] = 1.0;
+		np.maxValues[0] = 64.0;
+		np.clampMins[0] = true;
+		np.clampMaxes[0] = true;
+		OP_ParAppendResult res = manager->appendInt(np);
+
+		assert(res == OP_ParAppendResult::Success);
+	}
+
+	{
+		OP_NumericParameter np;
+		np.name = "Downscale";
+		np.label = "Downscale";
+		np.page = "Filter";
+		np.defaultValues[0] = 1;
+		np.minSliders[0] = 1.0;
+		np.maxSliders[0] = 8.0;
+		np.minValues[0] = 1.0;
+		np.maxValues[0] = 16.0;
+		np.clampMins[0] = true;
+		np.clampMaxes[0] = true;
+		OP_ParAppendResult res = manager->appendInt(np);
+
+		assert(res == OP_ParAppendResult::Success);
+	}
+
+	{
+		OP_StringParameter sp;
+		sp.name = "Resizefilter";
+		sp.label = "Resize Filter";
+		sp.page = "Filter";
+		sp.defaultValue = "Box";
+		std::array<const char*, 3> Names =
+		{
+			"Nearest",
+			"Bilinear",
+			"Box"
+		};
+		std::array<const char*, 3> Labels =
+		{
+			"Nearest",
+			"Bilinear",
+			"Box"
+		};
+		OP_ParAppendResult res = manager->appendMenu(sp, int(Names.size()), Names.data(), Labels.data());
+
+		assert(res == OP_ParAppendResult::Success);
+	}
+
+	{
+		OP_NumericParameter np;
+		np.name = "Downloaddepth";
+		np.label = "Download Depth";
+		np.page = "Filter";
+		np.defaultValues[0] = 0;
+		np.minSliders[0] = 0.0;
+		np.maxSliders[0] = 4.0;
+		np.minValues[0] = 0.0;
+		np.maxValues[0] = 8.0;
+		np.clampMins[0] = true;
+		np.clampMaxes[0] = true;
+		OP_ParAppendResult res = manager->appendInt(np);
+
+		assert(res == OP_ParAppendResult::Success);
+	}
+
+}
+
+int32_t
+BasicFilterTOP::getNumInfoCHOPChans(void*)
+{
+	return static_cast<int32_t>(InfoChopChan::Size) + myDownloads.getNumInfoCHOPChans() + myCookStats.getNumInfoCHOPChans();
+}
+
+void
+BasicFilterTOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	// The downloads and cook statistics go after our own channels
+	if (index >= static_cast<int32_t>(InfoChopChan::Size))
+	{
+		index -= static_cast<int32_t>(InfoChopChan::Size);
+		if (index < myDownloads.getNumInfoCHOPChans())
+			myDownloads.getInfoCHOPChan(index, chan);
+		else
+			myCookStats.getInfoCHOPChan(index - myDownloads.getNumInfoCHOPChans(), chan);
+		return;
+	}
+
+	switch (static_cast<InfoChopChan>(index))
+	{
+		case InfoChopChan::QuantizeKernel:
+		default:
+		{
+			chan->name->setString("quantize_kernel");
+			chan->value = static_cast<float>(Filter::getQuantizeKernel());
+			break;
+		}
+	}
 }
 
 void 
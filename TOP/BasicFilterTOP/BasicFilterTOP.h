@@ -15,6 +15,10 @@
 #define __BasicFilterTOP__
 
 #include "TOP_CPlusPlusBase.h"
+#include "CookStats.h"
+#include "WorkerPool.h"
+#include "FilterWork.h"
+#include "DownloadQueue.h"
 
 #include <thread>
 #include <condition_variable>
@@ -36,13 +40,29 @@ It takes the following parameters:
 	- Bits per Color:	The number of bits for the RGB channels. Therefore, if
 		we set this parameter to 1. We limit our color palette to 2^(3*1) = 8 colors.
 	- Dither:	If on, we apply a dithering algorithm to diffuse the error.
+	- Dither Mode:	Floyd-Steinberg diffuses the error to the neighbouring pixels. The Bayer
+		and Blue Noise modes compare each pixel with a tiled threshold mask, they do not depend
+		on other pixels so they are vectorized and split across all the Threads.
+	- Serpentine:	If on, Floyd-Steinberg scans every other row from right to left, which
+		breaks up its diagonal patterns. Each frame then runs on one thread.
 	- Multithreaded: If on, we calculate the output for 3 frames at the same time, therefore 
-		it lags from the input by 3/4 frames depending on Download Type.
+		it lags from the input by 3 frames plus Download Depth.
+	- Threads: When Multithreaded is off, the number of threads each frame is split across.
+		The output is the same as with 1 thread and there is no added latency.
+	- Downscale:	Divides the output resolution by this factor.
+	- Resize Filter:	How the input is resampled when Downscale is above 1: Nearest,
+		Bilinear or Box, which averages all the input pixels under an output pixel.
+	- Download Depth:	Frames in flight between the GPU and this TOP, see DownloadQueue.h.
+		The default 0 filters the current frame and waits for its download in the cook.
+
+It outputs the following channels to CHOPInfo:
+	- quantize_kernel:	The kernel limiting the colors, 0 for scalar, 1 for SSE2 and 2 for AVX2.
+		It is picked at load time from the instructions the CPU supports.
+It also outputs the download channels described in DownloadQueue.h and the cook time
+statistics described in CookStats.h, with the download, filter and upload phases. In multithreaded mode the filter runs on the worker threads and is not part
+of the cook time.
 */
 
-// Check methods [getNumInfoCHOPChans, getInfoCHOPChan, getInfoDATSize, getInfoDATEntries]
-// if you want to output values to the Info CHOP/DAT
-
 // To get more help about these functions, look at TOP_CPlusPlusBase.h
 class BasicFilterTOP : public TOP_CPlusPlusBase
 {
@@ -56,19 +76,45 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager*, void* reserved) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void* reserved) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void* reserved) override;
+
 private:
+	enum class InfoChopChan
+	{
+		QuantizeKernel,
+		Size
+	};
+
+	enum class CookPhase
+	{
+		Download,
+		Filter,
+		Upload
+	};
+
 	void		switchToSingleThreaded();
 
 	void		switchToMultiThreaded();
 
 	TOP_Context* myContext;
-	OP_SmartRef<OP_TOPDownloadResult> myPrevDownRes;
+	// The download the current frame came from
+	OP_SmartRef<OP_TOPDownloadResult> myFrameDownRes;
+	DownloadQueue					myDownloads;
 
 	// Threading variables
 	std::array<ThreadManager*, NumCPUPixelDatas>	myThreadManagers;
 	std::queue<ThreadManager*>						myThreadQueue;
 	int												myExecuteCount;
 	bool											myMultiThreaded;
+
+	// Splits a single frame when Multithreaded is off
+	WorkerPool										myWorkerPool;
+	// Buffers reused between cooks when Multithreaded is off, each ThreadManager has its own
+	Filter::Scratch									myScratch;
+
+	CookStats										myCookStats;
 };
 
 #endif
@@ -0,0 +1,283 @@
+#ifndef __BlueNoiseRanks__
+#define __BlueNoiseRanks__
+
+#include <cstdint>
+
+/*
+Rank of every pixel of the 64x64 blue noise mask used by OrderedDither, row by row. Each
+rank from 0 to 4095 appears once, a pixel is on in the first n ranks out of 4096 for a level
+of n / 4096.
+
+The mask is a void-and-cluster pattern (Ulichney 1993). The density is measured with a
+gaussian of sigma 1.5 pixels and radius 7 that wraps around the edges, so the mask tiles. A
+tenth of the pixels, picked with the LCG seed * 1664525 + 1013904223 from seed 1, are moved
+from their tightest cluster to the largest void until none moves. They are then ranked down
+by removing the tightest cluster, and the remaining pixels ranked up by filling the largest
+void. It is generated offline so no cook has to build it.
+*/
+namespace Filter
+{
+	const int		BlueNoiseSize = 64;
+
+	const uint16_t	BlueNoiseRanks[BlueNoiseSize * BlueNoiseSize] =
+	{
+		1281, 797, 170, 3953, 2327, 383, 2138, 4087, 2844, 475, 1655, 31, 3476, 4024, 2021, 3297,
+		1729, 2508, 3622, 1378, 4054, 578, 3030, 2603, 2042, 1652, 2710, 1489, 2435, 225, 2955, 1540,
+		2225, 1344, 2816, 2556, 80, 1985, 3715, 3351, 2885, 1949, 165, 1735, 4044, 1025, 3241, 146,
+		2309, 837, 3251, 2480, 3773, 1412, 3396, 1684, 672, 2132, 4014, 1722, 3373, 869, 2754, 3753,
+		3294, 2275, 2956, 1343, 897, 3689, 695, 1121, 3363, 829, 3803, 2892, 1898, 1190, 2645, 540,
+		3916, 75, 2964, 370, 2652, 997, 1551, 297, 3466, 3814, 482, 913, 3339, 1244, 2590, 3943,
+		736, 3683, 951, 1676, 3931, 830, 1301, 2231, 619, 1492, 3529, 2297, 2876, 366, 2516, 3748,
+		1260, 2814, 435, 1137, 1831, 44, 2277, 2926, 2578, 173, 984, 2824, 522, 3657, 1884, 230,
+		1607, 3811, 526, 1948, 3244, 1697, 3007, 2637, 1804, 2304, 1286, 2513, 955, 274, 3077, 1434,
+		941, 2226, 1595, 3475, 2103, 3155, 3858, 2287, 656, 1164, 2950, 1927, 3884, 598, 1701, 335,
+		3182, 1909, 207, 3413, 2186, 3147, 319, 2540, 4009, 1050, 2697, 769, 1371, 3453, 1842, 679,
+		1563, 3934, 2017, 3560, 2654, 3186, 810, 1213, 3843, 1498, 3307, 2202, 1330, 2416, 1092, 2904,
+		2105, 1012, 2724, 3493, 275, 2462, 1403, 154, 3517, 360, 3168, 572, 3708, 2144, 3443, 2415,
+		3692, 3170, 1110, 663, 1796, 98, 1279, 2756, 1840, 3194, 2393, 27, 2159, 2801, 3520, 2061,
+		1118, 2377, 3001, 1426, 503, 2792, 1812, 3480, 36, 2070, 3167, 248, 3905, 2095, 1099, 3195,
+		2569, 97, 3074, 922, 535, 1574, 3679, 375, 1946, 3035, 720, 3788, 74, 3204, 4079, 674,
+		3589, 41, 1499, 2240, 1138, 3979, 618, 3734, 2087, 1487, 3986, 1779, 2978, 1561, 386, 742,
+		1939, 421, 2689, 3924, 2486, 3659, 843, 3318, 210, 1432, 3721, 1041, 3233, 1414, 874, 2512,
+		3738, 635, 4021, 2628, 1166, 3831, 973, 1573, 3008, 1292, 3729, 1719, 2485, 569, 2922, 334,
+		3575, 1717, 1319, 2400, 4007, 2803, 2119, 3449, 2473, 440, 1703, 2616, 1992, 1542, 376, 2639,
+		1811, 3088, 3900, 739, 2857, 1923, 3171, 1042, 2568, 857, 2721, 1112, 88, 2482, 4080, 1264,
+		2910, 1662, 3349, 1380, 401, 2934, 1623, 2203, 4038, 792, 2609, 1761, 518, 3796, 160, 3079,
+		1544, 301, 1765, 795, 2104, 3569, 371, 2369, 779, 2598, 451, 998, 3316, 1505, 3786, 2325,
+		866, 2148, 3442, 287, 1916, 1131, 200, 1404, 891, 4033, 1239, 3600, 942, 2963, 2280, 1221,
+		798, 2340, 466, 1727, 3574, 117, 2310, 1640, 3071, 261, 3404, 2271, 3596, 915, 3218, 2078,
+		3801, 23, 867, 1969, 2298, 1082, 3465, 539, 1892, 2968, 350, 3452, 2198, 2680, 1876, 1212,
+		3401, 2888, 2285, 3335, 114, 2714, 1919, 3299, 3972, 1846, 3563, 2129, 2846, 54, 1932, 1207,
+		4060, 501, 2624, 2977, 756, 3776, 3103, 2683, 3338, 2189, 2894, 258, 3393, 563, 3848, 3280,
+		2845, 1363, 3317, 2548, 969, 1386, 3439, 477, 3938, 1944, 622, 1410, 2883, 1830, 582, 2712,
+		1049, 2427, 3640, 3047, 3997, 236, 2622, 1243, 2471, 3611, 1565, 1183, 3020, 799, 4081, 567,
+		2019, 959, 3681, 1300, 1645, 3191, 1206, 528, 1448, 145, 3063, 725, 1340, 3446, 666, 2728,
+		3037, 1527, 1057, 3646, 1702, 2230, 568, 1620, 9, 1817, 682, 2420, 1918, 1108, 1616, 153,
+		1879, 3815, 216, 2107, 4065, 2985, 794, 2464, 1278, 2786, 3770, 2117, 184, 3903, 1567, 303,
+		3514, 1770, 494, 1334, 705, 1763, 3122, 3826, 125, 916, 2278, 3918, 71, 1646, 2426, 3510,
+		2770, 222, 2528, 552, 4000, 762, 2431, 3687, 2790, 2283, 1161, 3927, 2636, 2243, 3682, 1755,
+		313, 3329, 2072, 84, 1302, 3402, 2499, 3891, 1168, 3703, 3225, 1443, 3962, 2733, 2172, 3541,
+		2441, 669, 1188, 2778, 557, 1577, 2026, 3676, 17, 1714, 809, 3166, 1204, 2493, 3014, 2187,
+		1287, 3209, 2860, 2171, 2681, 3572, 817, 2057, 1425, 2881, 3311, 685, 2063, 3257, 1276, 385,
+		1521, 3798, 1823, 3067, 2133, 2854, 268, 2018, 904, 3407, 1781, 276, 1590, 481, 1033, 2510,
+		3800, 816, 2402, 3982, 2781, 406, 953, 2016, 2834, 356, 2614, 882, 191, 3140, 505, 952,
+		1512, 3160, 3494, 1708, 3732, 171, 2635, 3110, 1035, 3364, 2434, 392, 3698, 896, 3431, 714,
+		4017, 194, 986, 3868, 94, 1519, 2375, 495, 3432, 1855, 341, 2709, 1075, 3697, 2945, 868,
+		2173, 3179, 1142, 2, 1486, 1016, 3835, 1671, 3135, 588, 2467, 3544, 2936, 3281, 2088, 159,
+		1349, 1687, 3109, 676, 1872, 3242, 1488, 3506, 734, 1586, 2074, 3613, 2349, 1306, 3722, 2809,
+		3990, 327, 1979, 838, 2382, 3269, 1336, 610, 1870, 3885, 1367, 2817, 1926, 1497, 340, 1863,
+		2664, 2392, 1658, 1981, 3366, 1133, 3082, 4066, 2615, 1199, 3767, 1571, 2364, 202, 1705, 2607,
+		3976, 612, 2404, 3638, 3368, 2475, 3021, 1341, 109, 4088, 1069, 2000, 776, 1311, 4015, 2895,
+		3533, 2687, 374, 1194, 3619, 2562, 140, 2247, 3945, 3050, 1072, 3288, 606, 1679, 2045, 32,
+		2228, 1251, 2641, 3029, 1136, 381, 4011, 2314, 2935, 280, 2227, 591, 3275, 2352, 2870, 3779,
+		1392, 848, 3695, 564, 2891, 347, 1713, 928, 176, 2244, 791, 2911, 3936, 648, 3532, 1935,
+		150, 1415, 2821, 884, 1795, 650, 357, 3524, 2152, 2613, 1524, 3750, 16, 2653, 1783, 524,
+		887, 2044, 3872, 2295, 1621, 860, 2982, 1224, 490, 2509, 91, 1856, 4048, 2669, 1056, 3066,
+		1647, 706, 3873, 479, 3587, 2109, 1663, 3454, 793, 1564, 3592, 956, 4059, 83, 1126, 3348,
+		417, 3174, 2735, 1245, 2419, 3839, 2064, 2793, 3654, 1785, 3196, 420, 1998, 1373, 3042, 980,
+		3314, 3686, 2015, 407, 4031, 2214, 2744, 1749, 737, 2947, 432, 3164, 2273, 3461, 1140, 2339,
+		3057, 1375, 56, 3176, 515, 4022, 1959, 3398, 1677, 3757, 1362, 2907, 344, 3400, 750, 3634,
+		2853, 3412, 2301, 1858, 1396, 2879, 917, 206, 2659, 1978, 3055, 1304, 2644, 1745, 2126, 686,
+		1643, 2191, 8, 3503, 1556, 677, 3260, 1374, 581, 2533, 1463, 3403, 1103, 2700, 2195, 491,
+		1585, 2321, 1093, 2974, 1314, 3313, 992, 3895, 1211, 3635, 1841, 945, 1394, 576, 3852, 232,
+		3428, 1836, 3642, 2586, 1122, 2797, 323, 2345, 698, 3189, 2084, 920, 2256, 1536, 2492, 438,
+		1335, 224, 1028, 3156, 46, 2470, 3761, 3203, 1129, 3937, 161, 2329, 489, 3802, 2917, 3588,
+		2601, 3907, 1864, 935, 3065, 2259, 135, 3526, 1010, 4003, 73, 2317, 3620, 237, 4074, 3149,
+		2597, 726, 3841, 233, 2541, 1613, 127, 3060, 2291, 277, 2519, 3996, 2807, 2082, 3134, 1557,
+		2738, 1034, 712, 2140, 1704, 3320, 1450, 3678, 1094, 2720, 235, 3834, 3132, 1151, 3928, 1957,
+		2599, 3726, 1740, 2693, 3989, 603, 1296, 1899, 2380, 649, 3542, 1657, 3175, 819, 1442, 189,
+		1017, 1328, 2941, 314, 3991, 1102, 2656, 1880, 2921, 2100, 3075, 907, 1807, 711, 1648, 1165,
+		43, 3434, 1808, 3185, 2093, 3552, 616, 1971, 3471, 1504, 702, 3359, 172, 1692, 774, 2479,
+		422, 4075, 2975, 198, 3829, 890, 2494, 5, 1806, 3473, 1477, 2574, 520, 1777, 148, 3096,
+		2145, 553, 3266, 849, 1576, 2210, 3608, 326, 2971, 1481, 2780, 2118, 1115, 3483, 1938, 2476,
+		3305, 565, 3671, 2378, 2006, 1632, 3758, 290, 1522, 533, 1303, 3719, 2776, 3310, 2418, 3752,
+		2080, 2742, 1254, 486, 885, 3809, 1357, 2716, 972, 2914, 1931, 1130, 2323, 3805, 1271, 3601,
+		1962, 1458, 2276, 1231, 3126, 562, 2047, 3876, 3006, 446, 1990, 826, 3661, 2303, 3511, 777,
+		4037, 1248, 2373, 398, 3380, 1045, 2719, 1742, 3409, 983, 377, 3849, 37, 2711, 465, 3985,
+		2222, 1510, 2731, 856, 425, 3331, 741, 3106, 2354, 3898, 2579, 262, 2036, 1387, 312, 2979,
+		831, 1532, 3971, 2338, 2867, 1747, 2422, 394, 3870, 42, 3623, 3054, 493, 3302, 2672, 59,
+		3161, 614, 3433, 2773, 1891, 3578, 2640, 1321, 727, 2308, 4082, 3239, 1352, 2868, 1055, 1601,
+		61, 1859, 2848, 3879, 1989, 3028, 107, 781, 4076, 2033, 3284, 1385, 2296, 3094, 1610, 760,
+		3015, 229, 1792, 3468, 2893, 1407, 2190, 1163, 3415, 855, 1751, 3208, 594, 3946, 1018, 1861,
+		3631, 269, 3136, 1036, 85, 3382, 758, 3213, 2176, 1686, 2584, 1381, 2102, 905, 1834, 1148,
+		2388, 3865, 932, 382, 1518, 149, 970, 3259, 1680, 2828, 1061, 89, 1917, 355, 2625, 3353,
+		3049, 3670, 930, 259, 1315, 2456, 3769, 1459, 2330, 430, 2642, 1838, 879, 3693, 1202, 3505,
+		2046, 1003, 3866, 1227, 2440, 4083, 358, 2802, 1955, 45, 3593, 1193, 2468, 2877, 3490, 2241,
+		611, 2496, 1769, 3667, 2167, 1507, 4004, 1261, 2850, 1048, 659, 4055, 296, 2799, 3915, 538,
+		2948, 1660, 2075, 2596, 3812, 3046, 2262, 3957, 243, 3550, 1456, 2477, 3080, 3929, 668, 2237,
+		419, 1483, 2668, 1752, 3557, 620, 1881, 3183, 1128, 2937, 688, 3947, 286, 2487, 1905, 132,
+		2678, 3198, 2260, 644, 86, 1829, 3227, 655, 3846, 1366, 2961, 2150, 881, 1669, 388, 1441,
+		3334, 2820, 1347, 703, 3031, 2626, 226, 2037, 497, 3731, 2368, 3165, 1624, 3460, 2255, 1438,
+		3624, 307, 1189, 3507, 787, 1787, 1265, 577, 2027, 2582, 629, 3799, 947, 1559, 1974, 1184,
+		2437, 3472, 573, 2220, 3226, 1007, 2763, 251, 3690, 1668, 3504, 1326, 2823, 3309, 625, 4030,
+		1447, 445, 3618, 1569, 3385, 2713, 1080, 1666, 2381, 2675, 487, 4020, 209, 3237, 2670, 3881,
+		1081, 156, 4089, 1984, 380, 1154, 3562, 3115, 1549, 3429, 204, 1896, 752, 1114, 136, 3268,
+		877, 2748, 2272, 3211, 459, 2495, 2869, 3427, 1086, 3143, 1734, 2178, 462, 3410, 2899, 3749,
+		1712, 1070, 2970, 3973, 35, 1566, 3857, 2164, 842, 2524, 65, 2232, 948, 1543, 2160, 2984,
+		840, 2500, 1936, 3044, 814, 2154, 3745, 244, 3556, 770, 1547, 3383, 1901, 1257, 2185, 780,
+		1867, 2371, 3177, 971, 3771, 2448, 1801, 841, 2753, 2216, 1308, 2952, 2608, 3762, 2001, 2521,
+		1753, 3932, 47, 1903, 1484, 3920, 120, 1639, 3741, 346, 2760, 3606, 1293, 2341, 217, 804,
+		3264, 168, 1908, 1268, 2532, 2050, 531, 3127, 1433, 3358, 1933, 3005, 3890, 354, 3521, 1160,
+		1736, 3807, 263, 1064, 3958, 456, 2527, 1290, 1988, 3089, 2251, 1047, 2832, 3817, 1, 3500,
+		2958, 1464, 547, 2729, 3322, 1418, 523, 3948, 55, 1023, 3856, 426, 3345, 1517, 596, 3017,
+		1237, 723, 2932, 3567, 1020, 3111, 2211, 730, 2347, 1390, 927, 103, 3188, 1803, 2676, 4067,
+		2142, 2600, 3660, 748, 2913, 3485, 1214, 2686, 362, 3825, 1149, 527, 1754, 2692, 2401, 78,
+		3235, 2701, 1316, 2839, 2014, 1523, 2933, 3406, 924, 102, 3751, 410, 2379, 675, 1698, 2520,
+		409, 3714, 2083, 1690, 130, 2289, 2983, 1943, 2507, 3215, 1741, 2122, 936, 2385, 4029, 242,
+		3649, 2209, 1372, 2553, 605, 1994, 1223, 2794, 3201, 4042, 1986, 2946, 3863, 1095, 617, 1451,
+		946, 506, 3101, 1634, 345, 893, 4052, 1750, 2248, 782, 2491, 3254, 3599, 1331, 701, 3713,
+		2038, 548, 2266, 3441, 30, 3229, 667, 1788, 4050, 2767, 1631, 3328, 1398, 3630, 3033, 925,
+		1272, 3245, 847, 3913, 1177, 3602, 950, 3459, 1273, 502, 2813, 3662, 95, 1275, 2788, 1941,
+		3258, 458, 1710, 4006, 164, 3300, 3830, 278, 1798, 513, 2592, 1535, 427, 2194, 3597, 2836,
+		3883, 1384, 2279, 3783, 1975, 2417, 3062, 90, 3590, 2927, 1592, 139, 906, 2124, 3013, 1538,
+		979, 4058, 1596, 789, 3709, 1197, 2245, 333, 2465, 1109, 2147, 745, 2698, 272, 2024, 4039,
+		2284, 2787, 331, 2591, 2168, 636, 2662, 305, 1608, 4068, 749, 1485, 3139, 3553, 1670, 800,
+		1132, 2363, 3032, 954, 2741, 1446, 2446, 910, 3455, 1191, 3648, 853, 2488, 3371, 13, 1940,
+		369, 3447, 1074, 175, 3292, 1494, 1159, 694, 2012, 1267, 3902, 1912, 2822, 3978, 218, 3425,
+		2755, 283, 3068, 2511, 1849, 2671, 3819, 1462, 3548, 511, 3009, 3939, 1791, 1096, 3389, 1478,
+		99, 1848, 3445, 1511, 3118, 1732, 3742, 2053, 3271, 2389, 1925, 2563, 332, 2250, 516, 3367,
+		2621, 3733, 321, 3528, 1845, 713, 3685, 1619, 2139, 2726, 179, 2040, 3038, 1246, 1609, 3145,
+		2450, 1659, 2900, 2588, 583, 3847, 2761, 3417, 2474, 395, 3200, 642, 2366, 1105, 1771, 2459,
+		1269, 1924, 3584, 499, 1038, 174, 2962, 872, 3206, 1980, 1333, 53, 3224, 2594, 546, 2884,
+		785, 3772, 1089, 496, 4023, 26, 1238, 3010, 912, 141, 1141, 3810, 2997, 1031, 3983, 1999,
+		15, 1500, 2113, 1201, 2324, 3092, 193, 2944, 570, 3262, 3842, 1674, 507, 4016, 2650, 862,
+		2009, 641, 4034, 2112, 957, 1860, 205, 1630, 3756, 1060, 2688, 1513, 3711, 455, 3323, 608,
+		3792, 870, 2288, 1454, 3955, 3308, 2121, 1667, 231, 2737, 3723, 2348, 858, 2092, 3882, 1694,
+		2458, 3011, 1995, 2396, 864, 2864, 2478, 559, 3875, 2782, 3435, 1435, 683, 1758, 2764, 1232,
+		2940, 3919, 651, 3354, 478, 4056, 1934, 1299, 2293, 985, 1399, 2370, 3451, 1040, 197, 3730,
+		1162, 3378, 77, 1325, 3579, 3178, 2333, 854, 3070, 2183, 178, 3405, 2029, 3041, 1382, 2135,
+		2943, 134, 3221, 2775, 1972, 1263, 543, 2504, 3994, 1062, 595, 1650, 3576, 1359, 342, 3477,
+		1256, 203, 3276, 1395, 3516, 1833, 3644, 1422, 1768, 2213, 423, 1967, 3645, 2409, 361, 3581,
+		845, 1825, 2483, 2847, 1598, 1083, 2534, 3509, 3912, 49, 3058, 693, 2825, 1883, 2261, 2993,
+		1546, 2550, 3069, 1696, 2808, 408, 3975, 1419, 492, 1813, 4069, 1297, 926, 10, 2651, 3999,
+		1022, 1649, 3530, 351, 766, 3744, 2851, 3496, 1370, 1947, 3341, 2989, 169, 2552, 3073, 989,
+		2233, 3951, 670, 2752, 322, 1054, 2282, 188, 3319, 1006, 3142, 2606, 105, 3255, 1589, 2165,
+		3187, 270, 1327, 3705, 112, 3277, 788, 439, 1726, 2610, 1968, 3759, 299, 1274, 3337, 467,
+		828, 3650, 368, 2221, 757, 1220, 2043, 2679, 3350, 2444, 704, 2849, 2337, 3675, 1602, 397,
+		2497, 2081, 1210, 2589, 1731, 2229, 38, 815, 2322, 295, 2627, 923, 2032, 3795, 1738, 510,
+		2800, 1894, 1591, 3699, 2034, 3098, 719, 3970, 2557, 587, 1313, 4027, 790, 1176, 3820, 534,
+		2559, 3522, 909, 2217, 1766, 2739, 2069, 3019, 1170, 3304, 833, 1541, 3535, 2539, 1724, 3984,
+		2376, 1921, 1011, 3935, 2469, 3133, 3598, 51, 982, 3780, 1651, 3238, 463, 1889, 3437, 778,
+		3093, 3658, 613, 4070, 3173, 1024, 3377, 1816, 2930, 3666, 1539, 4072, 1228, 715, 2384, 3212,
+		3655, 852, 68, 2518, 1236, 3424, 2660, 1475, 1987, 3701, 1723, 2267, 2976, 1937, 2723, 991,
+		1530, 1945, 2909, 3853, 352, 3489, 1413, 3806, 256, 2212, 4010, 461, 2106, 943, 144, 2840,
+		585, 3207, 1455, 3392, 246, 1744, 647, 1550, 2998, 1255, 192, 2131, 3897, 1027, 2765, 1322,
+		1852, 82, 2856, 1520, 285, 2410, 1439, 3940, 1152, 673, 2181, 413, 2882, 3482, 1493, 304,
+		1205, 2169, 3117, 4095, 483, 1730, 279, 892, 3043, 40, 2777, 402, 1472, 3491, 195, 3129,
+		4077, 69, 654, 1249, 2517, 1002, 571, 2365, 1614, 2818, 1079, 3095, 2674, 3252, 3614, 1247,
+		3854, 0, 2779, 2035, 1172, 2929, 3887, 1970, 2331, 3647, 2634, 633, 1436, 2390, 219, 3332,
+		3859, 2342, 873, 1977, 3586, 2999, 476, 2661, 187, 3113, 3421, 1773, 2560, 22, 2090, 3917,
+		2649, 3545, 1466, 999, 2395, 2835, 3855, 3499, 2307, 1192, 3566, 919, 3894, 623, 2430, 1320,
+		2086, 2690, 3395, 3108, 1706, 3950, 2928, 3344, 689, 3580, 116, 1695, 1318, 627, 1810, 2207,
+		1514, 2571, 743, 3782, 514, 2525, 949, 3487, 404, 806, 1809, 2905, 3536, 3104, 1965, 661,
+		1665, 1139, 3246, 2576, 1250, 665, 2099, 3775, 1893, 2484, 1270, 844, 3777, 3090, 1058, 1681,
+		732, 405, 1913, 2972, 692, 2060, 1097, 1594, 545, 1871, 3157, 2543, 2110, 3291, 1793, 773,
+		3564, 1039, 1579, 2270, 471, 2076, 21, 1851, 1338, 2530, 2028, 3724, 2411, 3964, 266, 3004,
+		908, 1874, 3582, 1305, 3265, 2157, 128, 2717, 1465, 3099, 4013, 1195, 353, 901, 3969, 2531,
+		2875, 470, 3718, 199, 3960, 1641, 3301, 934, 1531, 3573, 306, 2265, 1424, 550, 2398, 3321,
+		2886, 2236, 3430, 234, 3797, 3162, 157, 3326, 2461, 4051, 215, 1635, 1127, 330, 2931, 3793,
+		429, 2490, 227, 3498, 899, 3669, 1167, 2750, 4090, 939, 3387, 444, 825, 2783, 1157, 3525,
+		315, 3138, 2315, 190, 1537, 4061, 1764, 1174, 3357, 2180, 57, 2502, 1715, 2201, 1473, 142,
+		3502, 1365, 2219, 1815, 1001, 2766, 2358, 64, 3016, 700, 4028, 2830, 3365, 1958, 3974, 186,
+		1350, 3754, 1065, 1588, 2316, 1288, 1826, 2805, 846, 1355, 2953, 658, 3838, 2658, 1379, 2294,
+		1689, 3000, 4001, 1400, 2811, 2353, 3273, 541, 2166, 238, 2902, 1515, 1857, 3295, 2114, 2515,
+		4025, 1625, 965, 2667, 3085, 680, 2859, 3684, 589, 1862, 987, 3794, 2791, 3256, 3700, 823,
+		1895, 3130, 735, 2981, 3440, 393, 3706, 1332, 2629, 2073, 1111, 1757, 111, 1015, 2694, 802,
+		1853, 2587, 607, 3267, 2725, 751, 3941, 434, 3636, 2096, 3394, 2362, 1824, 3467, 4, 918,
+		3342, 1145, 2051, 709, 1822, 257, 1509, 3808, 1720, 3214, 1144, 2350, 3909, 70, 1453, 681,
+		2003, 3408, 529, 3836, 1885, 1066, 2292, 309, 2454, 2967, 3419, 1383, 653, 390, 1179, 2715,
+		2332, 4045, 29, 2505, 1408, 2115, 637, 1869, 3518, 3124, 460, 2554, 3712, 3045, 1582, 3585,
+		3120, 339, 4043, 1997, 101, 3501, 2199, 2619, 1171, 118, 1558, 993, 472, 3064, 2123, 3908,
+		575, 2749, 108, 3216, 3710, 2994, 1005, 2545, 786, 2677, 3651, 632, 3052, 1043, 3594, 2880,
+		1113, 2769, 1377, 2141, 228, 3388, 1502, 3845, 889, 1578, 250, 2326, 3559, 2030, 3153, 1583,
+		519, 1051, 1675, 3763, 880, 2908, 3981, 1044, 239, 1606, 3896, 1317, 657, 2320, 264, 2127,
+		1101, 2372, 1636, 1180, 3023, 1491, 938, 1721, 3234, 2838, 3980, 2581, 3696, 1175, 1529, 2542,
+		1778, 3540, 2239, 1225, 2443, 500, 2010, 3515, 104, 1354, 1942, 316, 2182, 2537, 1762, 452,
+		2334, 113, 3114, 3604, 2561, 621, 3022, 1993, 3285, 2638, 4036, 807, 1693, 2575, 196, 3774,
+		2872, 3486, 2022, 3261, 348, 1626, 2252, 3219, 2463, 850, 2163, 3289, 1839, 3444, 1429, 3878,
+		626, 3327, 2704, 728, 3828, 2506, 288, 3880, 592, 1961, 808, 325, 2058, 2874, 717, 3272,
+		294, 1409, 3871, 784, 1672, 4035, 1393, 3144, 2193, 3942, 3325, 1575, 3789, 747, 3152, 3869,
+		3457, 1800, 678, 1087, 1682, 3998, 1298, 25, 1153, 530, 2101, 3051, 1229, 3906, 929, 2208,
+		1342, 273, 2397, 1215, 2684, 3610, 138, 1361, 3765, 2747, 337, 2873, 996, 415, 2602, 2920,
+		1877, 28, 3641, 2089, 473, 3411, 1890, 2897, 1339, 2406, 3336, 1683, 3570, 133, 4084, 1067,
+		2162, 3072, 433, 2604, 3375, 336, 2757, 696, 1182, 468, 2743, 994, 2898, 1323, 221, 1506,
+		875, 2707, 3821, 2429, 302, 2866, 2224, 2751, 3785, 1772, 3384, 129, 2819, 544, 3362, 1835,
+		3228, 836, 3933, 537, 3105, 824, 1907, 2861, 593, 1728, 1219, 3607, 2423, 4062, 827, 1217,
+		3768, 1501, 977, 2939, 1364, 2274, 1053, 3577, 48, 3737, 1026, 2784, 1307, 2367, 1868, 2718,
+		3760, 894, 1904, 2938, 1106, 2290, 1843, 3823, 2949, 2387, 1767, 52, 2023, 3565, 2646, 2174,
+		400, 3232, 1461, 2056, 3479, 944, 3625, 721, 1470, 2413, 1008, 3629, 1963, 1555, 2421, 79,
+		2798, 1654, 2585, 1964, 1474, 2312, 4053, 1084, 3361, 2068, 3148, 63, 1581, 2008, 3184, 220,
+		2158, 2522, 3274, 1799, 152, 3210, 759, 2549, 1533, 2156, 389, 3158, 664, 3356, 488, 1605,
+		177, 2425, 3458, 1482, 24, 3677, 940, 260, 1525, 3637, 718, 3987, 3303, 586, 1071, 4091,
+		1952, 1235, 58, 2992, 558, 1597, 1902, 364, 3250, 2990, 457, 1391, 2630, 3740, 1078, 4092,
+		615, 3456, 1090, 3766, 50, 3495, 508, 2439, 201, 3840, 796, 2269, 3717, 579, 1388, 3534,
+		2889, 387, 746, 3674, 2657, 3963, 1746, 3024, 584, 4040, 2617, 1617, 2039, 3694, 1158, 2919,
+		3248, 1282, 554, 3952, 2052, 3078, 2580, 3263, 2136, 1123, 3083, 2501, 1421, 2318, 1644, 2915,
+		671, 3438, 2281, 3954, 1117, 3352, 2451, 4063, 2062, 863, 3889, 2258, 241, 744, 3102, 2020,
+		1420, 2263, 308, 3202, 2812, 1277, 1786, 3081, 1545, 2631, 1353, 2973, 1077, 2785, 2466, 1733,
+		962, 4019, 2286, 1173, 561, 1437, 293, 3513, 1928, 1230, 3279, 900, 76, 2558, 3956, 771,
+		2130, 3627, 1774, 2759, 767, 1240, 1691, 590, 3464, 158, 1956, 967, 396, 3190, 162, 3603,
+		1471, 2595, 883, 1832, 2685, 252, 2906, 1258, 106, 2648, 1818, 2916, 3436, 1310, 2734, 359,
+		3663, 3002, 768, 1756, 2460, 898, 2151, 3899, 687, 3470, 418, 1819, 3340, 155, 3867, 504,
+		2055, 1411, 3414, 1910, 3107, 2442, 2143, 1076, 2833, 208, 3665, 2184, 3003, 1401, 1850, 267,
+		2632, 1019, 143, 2374, 3312, 349, 4085, 2336, 1348, 2643, 3888, 2855, 1814, 3837, 2702, 2128,
+		3790, 3128, 298, 3707, 1427, 2177, 832, 3538, 1568, 3743, 1150, 631, 1678, 2188, 3555, 961,
+		1847, 2593, 1234, 4012, 436, 3315, 253, 2829, 1116, 2007, 2407, 3995, 724, 2200, 1295, 3247,
+		2959, 110, 2768, 338, 3818, 803, 3287, 3921, 731, 2319, 1725, 600, 3463, 1004, 2344, 3527,
+		1553, 3844, 3026, 1397, 3668, 2155, 2862, 886, 3702, 412, 1526, 684, 3397, 1259, 871, 469,
+		1100, 1748, 2328, 639, 3418, 3091, 1790, 521, 3151, 2399, 367, 3053, 4018, 14, 2436, 1508,
+		3893, 121, 3391, 2066, 1496, 3612, 2547, 1406, 3704, 19, 3061, 1009, 1584, 2730, 3616, 851,
+		2391, 3791, 1653, 988, 2647, 1716, 7, 1490, 2567, 3141, 1368, 3910, 2682, 391, 3205, 691,
+		2871, 424, 2013, 634, 1052, 1580, 66, 1821, 3034, 2049, 3159, 2242, 6, 2544, 1915, 2986,
+		119, 4046, 1351, 2804, 1063, 20, 3965, 2745, 1982, 964, 3423, 2137, 1233, 820, 3324, 542,
+		2865, 902, 2335, 609, 3056, 1014, 1897, 532, 3236, 1637, 2696, 320, 3492, 1973, 255, 1780,
+		1208, 525, 3333, 2299, 1262, 2988, 3626, 1954, 453, 3747, 975, 147, 1991, 1600, 3993, 1929,
+		1216, 2311, 3369, 3914, 2623, 3192, 3531, 2481, 630, 1178, 3595, 921, 3977, 1428, 3691, 2204,
+		3360, 2457, 449, 3554, 2077, 2546, 1476, 1185, 3656, 137, 1528, 2572, 1828, 3781, 2699, 2011,
+		3199, 1345, 1802, 3827, 2736, 131, 3967, 2361, 761, 2116, 3911, 1376, 3137, 640, 4086, 2489,
+		3181, 2031, 755, 3988, 399, 2111, 652, 2727, 1252, 2149, 2796, 3346, 2428, 1107, 2774, 3,
+		3764, 801, 1661, 166, 1906, 480, 966, 1468, 4008, 254, 2612, 1688, 2887, 311, 3217, 722,
+		1209, 1873, 2969, 1587, 834, 3728, 403, 2355, 753, 2858, 3901, 560, 3119, 291, 1046, 1642,
+		183, 3558, 2503, 324, 1203, 2215, 1562, 3018, 3561, 1155, 474, 2535, 2170, 1088, 2923, 1440,
+		62, 3568, 2837, 1389, 3116, 3448, 1098, 4093, 3220, 292, 1709, 733, 3725, 437, 3146, 1445,
+		2472, 3197, 2810, 1358, 2351, 2942, 3673, 2134, 2795, 3330, 1966, 517, 2313, 1013, 1638, 2665,
+		3633, 895, 3923, 212, 3223, 1775, 2925, 3355, 1865, 2254, 1073, 3549, 1416, 2161, 3469, 2405,
+		4078, 740, 2995, 1618, 3240, 3519, 888, 372, 2566, 1739, 3298, 835, 3832, 1707, 428, 3736,
+		2618, 1021, 1718, 223, 2356, 1612, 124, 1827, 2433, 937, 3617, 2912, 1324, 2196, 914, 3523,
+		2048, 343, 1091, 4049, 3386, 764, 1266, 115, 1656, 811, 1360, 3822, 3027, 3450, 2079, 378,
+		1460, 2120, 604, 2673, 2223, 1143, 662, 4094, 289, 3076, 1699, 163, 2758, 775, 2965, 498,
+		1291, 2098, 1029, 3735, 624, 1875, 2826, 1346, 3778, 151, 1953, 2789, 247, 2360, 3420, 1930,
+		628, 2234, 3860, 2695, 839, 3787, 2896, 763, 3484, 1479, 2264, 87, 1888, 4041, 2573, 597,
+		1760, 3688, 707, 2179, 240, 1805, 2655, 3886, 3150, 2447, 3537, 181, 1226, 660, 4002, 2831,
+		3121, 2526, 3379, 1356, 3816, 96, 2555, 1599, 1253, 812, 3376, 2432, 4005, 1887, 3664, 1570,
+		3343, 2842, 379, 2268, 2633, 72, 4047, 2071, 699, 2991, 3497, 1200, 3653, 1423, 903, 2890,
+		1280, 3131, 442, 1976, 3253, 1294, 2067, 2620, 450, 3100, 3877, 643, 3270, 1554, 211, 3048,
+		1283, 2732, 3306, 1611, 3012, 3727, 2257, 384, 1125, 601, 2041, 2706, 1593, 2498, 1844, 93,
+		3851, 448, 1030, 1914, 2827, 3296, 2065, 3508, 2771, 3755, 1996, 602, 1309, 365, 1085, 2551,
+		33, 1743, 3892, 1369, 3154, 1119, 1622, 3372, 2302, 981, 1560, 2205, 599, 3040, 2538, 182,
+		3966, 1603, 3488, 1146, 574, 3591, 329, 3925, 1032, 1920, 1285, 2523, 990, 2772, 3551, 2238,
+		3922, 67, 2452, 1181, 509, 931, 1457, 3474, 2957, 1789, 4064, 3172, 447, 3716, 861, 1186,
+		2025, 1627, 3512, 317, 754, 1452, 958, 443, 2305, 60, 1503, 2663, 3290, 2306, 2918, 3949,
+		821, 2438, 3478, 697, 1951, 3643, 484, 2611, 281, 3874, 2703, 39, 3992, 1782, 3370, 2094,
+		783, 2343, 12, 2806, 2514, 1784, 3025, 1548, 2359, 2843, 271, 3720, 2125, 464, 1196, 690,
+		1685, 960, 2005, 3864, 2564, 3347, 1983, 716, 2414, 1337, 11, 995, 2218, 2852, 3282, 2346,
+		708, 3039, 2445, 4032, 2235, 3739, 2987, 1673, 3959, 1124, 2951, 3621, 933, 1711, 249, 1960,
+		3163, 1135, 2153, 167, 2954, 2453, 859, 3193, 1284, 1700, 3293, 805, 2449, 1068, 318, 1495,
+		3571, 2980, 1900, 3833, 1417, 865, 2197, 92, 3672, 710, 3381, 1664, 2996, 3961, 1911, 3286,
+		2901, 3583, 363, 3180, 1794, 100, 2863, 3904, 328, 3680, 2577, 3390, 1737, 1289, 245, 3652,
+		1467, 34, 1156, 2924, 1759, 213, 2424, 638, 3169, 1878, 310, 2097, 512, 3784, 3416, 1430,
+		485, 2691, 1629, 3804, 1059, 1480, 3944, 1882, 2903, 551, 2004, 3547, 1405, 3087, 3813, 2746,
+		1187, 454, 968, 3231, 282, 3426, 4057, 1134, 3222, 1444, 2059, 911, 18, 1402, 2412, 265,
+		2583, 1469, 2253, 813, 1312, 3628, 1615, 1147, 2175, 3123, 1516, 765, 3930, 580, 1922, 2666,
+		3926, 3230, 2054, 549, 974, 3462, 1242, 3609, 2605, 876, 3862, 1329, 3036, 2565, 1037, 2249,
+		3850, 3374, 300, 2815, 3283, 411, 2246, 81, 3746, 2383, 1104, 2841, 441, 2192, 645, 1866,
+		2455, 4026, 1633, 2091, 2408, 646, 2722, 1854, 2570, 373, 2403, 3639, 2705, 3422, 772, 3824,
+		1120, 536, 4071, 2740, 3084, 555, 2386, 2762, 878, 1886, 414, 2960, 2108, 3543, 3097, 978,
+		1797, 2536, 3539, 1552, 2708, 3125, 1837, 123, 1449, 2206, 3278, 2394, 738, 1572, 185, 2878,
+		729, 1218, 2002, 818, 2357, 1776, 3546, 1241, 822, 3249, 180, 4073, 1820, 3632, 1000, 3399,
+		122, 3112, 566, 3615, 1169, 3059, 1534, 416, 963, 3861, 3086, 1222, 556, 2146, 1604, 2966,
+		1950, 3481, 1628, 214, 2085, 976, 3968, 284, 3243, 3605, 1198, 2529, 126, 1431, 2300, 431
+	};
+}
+
+#endif // !__BlueNoiseRanks__
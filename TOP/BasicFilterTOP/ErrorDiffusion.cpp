@@ -0,0 +1,89 @@
+#include "ErrorDiffusion.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	// Floyd-Steinberg weights in sixteenths
+	const int32_t	Right = 7;
+	const int32_t	BelowBehind = 3;
+	const int32_t	Below = 5;
+	const int32_t	BelowAhead = 1;
+
+	// dir is 1 left to right and -1 right to left, x is the padded column
+	inline uint32_t
+		ditherPixel(uint32_t px, const int16_t* cur, int16_t* next, int x, int dir, uint32_t mask, int32_t carry[3])
+	{
+		uint32_t	outPx = px & 0xFF000000u;
+
+		for (int ch = 0; ch < 3; ++ch)
+		{
+			const int		shift = 8 * ch;
+			const int32_t	acc = cur[3 * x + ch] + carry[ch];
+			int32_t			v = static_cast<int32_t>((px >> shift) & 0xFF) + ((acc + 8) >> 4);
+			v = std::min(std::max(v, 0), 255);
+
+			const int32_t	q = v & static_cast<int32_t>((mask >> shift) & 0xFF);
+			const int32_t	e = v - q;
+			outPx |= static_cast<uint32_t>(q) << shift;
+
+			carry[ch] = Right * e;
+			next[3 * (x - dir) + ch] += static_cast<int16_t>(BelowBehind * e);
+			next[3 * x + ch] += static_cast<int16_t>(Below * e);
+			next[3 * (x + dir) + ch] += static_cast<int16_t>(BelowAhead * e);
+		}
+
+		return outPx;
+	}
+}
+
+Filter::ErrorDiffusion::ErrorDiffusion() :
+	myNumLines{ 0 }, myStride{ 0 }
+{
+}
+
+void
+Filter::ErrorDiffusion::setup(int width, int numLines)
+{
+	myNumLines = std::max(numLines, 2);
+	myStride = 3 * (static_cast<size_t>(width) + 2);
+	myLines.assign(myStride * myNumLines, 0);
+}
+
+void
+Filter::ErrorDiffusion::beginRow(int y)
+{
+	std::memset(line(y + 1), 0, myStride * sizeof(int16_t));
+}
+
+void
+Filter::ErrorDiffusion::ditherSpan(const uint32_t* inRow, uint32_t* outRow, int y, int begin, int end,
+									bool reverse, uint32_t mask, int32_t carry[3])
+{
+	const int16_t*	cur = line(y);
+	int16_t*		next = line(y + 1);
+
+	if (reverse)
+	{
+		for (int j = end - 1; j >= begin; --j)
+			outRow[j] = ditherPixel(inRow[j], cur, next, j + 1, -1, mask, carry);
+	}
+	else
+	{
+		for (int j = begin; j < end; ++j)
+			outRow[j] = ditherPixel(inRow[j], cur, next, j + 1, 1, mask, carry);
+	}
+}
+
+size_t
+Filter::ErrorDiffusion::getCapacity() const
+{
+	return myLines.capacity() * sizeof(int16_t);
+}
+
+int16_t*
+Filter::ErrorDiffusion::line(int y)
+{
+	return myLines.data() + static_cast<size_t>(y % myNumLines) * myStride;
+}
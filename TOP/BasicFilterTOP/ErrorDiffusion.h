@@ -0,0 +1,51 @@
+#ifndef __ErrorDiffusion__
+#define __ErrorDiffusion__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+Floyd-Steinberg error diffusion in fixed point. The error of each channel is kept in
+sixteenths in int16 line buffers instead of being added back to the image, so the input
+is never modified and no channel borrows from its neighbour.
+
+Row y reads the error diffused into it from line y and writes the error for the row below
+to line y + 1, lines are used round robin. A serial scan needs 2 lines; a wavefront with N
+rows in flight needs N + 1. The error going to the next pixel of the same row is carried
+by the caller between spans, so a row can be dithered in pieces.
+
+Error that would leave the image is dropped. The lines have a padding pixel on each side
+for it, so the inner loop does not test for borders.
+*/
+namespace Filter
+{
+	class ErrorDiffusion
+	{
+	public:
+		ErrorDiffusion();
+
+		// Sizes and clears the line buffers
+		void	setup(int width, int numLines);
+
+		// Clears the line row y diffuses into, call it before the first span of the row
+		void	beginRow(int y);
+
+		// Dithers pixels [begin, end) of row y, from right to left if reverse. carry is the
+		// error for the next pixel in scan order, zero it at the start of each row
+		void	ditherSpan(const uint32_t* inRow, uint32_t* outRow, int y, int begin, int end,
+						   bool reverse, uint32_t mask, int32_t carry[3]);
+
+		// Bytes reserved for the line buffers
+		size_t	getCapacity() const;
+
+	private:
+		int16_t*	line(int y);
+
+		std::vector<int16_t>	myLines;
+		int						myNumLines;
+		size_t					myStride;
+	};
+}
+
+#endif // !__ErrorDiffusion__
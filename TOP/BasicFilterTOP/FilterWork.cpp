@@ -1,111 +1,212 @@
 #include "FilterWork.h"
+#include "ErrorDiffusion.h"
+#include "Quantize.h"
+#include "WorkerPool.h"
 // #include "Parameters.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
 namespace
 {
+	// Splits rows [0, h) in one contiguous band per thread of pool and calls
+	// fn(begin, end) for each band, on the calling thread if there is no pool
+	template <class Fn>
 	void
-		diffuseError(uint32_t& pixel, uint32_t error, double coeff)
+		forEachBand(WorkerPool* pool, int h, const Fn& fn)
 	{
-		uint8_t*	pxChan = reinterpret_cast<uint8_t*>(&pixel);
-		uint8_t*	eChan = reinterpret_cast<uint8_t*>(&error);
-
-		for (int i = 0; i < 3; ++i)
+		const int	numBands = pool ? std::min(pool->getNumThreads(), h) : 1;
+		if (numBands <= 1)
 		{
-			double	temp = pxChan[i] + coeff * eChan[i];
-			if (temp > UINT8_MAX)
-				pxChan[i] = UINT8_MAX;
-			else
-				pxChan[i] = static_cast<uint8_t>(temp);
+			fn(0, h);
+			return;
 		}
+
+		pool->run(numBands, [&](int band)
+		{
+			fn(static_cast<int>(static_cast<int64_t>(h) * band / numBands),
+				static_cast<int>(static_cast<int64_t>(h) * (band + 1) / numBands));
+		});
 	}
 
-	// This returns a buffer of pixels which the user should delete[] when its done using it
+	// Returns the resized image, it lives in scratch until the next call
 	uint32_t*
-		resizeImage(uint32_t* inPixel, int inWidth, int inHeight, int outWidth, int outHeight)
+		resizeImage(const uint32_t* inPixel, int inWidth, int inHeight, int outWidth, int outHeight,
+					Filter::ResizeFilter filter, Filter::Scratch& scratch, WorkerPool* pool)
 	{
-		uint32_t* ret = new uint32_t[outWidth * outHeight];
-		double scaleY = inWidth / static_cast<double>(outWidth);
-		double scaleX = inHeight / static_cast<double>(outHeight);
+		uint32_t*				ret = scratch.pixels(static_cast<size_t>(outWidth) * outHeight);
+		std::vector<int32_t>&	columns = scratch.columns();
+		Filter::resampleColumns(filter, inWidth, outWidth, columns);
 
-		for (int y = 0; y < outHeight; ++y)
+		forEachBand(pool, outHeight, [&](int begin, int end)
 		{
-			for (int x = 0; x < outWidth; ++x)
-			{
-				int inY = static_cast<int>(y * scaleY);
-				int inX = static_cast<int>(x * scaleX);
-				ret[y * outWidth + x] = inPixel[inY * inWidth + inX];
-			}
-		}
+			Filter::resampleRows(inPixel, inWidth, inHeight, ret, outWidth, outHeight, filter, columns.data(), begin, end);
+		});
 		return ret;
 	}
 
-	uint32_t
-		closestPaletteColor(uint32_t color, int colorBits)
+	void
+		doDithering(const uint32_t* inPixel, uint32_t* outPixel, int w, int h, int colorBits, bool serpentine, Filter::Scratch& scratch)
 	{
-		uint8_t*	channels = reinterpret_cast<uint8_t*>(&color);
-		uint8_t		outChannels[4];
-		const int	shift = 8 - colorBits;
+		const uint32_t			mask = Filter::paletteMask(colorBits);
+		Filter::ErrorDiffusion&	diffusion = scratch.diffusion();
+		diffusion.setup(w, 2);
 
-		for (int i = 0; i < 3; ++i)
+		for (int i = 0; i < h; ++i)
 		{
-			outChannels[i] = (channels[i] >> shift) << shift;
+			int32_t	carry[3] = {};
+			diffusion.beginRow(i);
+			diffusion.ditherSpan(inPixel + static_cast<size_t>(i) * w, outPixel + static_cast<size_t>(i) * w,
+								 i, 0, w, serpentine && (i & 1), mask, carry);
 		}
-		outChannels[3] = channels[3];
-
-		return *reinterpret_cast<uint32_t*>(outChannels);
 	}
 
+	// Floyd-Steinberg on several threads with the same result as doDithering. Rows are
+	// dealt to the tasks in turn and row i only dithers up to two columns behind row i - 1:
+	// pixel j + 1 of the row above is the last one that diffuses into pixel j. Serpentine
+	// rows would depend on the whole row above, so this only scans left to right.
 	void
-		doDithering(uint32_t* inPixel, uint32_t* outPixel, int w, int h, int colorBits)
+		doDitheringWavefront(const uint32_t* inPixel, uint32_t* outPixel, int w, int h, int colorBits, Filter::Scratch& scratch, WorkerPool& pool)
 	{
+		// Publishing every pixel would keep the rows below busy reading the atomic
+		const int	ProgressStep = 32;
+
+		const uint32_t			mask = Filter::paletteMask(colorBits);
+		const int				numTasks = std::min(pool.getNumThreads(), h);
+		Filter::ErrorDiffusion&	diffusion = scratch.diffusion();
+		diffusion.setup(w, numTasks + 1);
+
+		std::atomic<int>*		progress = scratch.progress(h);
 		for (int i = 0; i < h; ++i)
+			progress[i].store(0, std::memory_order_relaxed);
+
+		pool.run(numTasks, [&](int task)
 		{
-			for (int j = 0; j < w; ++j)
+			for (int i = task; i < h; i += numTasks)
 			{
-				uint32_t	oldPx = inPixel[i * w + j];
-				uint32_t	newPx = closestPaletteColor(oldPx, colorBits);
-				uint32_t	error = oldPx - newPx;
-				outPixel[i * w + j] = newPx;
-
-				if (j != w - 1)
-					diffuseError(inPixel[i * w + j + 1], error, 7.0 / 16);
-				if (j != 0 && i != h - 1)
-					diffuseError(inPixel[(i + 1) * w + j - 1], error, 3.0 / 16);
-				if (i != h - 1)
-					diffuseError(inPixel[(i + 1) * w + 1], error, 5.0 / 16);
-				if (j != w - 1 && i != h - 1)
-					diffuseError(inPixel[(i + 1) * w + j + 1], error, 1.0 / 16);
+				const uint32_t*	inRow = inPixel + static_cast<size_t>(i) * w;
+				uint32_t*		outRow = outPixel + static_cast<size_t>(i) * w;
+				int32_t			carry[3] = {};
+				int				above = i == 0 ? w : progress[i - 1].load(std::memory_order_acquire);
+
+				diffusion.beginRow(i);
+				for (int begin = 0; begin < w; begin += ProgressStep)
+				{
+					const int end = std::min(begin + ProgressStep, w);
+					const int needed = std::min(end + 1, w);
+					while (above < needed)
+					{
+						std::this_thread::yield();
+						above = progress[i - 1].load(std::memory_order_acquire);
+					}
+
+					diffusion.ditherSpan(inRow, outRow, i, begin, end, false, mask, carry);
+					progress[i].store(end, std::memory_order_release);
+				}
 			}
-		}
+		});
 	}
 
 	void
-		limitColors(uint32_t* inPixel, uint32_t* outPixel, int w, int h, int colorBits)
+		limitColors(uint32_t* inPixel, uint32_t* outPixel, int w, int h, int colorBits, WorkerPool* pool)
 	{
-		for (int i = 0; i < w * h; ++i)
+		forEachBand(pool, h, [&](int begin, int end)
 		{
-			outPixel[i] = closestPaletteColor(inPixel[i], colorBits);
-		}
+			const size_t	first = static_cast<size_t>(begin) * w;
+			Filter::quantize(inPixel + first, outPixel + first, static_cast<size_t>(end - begin) * w, colorBits);
+		});
+	}
+
+	void
+		doOrderedDithering(uint32_t* inPixel, uint32_t* outPixel, int w, int h, int colorBits, Filter::DitherMode mode, Filter::Scratch& scratch, WorkerPool* pool)
+	{
+		// The table is only filled again when the mode or Bits per Color change
+		Filter::OrderedDither&	dither = scratch.ordered();
+		dither.setup(mode, colorBits);
+
+		forEachBand(pool, h, [&](int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				const size_t	first = static_cast<size_t>(i) * w;
+				Filter::quantizeOrdered(inPixel + first, outPixel + first, w, dither.row(i), colorBits);
+			}
+		});
 	}
 }
 
 
-void Filter::doFilterWork(uint32_t* inBuffer, int inWidth, int inHeight, uint32_t* outBuffer, int outWidth, int outHeight, bool doDither, int bitsPerColor)
+Filter::Scratch::Scratch() :
+	myProgressSize{ 0 }, myReported{ 0 }
 {
-	bool	needsResize = inHeight != outHeight || inWidth != outWidth;
+}
 
-	if (needsResize)
+uint32_t*
+Filter::Scratch::pixels(size_t count)
+{
+	if (myPixels.size() < count)
+		myPixels.resize(count);
+	return myPixels.data();
+}
+
+std::vector<int32_t>&
+Filter::Scratch::columns()
+{
+	return myColumns;
+}
+
+Filter::ErrorDiffusion&
+Filter::Scratch::diffusion()
+{
+	return myDiffusion;
+}
+
+Filter::OrderedDither&
+Filter::Scratch::ordered()
+{
+	return myOrdered;
+}
+
+std::atomic<int>*
+Filter::Scratch::progress(int count)
+{
+	if (myProgressSize < count)
 	{
-		inBuffer = resizeImage(inBuffer, inWidth, inHeight, outWidth, outHeight);
+		myProgress.reset(new std::atomic<int>[count]);
+		myProgressSize = count;
 	}
-	
-	if (doDither)
-		doDithering(inBuffer, outBuffer, outWidth, outHeight, bitsPerColor);
-	else
-		limitColors(inBuffer, outBuffer, outWidth, outHeight, bitsPerColor);
+	return myProgress.get();
+}
+
+size_t
+Filter::Scratch::getAllocated()
+{
+	const size_t	total = myPixels.capacity() * sizeof(uint32_t) + myColumns.capacity() * sizeof(int32_t) +
+		myDiffusion.getCapacity() + myOrdered.getCapacity() + static_cast<size_t>(myProgressSize) * sizeof(std::atomic<int>);
+	const size_t	allocated = total - myReported;
+	myReported = total;
+	return allocated;
+}
+
+void Filter::doFilterWork(uint32_t* inBuffer, int inWidth, int inHeight, uint32_t* outBuffer, int outWidth, int outHeight, const Settings& settings, Scratch& scratch, WorkerPool* pool)
+{
+	const int			bitsPerColor = settings.bitsPerColor;
+	const DitherMode	ditherMode = settings.ditherMode;
+	bool	needsResize = inHeight != outHeight || inWidth != outWidth;
 
 	if (needsResize)
 	{
-		delete[] inBuffer;
+		inBuffer = resizeImage(inBuffer, inWidth, inHeight, outWidth, outHeight, settings.resizeFilter, scratch, pool);
 	}
+	
+	if (settings.doDither && ditherMode != DitherMode::FloydSteinberg)
+		doOrderedDithering(inBuffer, outBuffer, outWidth, outHeight, bitsPerColor, ditherMode, scratch, pool);
+	else if (settings.doDither && !settings.serpentine && pool && pool->getNumThreads() > 1 && outHeight > 1)
+		doDitheringWavefront(inBuffer, outBuffer, outWidth, outHeight, bitsPerColor, scratch, *pool);
+	else if (settings.doDither)
+		doDithering(inBuffer, outBuffer, outWidth, outHeight, bitsPerColor, settings.serpentine, scratch);
+	else
+		limitColors(inBuffer, outBuffer, outWidth, outHeight, bitsPerColor, pool);
 }
@@ -1,14 +1,62 @@
 #ifndef __FilterWork__
 #define __FilterWork__
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ErrorDiffusion.h"
+#include "OrderedDither.h"
+#include "Resample.h"
 
 class OP_Inputs;
-class Parameters;
+class WorkerPool;
 
 namespace Filter
 {
-	void doFilterWork(uint32_t* inBuffer, int inWidth, int inHeight, uint32_t* outBuffer, int outWidth, int outHeight, bool doDither, int bitsPerColor);
+	struct Settings
+	{
+		bool			doDither = true;
+		DitherMode		ditherMode = DitherMode::FloydSteinberg;
+		// Only applies to Floyd-Steinberg, it alternates the scan direction every row and
+		// always runs on the calling thread
+		bool			serpentine = false;
+		int				bitsPerColor = 2;
+		ResizeFilter	resizeFilter = ResizeFilter::Nearest;
+	};
+
+	// Memory doFilterWork keeps between calls. It grows to the largest frame seen and is
+	// never shrunk, so cooking the same size again does not allocate. Use one per thread
+	// calling doFilterWork.
+	class Scratch
+	{
+	public:
+		Scratch();
+
+		// Room for count pixels, the contents are not kept between calls
+		uint32_t*			pixels(size_t count);
+		std::vector<int32_t>&	columns();
+		ErrorDiffusion&		diffusion();
+		OrderedDither&		ordered();
+		// count counters, the values are not kept between calls
+		std::atomic<int>*	progress(int count);
+
+		// Bytes allocated since the last call
+		size_t				getAllocated();
+
+	private:
+		std::vector<uint32_t>	myPixels;
+		std::vector<int32_t>	myColumns;
+		ErrorDiffusion			myDiffusion;
+		OrderedDither			myOrdered;
+		std::unique_ptr<std::atomic<int>[]>	myProgress;
+		int						myProgressSize;
+		size_t					myReported;
+	};
+
+	// If pool is not null the frame is split across its threads, the output is the same.
+	void doFilterWork(uint32_t* inBuffer, int inWidth, int inHeight, uint32_t* outBuffer, int outWidth, int outHeight, const Settings& settings, Scratch& scratch, WorkerPool* pool = nullptr);
 }
 
 #endif // !__FilterWork__
-
@@ -0,0 +1,90 @@
+#include "OrderedDither.h"
+#include "Quantize.h"
+#include "BlueNoiseRanks.h"
+
+namespace
+{
+	// Side of the offset table, every mask tiles it exactly
+	const int	TileSize = static_cast<int>(Filter::QuantizeOffsetPeriod);
+
+	static_assert(TileSize % Filter::BlueNoiseSize == 0, "the blue noise mask has to tile the offset table");
+
+	// Rank of (x, y) in a size x size Bayer matrix, size a power of 2. Each level of the
+	// matrix takes the next two bits of the rank, the coarsest level the most significant.
+	int
+		bayerRank(int x, int y, int size)
+	{
+		int	rank = 0;
+		for (int bit = 1; bit < size; bit <<= 1)
+		{
+			const int	xb = (x & bit) ? 1 : 0;
+			const int	yb = (y & bit) ? 1 : 0;
+			rank = (rank << 2) | ((xb ^ yb) << 1) | yb;
+		}
+		return rank;
+	}
+}
+
+Filter::OrderedDither::OrderedDither() :
+	myOffsets{}, myMode{ DitherMode::Bayer2 }, myColorBits{ 0 }
+{
+}
+
+void
+Filter::OrderedDither::setup(DitherMode mode, int colorBits)
+{
+	if (mode == myMode && colorBits == myColorBits)
+		return;
+
+	myMode = mode;
+	myColorBits = colorBits;
+	myOffsets.resize(static_cast<size_t>(TileSize) * TileSize);
+
+	int	size;
+	switch (mode)
+	{
+		case DitherMode::Bayer2:
+			size = 2;
+			break;
+		case DitherMode::Bayer4:
+			size = 4;
+			break;
+		case DitherMode::Bayer8:
+			size = 8;
+			break;
+		default:
+			size = BlueNoiseSize;
+			break;
+	}
+
+	const bool	blueNoise = mode == DitherMode::BlueNoise;
+	const int	cells = size * size;
+	const int	step = 256 >> colorBits;
+
+	for (int y = 0; y < TileSize; ++y)
+	{
+		for (int x = 0; x < TileSize; ++x)
+		{
+			const int	mx = x % size;
+			const int	my = y % size;
+			const int	rank = blueNoise ? BlueNoiseRanks[my * size + mx] : bayerRank(mx, my, size);
+
+			// A pixel a fraction f of the way to the next palette color goes up on a
+			// fraction f of the mask
+			const uint32_t	offset = static_cast<uint32_t>(rank * step / cells);
+			myOffsets[y * TileSize + x] = offset | (offset << 8) | (offset << 16);
+		}
+	}
+}
+
+const uint32_t*
+Filter::OrderedDither::row(int y) const
+{
+	return myOffsets.data() + static_cast<size_t>(y % TileSize) * TileSize;
+}
+
+size_t
+Filter::OrderedDither::getCapacity() const
+{
+	return myOffsets.capacity() * sizeof(uint32_t);
+}
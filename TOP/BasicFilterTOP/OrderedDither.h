@@ -0,0 +1,52 @@
+#ifndef __OrderedDither__
+#define __OrderedDither__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+Ordered dithering compares every pixel with a threshold from a small tiled mask instead of
+diffusing its error, so pixels do not depend on each other and a frame can be split in any
+way across threads. The thresholds are turned into offsets of up to one palette step which
+quantizeOrdered() adds before dropping the low bits.
+
+The Bayer masks give the regular cross hatch of ordered dithering. The blue noise mask is a
+64x64 tileable void-and-cluster pattern, it has no visible structure at the cost of some
+grain. Its ranks are generated offline, see BlueNoiseRanks.h.
+*/
+namespace Filter
+{
+	enum class DitherMode
+	{
+		FloydSteinberg,
+		Bayer2,
+		Bayer4,
+		Bayer8,
+		BlueNoise
+	};
+
+	class OrderedDither
+	{
+	public:
+		OrderedDither();
+
+		// Fills the offsets, only when mode or colorBits changed since the last call. mode
+		// must be one of the ordered modes
+		void	setup(DitherMode mode, int colorBits);
+
+		// Offsets for row y, QuantizeOffsetPeriod of them
+		const uint32_t*	row(int y) const;
+
+		// Bytes reserved for the offsets
+		size_t	getCapacity() const;
+
+	private:
+		std::vector<uint32_t>	myOffsets;
+		DitherMode				myMode;
+		// 0 until the first setup()
+		int						myColorBits;
+	};
+}
+
+#endif // !__OrderedDither__
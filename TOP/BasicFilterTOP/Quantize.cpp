@@ -0,0 +1,227 @@
+#include "Quantize.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define QUANTIZE_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC compiles any intrinsic, GCC and Clang need the instruction set enabled per function
+#if defined(QUANTIZE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define QUANTIZE_TARGET(isa) __attribute__((target(isa)))
+#else
+#define QUANTIZE_TARGET(isa)
+#endif
+
+namespace
+{
+	using Filter::QuantizeKernel;
+
+	void
+		quantizeScalar(const uint32_t* inPixel, uint32_t* outPixel, size_t count, uint32_t mask)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			outPixel[i] = inPixel[i] & mask;
+		}
+	}
+
+	void
+		quantizeOrderedScalar(const uint32_t* inPixel, uint32_t* outPixel, size_t begin, size_t end, const uint32_t* offsets, uint32_t mask)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			const uint32_t	px = inPixel[i];
+			const uint32_t	offset = offsets[i % Filter::QuantizeOffsetPeriod];
+			uint32_t		sum = px & 0xFF000000u;
+
+			for (int shift = 0; shift < 24; shift += 8)
+			{
+				const uint32_t	v = ((px >> shift) & 0xFF) + ((offset >> shift) & 0xFF);
+				sum |= (v > 0xFF ? 0xFF : v) << shift;
+			}
+
+			outPixel[i] = sum & mask;
+		}
+	}
+
+#ifdef QUANTIZE_X86
+	QUANTIZE_TARGET("sse2")
+	void
+		quantizeSSE2(const uint32_t* inPixel, uint32_t* outPixel, size_t count, uint32_t mask)
+	{
+		const __m128i	m = _mm_set1_epi32(static_cast<int>(mask));
+		size_t			i = 0;
+
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inPixel + i));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inPixel + i + 4));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(outPixel + i), _mm_and_si128(a, m));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(outPixel + i + 4), _mm_and_si128(b, m));
+		}
+
+		quantizeScalar(inPixel + i, outPixel + i, count - i, mask);
+	}
+
+	// i stays a multiple of 8, so the 8 offsets of an iteration never wrap around the period
+	QUANTIZE_TARGET("sse2")
+	void
+		quantizeOrderedSSE2(const uint32_t* inPixel, uint32_t* outPixel, size_t count, const uint32_t* offsets, uint32_t mask)
+	{
+		const __m128i	m = _mm_set1_epi32(static_cast<int>(mask));
+		size_t			i = 0;
+
+		for (; i + 8 <= count; i += 8)
+		{
+			const uint32_t*	o = offsets + i % Filter::QuantizeOffsetPeriod;
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inPixel + i));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inPixel + i + 4));
+			a = _mm_adds_epu8(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(o)));
+			b = _mm_adds_epu8(b, _mm_loadu_si128(reinterpret_cast<const __m128i*>(o + 4)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(outPixel + i), _mm_and_si128(a, m));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(outPixel + i + 4), _mm_and_si128(b, m));
+		}
+
+		quantizeOrderedScalar(inPixel, outPixel, i, count, offsets, mask);
+	}
+
+	QUANTIZE_TARGET("avx2")
+	void
+		quantizeAVX2(const uint32_t* inPixel, uint32_t* outPixel, size_t count, uint32_t mask)
+	{
+		const __m256i	m = _mm256_set1_epi32(static_cast<int>(mask));
+		size_t			i = 0;
+
+		for (; i + 16 <= count; i += 16)
+		{
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inPixel + i));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inPixel + i + 8));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(outPixel + i), _mm256_and_si256(a, m));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(outPixel + i + 8), _mm256_and_si256(b, m));
+		}
+
+		quantizeScalar(inPixel + i, outPixel + i, count - i, mask);
+	}
+
+	QUANTIZE_TARGET("avx2")
+	void
+		quantizeOrderedAVX2(const uint32_t* inPixel, uint32_t* outPixel, size_t count, const uint32_t* offsets, uint32_t mask)
+	{
+		const __m256i	m = _mm256_set1_epi32(static_cast<int>(mask));
+		size_t			i = 0;
+
+		for (; i + 16 <= count; i += 16)
+		{
+			const uint32_t*	o = offsets + i % Filter::QuantizeOffsetPeriod;
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inPixel + i));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inPixel + i + 8));
+			a = _mm256_adds_epu8(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o)));
+			b = _mm256_adds_epu8(b, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o + 8)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(outPixel + i), _mm256_and_si256(a, m));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(outPixel + i + 8), _mm256_and_si256(b, m));
+		}
+
+		quantizeOrderedScalar(inPixel, outPixel, i, count, offsets, mask);
+	}
+
+	bool
+		cpuHasAVX2()
+	{
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		// The OS has to save the YMM registers too
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+	bool
+		cpuHasSSE2()
+	{
+#if defined(_M_X64) || defined(__x86_64__)
+		return true;
+#elif defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		return (info[3] & (1 << 26)) != 0;
+#else
+		return __builtin_cpu_supports("sse2");
+#endif
+	}
+#endif
+
+	QuantizeKernel
+		detectKernel()
+	{
+#ifdef QUANTIZE_X86
+		if (cpuHasAVX2())
+			return QuantizeKernel::AVX2;
+		if (cpuHasSSE2())
+			return QuantizeKernel::SSE2;
+#endif
+		return QuantizeKernel::Scalar;
+	}
+}
+
+Filter::QuantizeKernel
+Filter::getQuantizeKernel()
+{
+	static const QuantizeKernel	theKernel = detectKernel();
+	return theKernel;
+}
+
+void
+Filter::quantize(const uint32_t* inPixel, uint32_t* outPixel, size_t count, int colorBits)
+{
+	const uint32_t	mask = paletteMask(colorBits);
+
+	switch (getQuantizeKernel())
+	{
+#ifdef QUANTIZE_X86
+		case QuantizeKernel::AVX2:
+			quantizeAVX2(inPixel, outPixel, count, mask);
+			break;
+		case QuantizeKernel::SSE2:
+			quantizeSSE2(inPixel, outPixel, count, mask);
+			break;
+#endif
+		default:
+			quantizeScalar(inPixel, outPixel, count, mask);
+			break;
+	}
+}
+
+void
+Filter::quantizeOrdered(const uint32_t* inPixel, uint32_t* outPixel, size_t count, const uint32_t* offsets, int colorBits)
+{
+	const uint32_t	mask = paletteMask(colorBits);
+
+	switch (getQuantizeKernel())
+	{
+#ifdef QUANTIZE_X86
+		case QuantizeKernel::AVX2:
+			quantizeOrderedAVX2(inPixel, outPixel, count, offsets, mask);
+			break;
+		case QuantizeKernel::SSE2:
+			quantizeOrderedSSE2(inPixel, outPixel, count, offsets, mask);
+			break;
+#endif
+		default:
+			quantizeOrderedScalar(inPixel, outPixel, 0, count, offsets, mask);
+			break;
+	}
+}
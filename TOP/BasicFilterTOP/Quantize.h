@@ -0,0 +1,51 @@
+#ifndef __Quantize__
+#define __Quantize__
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+Reduces the RGB channels of RGBA8 pixels to their top bits, the alpha channel is kept.
+Each pixel only needs an AND with a constant mask, the SSE2 and AVX2 kernels mask
+8 and 16 pixels per loop iteration. The kernel is chosen once from what the CPU supports,
+builds for other architectures only have the scalar one.
+
+quantizeOrdered() first adds a per pixel offset to R, G and B with saturation, which is how
+the ordered dither modes push a pixel over to the next palette color.
+*/
+namespace Filter
+{
+	enum class QuantizeKernel
+	{
+		Scalar,
+		SSE2,
+		AVX2
+	};
+
+	// Mask that keeps the colorBits top bits of R, G and B and all of A
+	inline uint32_t
+	paletteMask(int colorBits)
+	{
+		const uint32_t	channel = (0xFFu << (8 - colorBits)) & 0xFFu;
+		return channel | (channel << 8) | (channel << 16) | 0xFF000000u;
+	}
+
+	inline uint32_t
+	closestPaletteColor(uint32_t color, int colorBits)
+	{
+		return color & paletteMask(colorBits);
+	}
+
+	// The offsets given to quantizeOrdered() repeat every QuantizeOffsetPeriod pixels
+	const size_t	QuantizeOffsetPeriod = 64;
+
+	// Kernel used by quantize() and quantizeOrdered() on this CPU
+	QuantizeKernel	getQuantizeKernel();
+
+	void	quantize(const uint32_t* inPixel, uint32_t* outPixel, size_t count, int colorBits);
+
+	// Pixel i gets offsets[i % QuantizeOffsetPeriod] added before it is quantized
+	void	quantizeOrdered(const uint32_t* inPixel, uint32_t* outPixel, size_t count, const uint32_t* offsets, int colorBits);
+}
+
+#endif // !__Quantize__
@@ -0,0 +1,206 @@
+#include "Resample.h"
+
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RESAMPLE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	using Filter::ResizeFilter;
+
+	// Bilinear positions are in 1/256 of a pixel, the top bits are the left or top
+	// pixel and the low 8 bits the weight of the one after it
+	const int	WeightBits = 8;
+	const int	WeightOne = 1 << WeightBits;
+
+	int32_t
+		bilinearPosition(int i, int inSize, int outSize)
+	{
+		// Center of output pixel i in input pixels, minus half a pixel to get the
+		// distance from the center of the input pixel before it
+		const int64_t	pos = ((2 * static_cast<int64_t>(i) + 1) * inSize * WeightOne) / (2 * outSize) - WeightOne / 2;
+		const int64_t	last = static_cast<int64_t>(inSize - 1) << WeightBits;
+		return static_cast<int32_t>(std::min(std::max(pos, int64_t{ 0 }), last));
+	}
+
+	// First input pixel covered by output pixel i, output pixel i + 1 starts where it ends
+	int
+		boxStart(int i, int inSize, int outSize)
+	{
+		return static_cast<int>(static_cast<int64_t>(i) * inSize / outSize);
+	}
+
+	void
+		nearestRow(const uint32_t* inPixel, int inWidth, int inY, uint32_t* outRow, int outWidth, const int32_t* columns)
+	{
+		const uint32_t*	inRow = inPixel + static_cast<size_t>(inY) * inWidth;
+		for (int x = 0; x < outWidth; ++x)
+			outRow[x] = inRow[columns[x]];
+	}
+
+#ifdef RESAMPLE_SSE2
+	inline __m128i
+		widenPixel(uint32_t px)
+	{
+		return _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(px)), _mm_setzero_si128());
+	}
+
+	// Rounded a * (256 - w) + b * w for the 4 channels, a and b widened to 16 bits
+	inline __m128i
+		lerp(__m128i a, __m128i b, __m128i weights)
+	{
+		const __m128i	half = _mm_set1_epi32(WeightOne / 2);
+		__m128i			v = _mm_madd_epi16(_mm_unpacklo_epi16(a, b), weights);
+		return _mm_srli_epi32(_mm_add_epi32(v, half), WeightBits);
+	}
+
+	inline __m128i
+		lerpWeights(int32_t w)
+	{
+		return _mm_set1_epi32((w << 16) | (WeightOne - w));
+	}
+#else
+	inline uint32_t
+		lerpChannel(uint32_t a, uint32_t b, int32_t w)
+	{
+		return (a * (WeightOne - w) + b * w + WeightOne / 2) >> WeightBits;
+	}
+#endif
+
+	void
+		bilinearRow(const uint32_t* inPixel, int inWidth, int32_t posY, uint32_t* outRow, int outWidth, const int32_t* columns, int inHeight)
+	{
+		const int		y0 = posY >> WeightBits;
+		const int		y1 = std::min(y0 + 1, inHeight - 1);
+		const int32_t	wy = posY & (WeightOne - 1);
+		const uint32_t*	top = inPixel + static_cast<size_t>(y0) * inWidth;
+		const uint32_t*	bottom = inPixel + static_cast<size_t>(y1) * inWidth;
+
+#ifdef RESAMPLE_SSE2
+		const __m128i	wyv = lerpWeights(wy);
+#endif
+
+		for (int x = 0; x < outWidth; ++x)
+		{
+			const int		x0 = columns[x] >> WeightBits;
+			const int		x1 = std::min(x0 + 1, inWidth - 1);
+			const int32_t	wx = columns[x] & (WeightOne - 1);
+
+#ifdef RESAMPLE_SSE2
+			const __m128i	wxv = lerpWeights(wx);
+			const __m128i	t = lerp(widenPixel(top[x0]), widenPixel(top[x1]), wxv);
+			const __m128i	b = lerp(widenPixel(bottom[x0]), widenPixel(bottom[x1]), wxv);
+
+			// t and b are below 256, so packing them to 16 bits keeps them and leaves
+			// them in order for the vertical lerp
+			const __m128i	v = lerp(_mm_packs_epi32(t, t), _mm_packs_epi32(b, b), wyv);
+			const __m128i	packed = _mm_packs_epi32(v, v);
+			outRow[x] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(packed, packed)));
+#else
+			uint32_t	px = 0;
+			for (int shift = 0; shift < 32; shift += 8)
+			{
+				const uint32_t	t = lerpChannel((top[x0] >> shift) & 0xFF, (top[x1] >> shift) & 0xFF, wx);
+				const uint32_t	b = lerpChannel((bottom[x0] >> shift) & 0xFF, (bottom[x1] >> shift) & 0xFF, wx);
+				px |= lerpChannel(t, b, wy) << shift;
+			}
+			outRow[x] = px;
+#endif
+		}
+	}
+
+	void
+		boxRow(const uint32_t* inPixel, int inWidth, int yBegin, int yEnd, uint32_t* outRow, int outWidth, const int32_t* columns)
+	{
+		for (int x = 0; x < outWidth; ++x)
+		{
+			const int	xBegin = columns[x];
+			const int	xEnd = std::max(columns[x + 1], xBegin + 1);
+			const float	scale = 1.0f / static_cast<float>((xEnd - xBegin) * (yEnd - yBegin));
+
+#ifdef RESAMPLE_SSE2
+			__m128i	sum = _mm_setzero_si128();
+			for (int y = yBegin; y < yEnd; ++y)
+			{
+				const uint32_t*	inRow = inPixel + static_cast<size_t>(y) * inWidth;
+				for (int i = xBegin; i < xEnd; ++i)
+					sum = _mm_add_epi32(sum, _mm_unpacklo_epi16(widenPixel(inRow[i]), _mm_setzero_si128()));
+			}
+
+			const __m128	mean = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(sum), _mm_set1_ps(scale)), _mm_set1_ps(0.5f));
+			const __m128i	v = _mm_cvttps_epi32(mean);
+			const __m128i	packed = _mm_packs_epi32(v, v);
+			outRow[x] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(packed, packed)));
+#else
+			uint32_t	sum[4] = {};
+			for (int y = yBegin; y < yEnd; ++y)
+			{
+				const uint32_t*	inRow = inPixel + static_cast<size_t>(y) * inWidth;
+				for (int i = xBegin; i < xEnd; ++i)
+					for (int ch = 0; ch < 4; ++ch)
+						sum[ch] += (inRow[i] >> (8 * ch)) & 0xFF;
+			}
+
+			uint32_t	px = 0;
+			for (int ch = 0; ch < 4; ++ch)
+				px |= static_cast<uint32_t>(static_cast<float>(sum[ch]) * scale + 0.5f) << (8 * ch);
+			outRow[x] = px;
+#endif
+		}
+	}
+}
+
+void
+Filter::resampleColumns(ResizeFilter filter, int inWidth, int outWidth, std::vector<int32_t>& columns)
+{
+	switch (filter)
+	{
+		case ResizeFilter::Bilinear:
+			columns.resize(outWidth);
+			for (int x = 0; x < outWidth; ++x)
+				columns[x] = bilinearPosition(x, inWidth, outWidth);
+			break;
+		case ResizeFilter::Box:
+			// One more so the last column knows where it ends
+			columns.resize(static_cast<size_t>(outWidth) + 1);
+			for (int x = 0; x <= outWidth; ++x)
+				columns[x] = std::min(boxStart(x, inWidth, outWidth), inWidth);
+			break;
+		default:
+			columns.resize(outWidth);
+			for (int x = 0; x < outWidth; ++x)
+				columns[x] = std::min(boxStart(2 * x + 1, inWidth, 2 * outWidth), inWidth - 1);
+			break;
+	}
+}
+
+void
+Filter::resampleRows(const uint32_t* inPixel, int inWidth, int inHeight, uint32_t* outPixel, int outWidth, int outHeight,
+					 ResizeFilter filter, const int32_t* columns, int begin, int end)
+{
+	for (int y = begin; y < end; ++y)
+	{
+		uint32_t*	outRow = outPixel + static_cast<size_t>(y) * outWidth;
+
+		switch (filter)
+		{
+			case ResizeFilter::Bilinear:
+				bilinearRow(inPixel, inWidth, bilinearPosition(y, inHeight, outHeight), outRow, outWidth, columns, inHeight);
+				break;
+			case ResizeFilter::Box:
+			{
+				const int	yBegin = std::min(boxStart(y, inHeight, outHeight), inHeight - 1);
+				const int	yEnd = std::max(boxStart(y + 1, inHeight, outHeight), yBegin + 1);
+				boxRow(inPixel, inWidth, yBegin, yEnd, outRow, outWidth, columns);
+				break;
+			}
+			default:
+				nearestRow(inPixel, inWidth, std::min(boxStart(2 * y + 1, inHeight, 2 * outHeight), inHeight - 1),
+						   outRow, outWidth, columns);
+				break;
+		}
+	}
+}
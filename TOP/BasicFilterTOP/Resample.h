@@ -0,0 +1,34 @@
+#ifndef __Resample__
+#define __Resample__
+
+#include <cstdint>
+#include <vector>
+
+/*
+Resizes RGBA8 images. Pixels are sampled at their centers, so every filter keeps the image
+aligned whatever the scale.
+	- Nearest:	Takes the input pixel under the center of each output pixel.
+	- Bilinear:	Blends the 4 input pixels around the center with 8 bit weights.
+	- Box:		Averages all the input pixels the output pixel covers, the best for downscaling.
+Bilinear and Box work on the 4 channels of a pixel at once with SSE2 on x86.
+
+The column lookup only depends on the widths and the filter, it is built once per frame
+by resampleColumns() and shared by all the rows.
+*/
+namespace Filter
+{
+	enum class ResizeFilter
+	{
+		Nearest,
+		Bilinear,
+		Box
+	};
+
+	void	resampleColumns(ResizeFilter filter, int inWidth, int outWidth, std::vector<int32_t>& columns);
+
+	// Computes output rows [begin, end)
+	void	resampleRows(const uint32_t* inPixel, int inWidth, int inHeight, uint32_t* outPixel, int outWidth, int outHeight,
+						 ResizeFilter filter, const int32_t* columns, int begin, int end);
+}
+
+#endif // !__Resample__
@@ -13,7 +13,7 @@ ThreadManager::ThreadManager() :
 	myStatus{ ThreadStatus::Waiting }, myOutBuffer{nullptr}, myDownRes{nullptr},
 	myThread{}, myBufferMutex{}, myBufferCV{},
 	myThreadShouldExit{false}, myInWidth{}, myInHeight{},
-	myOutWidth{}, myOutHeight{}, myDoDither{ false }, myBitsPerColor{ 8 }, myContext{ nullptr }, myUploadInfo{}
+	myOutWidth{}, myOutHeight{}, mySettings{}, myContext{ nullptr }, myUploadInfo{}
 {
 	myThread = new std::thread([this] { threadFn(); });
 }
@@ -37,20 +37,21 @@ ThreadManager::~ThreadManager()
 }
 
 void 
-ThreadManager::sync(bool doDither, int bitsPerColor, int inWidth, int inHeight, 
+ThreadManager::sync(const Filter::Settings& settings, int inWidth, int inHeight, int outWidth, int outHeight, 
 																			const OP_SmartRef<OP_TOPDownloadResult> downRes, TD::TOP_Context* context)
 {
 	std::unique_lock<std::mutex> bufferlock(myBufferMutex);
-	myDoDither = doDither;
-	myBitsPerColor = bitsPerColor;
+	mySettings = settings;
 	myInWidth = inWidth;
 	myInHeight = inHeight;
+	myOutWidth = outWidth;
+	myOutHeight = outHeight;
 
 	myContext = context;
 	myDownRes = downRes;
 	myUploadInfo.textureDesc = myDownRes->textureDesc;
-	myOutWidth = myUploadInfo.textureDesc.width;
-	myOutHeight = myUploadInfo.textureDesc.height;
+	myUploadInfo.textureDesc.width = outWidth;
+	myUploadInfo.textureDesc.height = outHeight;
 	myStatus.store(ThreadStatus::Ready);
 	bufferlock.unlock();
 
@@ -79,12 +80,11 @@ ThreadManager::threadFn()
 		const int							outheight = myOutHeight;
 		const int							inwidth = myInWidth;
 		const int							inheight = myInHeight;
-		const bool							doDither = myDoDither;
-		const int							bitsPerColor = myBitsPerColor;
+		const Filter::Settings				settings = mySettings;
 		TOP_Context*					context = myContext;
 		OP_SmartRef<OP_TOPDownloadResult> downRes = myDownRes;
 
-		size_t byteSize = inwidth * inheight * sizeof(uint32_t);
+		size_t byteSize = static_cast<size_t>(outwidth) * outheight * sizeof(uint32_t);
 		myOutBuffer = context->createOutputBuffer(byteSize, TOP_BufferFlags::None, nullptr);
 
 		uint32_t* outbuf = (uint32_t*)myOutBuffer->data;
@@ -92,7 +92,7 @@ ThreadManager::threadFn()
 
 		uint32_t* inBuffer = (uint32_t*)downRes->getData();
 
-		Filter::doFilterWork(inBuffer, inwidth, inheight, outbuf, outwidth, outheight, doDither, bitsPerColor);
+		Filter::doFilterWork(inBuffer, inwidth, inheight, outbuf, outwidth, outheight, settings, myScratch);
 		myDownRes.release();
 		myStatus.store(ThreadStatus::Done);
 		bufferLock.unlock();
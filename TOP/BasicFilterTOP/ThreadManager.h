@@ -2,6 +2,7 @@
 #define __ThreadManager__
 
 #include "TOP_CPlusPlusBase.h"
+#include "FilterWork.h"
 
 #include <mutex>
 #include <atomic>
@@ -29,7 +30,7 @@ public:
 
 	~ThreadManager();
 
-	void	sync(bool doDither, int bitsPerColor, int inWidth, int inHeight, const OP_SmartRef<OP_TOPDownloadResult> downRes, TD::TOP_Context* context);
+	void	sync(const Filter::Settings& settings, int inWidth, int inHeight, int outWidth, int outHeight, const OP_SmartRef<OP_TOPDownloadResult> downRes, TD::TOP_Context* context);
 
 
 	void	popOutBuffer(OP_SmartRef<TOP_Buffer>& outBuffer, TD::TOP_UploadInfo& info);
@@ -55,10 +56,12 @@ private:
 	int						myInHeight;
 	int						myOutWidth;
 	int						myOutHeight;
-	bool					myDoDither;
-	int						myBitsPerColor;
+	Filter::Settings		mySettings;
 	TD::TOP_Context*		myContext;
 	TD::TOP_UploadInfo		myUploadInfo;
+
+	// Only used by the thread
+	Filter::Scratch			myScratch;
 };
 
 #endif
@@ -0,0 +1,113 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool() :
+	myTask{ nullptr }, myNumTasks{ 0 }, myNextTask{ 0 }, myPendingTasks{ 0 },
+	myJobId{ 0 }, myShouldExit{ false }
+{
+}
+
+WorkerPool::~WorkerPool()
+{
+	stopWorkers();
+}
+
+void
+WorkerPool::setNumThreads(int numThreads)
+{
+	numThreads = std::max(numThreads, 1);
+	if (numThreads == getNumThreads())
+		return;
+
+	stopWorkers();
+
+	myShouldExit = false;
+	for (int i = 0; i < numThreads - 1; ++i)
+		myWorkers.emplace_back([this] { workerFn(); });
+}
+
+int
+WorkerPool::getNumThreads() const
+{
+	return static_cast<int>(myWorkers.size()) + 1;
+}
+
+void
+WorkerPool::run(int numTasks, const std::function<void(int)>& task)
+{
+	if (numTasks <= 0)
+		return;
+
+	if (myWorkers.empty())
+	{
+		for (int i = 0; i < numTasks; ++i)
+			task(i);
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(myMutex);
+	myTask = &task;
+	myNumTasks = numTasks;
+	myNextTask = 0;
+	myPendingTasks = numTasks;
+	myJobId++;
+	lock.unlock();
+	myWorkCV.notify_all();
+
+	runTasks();
+
+	lock.lock();
+	myDoneCV.wait(lock, [this] { return myPendingTasks == 0; });
+	myTask = nullptr;
+}
+
+void
+WorkerPool::stopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		myShouldExit = true;
+	}
+	myWorkCV.notify_all();
+
+	for (std::thread& worker : myWorkers)
+		worker.join();
+	myWorkers.clear();
+}
+
+void
+WorkerPool::workerFn()
+{
+	unsigned lastJob = 0;
+	while (true)
+	{
+		std::unique_lock<std::mutex> lock(myMutex);
+		myWorkCV.wait(lock, [&] { return myShouldExit || (myTask && myJobId != lastJob); });
+		if (myShouldExit)
+			return;
+
+		lastJob = myJobId;
+		lock.unlock();
+
+		runTasks();
+	}
+}
+
+void
+WorkerPool::runTasks()
+{
+	std::unique_lock<std::mutex> lock(myMutex);
+	while (myTask && myNextTask < myNumTasks)
+	{
+		const std::function<void(int)>& task = *myTask;
+		int index = myNextTask++;
+		lock.unlock();
+
+		task(index);
+
+		lock.lock();
+		if (--myPendingTasks == 0)
+			myDoneCV.notify_all();
+	}
+}
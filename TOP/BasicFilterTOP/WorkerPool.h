@@ -0,0 +1,57 @@
+#ifndef __WorkerPool__
+#define __WorkerPool__
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+A fixed set of threads that split the work of a single frame. Unlike ThreadManager,
+which filters whole frames in the background, run() returns once the frame is done so
+it adds no latency.
+
+The thread calling run() executes tasks too, a pool of N threads starts N - 1 workers.
+Tasks are handed out in increasing index order, so a task may wait for the progress of
+a lower index task without deadlocking the pool.
+*/
+class WorkerPool
+{
+public:
+	WorkerPool();
+
+	~WorkerPool();
+
+	// Number of threads including the one calling run(), at least 1
+	void	setNumThreads(int numThreads);
+
+	int		getNumThreads() const;
+
+	// Calls task(index) for every index in [0, numTasks) and returns when all of them finished
+	void	run(int numTasks, const std::function<void(int)>& task);
+
+private:
+	void	stopWorkers();
+
+	void	workerFn();
+
+	// Runs tasks of the current job until there are none left
+	void	runTasks();
+
+	std::vector<std::thread>			myWorkers;
+
+	std::mutex							myMutex;
+	std::condition_variable				myWorkCV;
+	std::condition_variable				myDoneCV;
+
+	// Current job, protected by myMutex
+	const std::function<void(int)>*		myTask;
+	int									myNumTasks;
+	int									myNextTask;
+	int									myPendingTasks;
+	unsigned							myJobId;
+	bool								myShouldExit;
+};
+
+#endif
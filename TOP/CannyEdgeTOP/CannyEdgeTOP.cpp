@@ -84,7 +84,8 @@ CannyEdgeTOP::CannyEdgeTOP(const TD::OP_NodeInfo*, TD::TOP_Context *context) :
 	myExecuteCount(0),
 	myError(""),
 	myContext(context),
-	myStream(0)
+	myStream(0),
+	myCookStats{ "input", "detect", "output" }
 {
 	cudaStreamCreate(&myStream);
 }
@@ -105,6 +106,7 @@ CannyEdgeTOP::getGeneralInfo(TD::TOP_GeneralInfo* ginfo, const TD::OP_Inputs*, v
 void
 CannyEdgeTOP::execute(TD::TOP_Output* output, const TD::OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
 	myError = "";
 	myExecuteCount++;
 
@@ -158,12 +160,16 @@ CannyEdgeTOP::execute(TD::TOP_Output* output, const TD::OP_Inputs* inputs, void*
 		return;
 	}
 
+	myCookStats.beginPhase(CookPhase::Input);
 	*myFrame = cv::cuda::GpuMat(inheight, inwidth, myMatType);
+	myCookStats.addAllocated(static_cast<size_t>(inwidth) * inheight * myPixelSize);
 	GpuUtils::arrayToMatGPU(inwidth, inheight, inputArray->cudaArray, *myFrame, myPixelSize);
+	myCookStats.endPhase();
 
 	if (myFrame->empty())
 		return;
 
+	myCookStats.beginPhase(CookPhase::Detect);
 	if (appertureSize % 2 == 0)
 		++appertureSize;
 
@@ -189,10 +195,13 @@ CannyEdgeTOP::execute(TD::TOP_Output* output, const TD::OP_Inputs* inputs, void*
 
 	cv::cuda::Stream stream = cv::cuda::StreamAccessor::wrapStream(myStream);
 	cannyEdge->detect(*myFrame, *myFrame, stream);
+	myCookStats.endPhase();
 
+	myCookStats.beginPhase(CookPhase::Output);
 	GpuUtils::matGPUToArray(info.textureDesc.width, info.textureDesc.height, *myFrame, outputInfo->cudaArray, 1);
 
 	myContext->endCUDAOperations(nullptr);
+	myCookStats.endPhase();
 }
 
 void
@@ -269,6 +278,17 @@ CannyEdgeTOP::getErrorString(TD::OP_String* error, void*)
 	myError.clear();
 }
 
+int32_t
+CannyEdgeTOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+CannyEdgeTOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
 
 bool
 CannyEdgeTOP::checkInputTop(const TD::OP_TOPInput* topInput)
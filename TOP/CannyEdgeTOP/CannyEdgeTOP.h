@@ -16,6 +16,7 @@
 #define __CannyEdgeTOP__
 
 #include "TOP_CPlusPlusBase.h"
+#include "CookStats.h"
 
 #include <opencv2\core.hpp>
 #include <string>
@@ -44,6 +45,10 @@ It takes the following parameters:
 For more information visit: https://docs.opencv.org/3.4/d0/d05/group__cudaimgproc.html#gabc17953de36faa404acb07dc587451fc
 
 This TOP takes one input which must be 8 bit single channel.
+
+It outputs the cook time statistics described in CookStats.h to CHOPInfo, with the
+input, detect and output phases. The CUDA work is asynchronous, the phases measure the
+time spent on the CPU issuing it.
 */
 
 // To get more help about these functions, look at TOP_CPlusPlusBase.h
@@ -61,7 +66,18 @@ public:
 
 	virtual void		getErrorString(TD::OP_String*, void* reserved) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void* reserved) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void* reserved) override;
+
 private:
+	enum class CookPhase
+	{
+		Input,
+		Detect,
+		Output
+	};
+
 	bool				checkInputTop(const TD::OP_TOPInput*);
 
 	cv::cuda::GpuMat*	myFrame;
@@ -78,6 +94,8 @@ private:
 	// In this example this value will be incremented each time the execute()
 // function is called, then passes back to the TOP 
 	int32_t				myExecuteCount;
+
+	CookStats			myCookStats;
 };
 
 #endif
@@ -0,0 +1,45 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "ChannelExtract.h"
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CHANNELEXTRACT_SSE2
+#include <emmintrin.h>
+#endif
+
+void
+extractChannel(const uint8_t* rgba, uint8_t* out, size_t count, int channel)
+{
+	size_t	i = 0;
+
+#ifdef CHANNELEXTRACT_SSE2
+	const __m128i	shift = _mm_cvtsi32_si128(8 * channel);
+	const __m128i	low = _mm_set1_epi32(0xFF);
+	for (; i + 16 <= count; i += 16)
+	{
+		const __m128i*	p = reinterpret_cast<const __m128i*>(rgba + 4 * i);
+		const __m128i	a = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(p), shift), low);
+		const __m128i	b = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(p + 1), shift), low);
+		const __m128i	c = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(p + 2), shift), low);
+		const __m128i	d = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(p + 3), shift), low);
+		// Every 32 bit lane is below 256 so neither pack saturates
+		const __m128i	packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+	}
+#endif
+
+	for (; i < count; ++i)
+		out[i] = rgba[4 * i + channel];
+}
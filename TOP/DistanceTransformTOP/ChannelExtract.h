@@ -0,0 +1,29 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#ifndef __ChannelExtract__
+#define __ChannelExtract__
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+Copies one channel out of RGBA8 pixels. The SSE2 version takes 16 pixels per iteration:
+it shifts the channel down to the low byte of each pixel and packs the 64 bytes to 16.
+*/
+
+// channel is 0 to 3 for R, G, B and A
+void	extractChannel(const uint8_t* rgba, uint8_t* out, size_t count, int channel);
+
+#endif // !__ChannelExtract__
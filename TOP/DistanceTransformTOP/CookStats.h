@@ -0,0 +1,251 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#ifndef __CookStats__
+#define __CookStats__
+
+#include "CPlusPlus_Common.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/*
+Cook time instrumentation shared by all the operators. The same header is copied in
+every operator folder, like CPlusPlus_Common.h.
+
+An operator owns one CookStats, wraps its execute() in a CookStats::Cook and the
+interesting parts of it in a CookStats::Phase, then forwards getNumInfoCHOPChans and
+getInfoCHOPChan. It outputs the following channels to the Info CHOP:
+	- cook_ms:	Time spent in the last execute().
+	- cook_p50_ms, cook_p95_ms, cook_p99_ms:	Percentiles over the last WindowSize cooks.
+	- cook_alloc_bytes:	Bytes the operator reported with addAllocated() in the last cook.
+	- <phase>_ms:	Time spent in each phase in the last cook.
+
+Timing costs two clock reads per scope, percentiles are only computed when the Info
+CHOP asks for them.
+*/
+class CookStats
+{
+public:
+	// Number of cooks the percentiles are computed over, 4 seconds at 60 fps
+	static constexpr int	WindowSize = 240;
+
+	// The phase names are used for the channel names, index them in the
+	// order they are given
+	CookStats(std::initializer_list<const char*> phases = {}) :
+		myPhaseMs(phases.size(), 0.0), myCookMs{ 0.0 }, myAllocated{ 0 },
+		myNumSamples{ 0 }, myNextSample{ 0 }, myPercentilesDirty{ true }
+	{
+		for (const char* phase : phases)
+			myPhaseNames.push_back(std::string(phase) + "_ms");
+	}
+
+	void
+	beginCook()
+	{
+		std::fill(myPhaseMs.begin(), myPhaseMs.end(), 0.0);
+		myAllocated = 0;
+		myCookStart = Clock::now();
+	}
+
+	void
+	endCook()
+	{
+		myCookMs = elapsedMs(myCookStart);
+		mySamples[myNextSample] = static_cast<float>(myCookMs);
+		myNextSample = (myNextSample + 1) % WindowSize;
+		myNumSamples = std::min(myNumSamples + 1, WindowSize);
+		myPercentilesDirty = true;
+	}
+
+	// Phases entered more than once in a cook add up. The phase can be an
+	// int or the operator's own enum class
+	template <class T>
+	void
+	beginPhase(T phase)
+	{
+		myPhaseStart = Clock::now();
+		myPhase = static_cast<int>(phase);
+	}
+
+	void
+	endPhase()
+	{
+		myPhaseMs[myPhase] += elapsedMs(myPhaseStart);
+	}
+
+	void
+	addAllocated(size_t bytes)
+	{
+		myAllocated += bytes;
+	}
+
+	double
+	cookMs() const
+	{
+		return myCookMs;
+	}
+
+	template <class T>
+	double
+	phaseMs(T phase) const
+	{
+		return myPhaseMs[static_cast<int>(phase)];
+	}
+
+	int32_t
+	getNumInfoCHOPChans() const
+	{
+		return static_cast<int32_t>(InfoChan::Size) + static_cast<int32_t>(myPhaseMs.size());
+	}
+
+	void
+	getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan) const
+	{
+		if (index >= static_cast<int32_t>(InfoChan::Size))
+		{
+			index -= static_cast<int32_t>(InfoChan::Size);
+			chan->name->setString(myPhaseNames[index].c_str());
+			chan->value = static_cast<float>(myPhaseMs[index]);
+			return;
+		}
+
+		switch (static_cast<InfoChan>(index))
+		{
+			case InfoChan::Cook:
+			default:
+			{
+				chan->name->setString("cook_ms");
+				chan->value = static_cast<float>(myCookMs);
+				break;
+			}
+			case InfoChan::P50:
+			{
+				chan->name->setString("cook_p50_ms");
+				chan->value = percentile(0.50);
+				break;
+			}
+			case InfoChan::P95:
+			{
+				chan->name->setString("cook_p95_ms");
+				chan->value = percentile(0.95);
+				break;
+			}
+			case InfoChan::P99:
+			{
+				chan->name->setString("cook_p99_ms");
+				chan->value = percentile(0.99);
+				break;
+			}
+			case InfoChan::Allocated:
+			{
+				chan->name->setString("cook_alloc_bytes");
+				chan->value = static_cast<float>(myAllocated);
+				break;
+			}
+		}
+	}
+
+	// Times a whole cook, put it at the top of execute()
+	class Cook
+	{
+	public:
+		explicit Cook(CookStats& stats) : myStats(stats) { myStats.beginCook(); }
+		~Cook() { myStats.endCook(); }
+
+		Cook(const Cook&) = delete;
+		Cook&	operator=(const Cook&) = delete;
+
+	private:
+		CookStats&	myStats;
+	};
+
+	// Times the enclosing scope as one phase, phases do not nest
+	class Phase
+	{
+	public:
+		template <class T>
+		Phase(CookStats& stats, T phase) : myStats(stats) { myStats.beginPhase(phase); }
+		~Phase() { myStats.endPhase(); }
+
+		Phase(const Phase&) = delete;
+		Phase&	operator=(const Phase&) = delete;
+
+	private:
+		CookStats&	myStats;
+	};
+
+private:
+	typedef std::chrono::steady_clock	Clock;
+
+	enum class InfoChan
+	{
+		Cook,
+		P50,
+		P95,
+		P99,
+		Allocated,
+		Size
+	};
+
+	static double
+	elapsedMs(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	// Nearest rank over the window, all three percentiles come from one sort
+	float
+	percentile(double p) const
+	{
+		if (myNumSamples == 0)
+			return 0.0f;
+
+		if (myPercentilesDirty)
+		{
+			mySorted.assign(mySamples.begin(), mySamples.begin() + myNumSamples);
+			std::sort(mySorted.begin(), mySorted.end());
+			myPercentilesDirty = false;
+		}
+
+		int rank = static_cast<int>(std::ceil(p * myNumSamples)) - 1;
+		rank = std::max(0, std::min(rank, myNumSamples - 1));
+		return mySorted[rank];
+	}
+
+	std::vector<std::string>		myPhaseNames;
+	std::vector<double>				myPhaseMs;
+	double							myCookMs;
+	size_t							myAllocated;
+
+	Clock::time_point				myCookStart;
+	Clock::time_point				myPhaseStart;
+	int								myPhase = 0;
+
+	std::array<float, WindowSize>	mySamples{};
+	int								myNumSamples;
+	int								myNextSample;
+
+	mutable std::vector<float>		mySorted;
+	mutable bool					myPercentilesDirty;
+};
+
+#endif
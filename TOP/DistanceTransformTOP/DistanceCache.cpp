@@ -0,0 +1,226 @@
+#include "DistanceCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	template <class T>
+	void
+		resizeCounted(std::vector<T>& v, size_t size, size_t& allocated)
+	{
+		if (size > v.capacity())
+			allocated += (size - v.capacity()) * sizeof(T);
+		v.resize(size);
+	}
+}
+
+DistanceCache::DistanceCache() :
+	myWidth{ 0 }, myHeight{ 0 }, myValid{ false }, myDirtyTiles{ 0 }, myAllocated{ 0 }
+{
+}
+
+const float*
+DistanceCache::update(const uint8_t* mask, int width, int height, const Settings& settings, WorkerPool* pool)
+{
+	const Settings&	old = mySettings;
+	const bool		same = myValid && width == myWidth && height == myHeight &&
+		settings.isSigned == old.isSigned && settings.maxDistance == old.maxDistance &&
+		settings.scale == old.scale && std::max(settings.tileSize, 1) == old.tileSize;
+
+	mySettings = settings;
+	mySettings.tileSize = std::max(settings.tileSize, 1);
+	myWidth = width;
+	myHeight = height;
+
+	const size_t	size = static_cast<size_t>(width) * height;
+	if (!same)
+	{
+		resizeCounted(myMask, size, myAllocated);
+		resizeCounted(myDistances, size, myAllocated);
+		myRects.assign(1, Rect{ 0, 0, width, height });
+		myDirtyTiles = getNumTiles();
+	}
+	else
+	{
+		findDirtyRects(mask);
+	}
+
+	const int	margin = static_cast<int>(std::ceil(mySettings.maxDistance));
+	for (const Rect& dirty : myRects)
+	{
+		// Every distance within maxDistance of a changed pixel may change
+		const Rect	r{ std::max(dirty.x0 - margin, 0), std::max(dirty.y0 - margin, 0),
+			std::min(dirty.x1 + margin, width), std::min(dirty.y1 + margin, height) };
+		recompute(mask, r, margin, pool);
+	}
+
+	// Only the dirty tiles changed in the mask
+	for (const Rect& dirty : myRects)
+	{
+		for (int y = dirty.y0; y < dirty.y1; ++y)
+		{
+			const size_t	offset = static_cast<size_t>(y) * width + dirty.x0;
+			std::memcpy(myMask.data() + offset, mask + offset, dirty.x1 - dirty.x0);
+		}
+	}
+
+	myValid = true;
+	return myDistances.data();
+}
+
+void
+DistanceCache::clear()
+{
+	myValid = false;
+}
+
+int
+DistanceCache::getDirtyTiles() const
+{
+	return myDirtyTiles;
+}
+
+int
+DistanceCache::getNumTiles() const
+{
+	const int	tile = mySettings.tileSize;
+	return ((myWidth + tile - 1) / tile) * ((myHeight + tile - 1) / tile);
+}
+
+size_t
+DistanceCache::getAllocated()
+{
+	const size_t	bytes = myAllocated;
+	myAllocated = 0;
+	return bytes;
+}
+
+void
+DistanceCache::findDirtyRects(const uint8_t* mask)
+{
+	const int	tile = mySettings.tileSize;
+	const int	tilesX = (myWidth + tile - 1) / tile;
+	const int	tilesY = (myHeight + tile - 1) / tile;
+
+	resizeCounted(myDirty, static_cast<size_t>(tilesX) * tilesY, myAllocated);
+	std::fill(myDirty.begin(), myDirty.end(), 0);
+
+	// A row at a time so both masks are read in order
+	for (int y = 0; y < myHeight; ++y)
+	{
+		const size_t	offset = static_cast<size_t>(y) * myWidth;
+		uint8_t*		dirty = myDirty.data() + static_cast<size_t>(y / tile) * tilesX;
+		for (int tx = 0; tx < tilesX; ++tx)
+		{
+			if (dirty[tx])
+				continue;
+			const int	x0 = tx * tile;
+			const int	x1 = std::min(x0 + tile, myWidth);
+			dirty[tx] = std::memcmp(mask + offset + x0, myMask.data() + offset + x0, x1 - x0) != 0;
+		}
+	}
+
+	myRects.clear();
+	myDirtyTiles = 0;
+
+	// Runs of dirty tiles in each row of tiles. A run that covers the same tiles as one that
+	// ended in the row above extends it
+	myOpen.clear();
+	for (int ty = 0; ty < tilesY; ++ty)
+	{
+		const uint8_t*	dirty = myDirty.data() + static_cast<size_t>(ty) * tilesX;
+		const int		y0 = ty * tile;
+		const int		y1 = std::min(y0 + tile, myHeight);
+
+		myNextOpen.clear();
+		for (int tx = 0; tx < tilesX; ++tx)
+		{
+			if (!dirty[tx])
+				continue;
+
+			int	end = tx;
+			while (end < tilesX && dirty[end])
+				end++;
+			myDirtyTiles += end - tx;
+
+			const int	x0 = tx * tile;
+			const int	x1 = std::min(end * tile, myWidth);
+			size_t		index = myRects.size();
+			for (size_t open : myOpen)
+			{
+				if (myRects[open].x0 == x0 && myRects[open].x1 == x1)
+				{
+					index = open;
+					break;
+				}
+			}
+
+			if (index == myRects.size())
+				myRects.push_back(Rect{ x0, y0, x1, y1 });
+			else
+				myRects[index].y1 = y1;
+			myNextOpen.push_back(index);
+			tx = end;
+		}
+		std::swap(myOpen, myNextOpen);
+	}
+}
+
+void
+DistanceCache::recompute(const uint8_t* mask, const Rect& r, int margin, WorkerPool* pool)
+{
+	const Rect	w{ std::max(r.x0 - margin, 0), std::max(r.y0 - margin, 0),
+		std::min(r.x1 + margin, myWidth), std::min(r.y1 + margin, myHeight) };
+	const int	ww = w.x1 - w.x0;
+	const int	wh = w.y1 - w.y0;
+	const size_t	size = static_cast<size_t>(ww) * wh;
+
+	resizeCounted(myWindowMask, size, myAllocated);
+	resizeCounted(myWindowDistances, size, myAllocated);
+
+	for (int y = 0; y < wh; ++y)
+		std::memcpy(myWindowMask.data() + static_cast<size_t>(y) * ww, mask + static_cast<size_t>(w.y0 + y) * myWidth + w.x0, ww);
+
+	const float	limit = mySettings.maxDistance;
+	const float	scale = mySettings.scale;
+	// No distance inside the window reaches its width + height, one that does was not reached
+	const float	unreached = static_cast<float>(ww + wh);
+
+	if (mySettings.isSigned)
+	{
+		myField.computeSigned(myWindowMask.data(), ww, wh, myWindowDistances.data(),
+							  std::numeric_limits<float>::infinity(), 1.0f, pool);
+	}
+	else
+	{
+		myField.compute(myWindowMask.data(), ww, wh, myWindowDistances.data(), pool);
+	}
+
+	for (int y = r.y0; y < r.y1; ++y)
+	{
+		const float*	in = myWindowDistances.data() + static_cast<size_t>(y - w.y0) * ww + (r.x0 - w.x0);
+		float*			out = myDistances.data() + static_cast<size_t>(y) * myWidth;
+
+		if (mySettings.isSigned)
+		{
+			// Signed distances are half a pixel short of the distance to the other kind
+			for (int x = r.x0; x < r.x1; ++x)
+			{
+				const float	v = in[x - r.x0];
+				const float	d = std::fabs(v) + 0.5f >= unreached ? limit : std::min(std::fabs(v), limit);
+				out[x] = (v < 0.0f ? -d : d) * scale;
+			}
+		}
+		else
+		{
+			for (int x = r.x0; x < r.x1; ++x)
+			{
+				const float	v = in[x - r.x0];
+				out[x] = (v >= unreached ? limit : std::min(v, limit)) * scale;
+			}
+		}
+	}
+}
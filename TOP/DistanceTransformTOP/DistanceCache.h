@@ -0,0 +1,91 @@
+#ifndef __DistanceCache__
+#define __DistanceCache__
+
+#include "DistanceField.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class WorkerPool;
+
+/*
+Keeps the last mask and distance field and only recomputes the part a new mask changed.
+Distances are limited to a maximum distance D, so a pixel that changed can only move the
+distances within D of it:
+	- The mask is compared with the cached one in tiles. A tile that differs is dirty.
+	- Dirty tiles are merged into runs along each row of tiles, and runs with the same
+		columns in consecutive rows into rectangles.
+	- Every pixel within D of a rectangle is recomputed with DistanceField on a window that
+		reaches D further, which holds every zero pixel that can be within D of them.
+Anything else keeps its cached distance. A change of size or settings recomputes all of it.
+
+The window is smaller than the image, so a pixel with nothing of the other kind in it gets
+a distance of at least the window width + height. That is recognised and set to D, which
+keeps the result the same as a full transform clamped to D.
+*/
+class DistanceCache
+{
+public:
+	struct Settings
+	{
+		// Signed distances as DistanceField::computeSigned() gives them
+		bool	isSigned = false;
+		// The maximum distance D, in pixels
+		float	maxDistance = 32.0f;
+		// Applied to the clamped distance, 1 / maxDistance normalizes it
+		float	scale = 1.0f;
+		int		tileSize = 32;
+	};
+
+	DistanceCache();
+
+	// mask is width x height, row after row. Returns the distances, width x height
+	const float*	update(const uint8_t* mask, int width, int height, const Settings& settings, WorkerPool* pool = nullptr);
+
+	// Drops the cache, the next update() recomputes everything
+	void			clear();
+
+	// Tiles found dirty by the last update(), all of them when it recomputed everything
+	int				getDirtyTiles() const;
+
+	int				getNumTiles() const;
+
+	// Bytes allocated since the last call
+	size_t			getAllocated();
+
+private:
+	struct Rect
+	{
+		int	x0, y0, x1, y1;
+	};
+
+	void	findDirtyRects(const uint8_t* mask);
+
+	// Recomputes the distances inside r from the mask inside r grown by margin
+	void	recompute(const uint8_t* mask, const Rect& r, int margin, WorkerPool* pool);
+
+	DistanceField			myField;
+
+	std::vector<uint8_t>	myMask;
+	std::vector<float>		myDistances;
+	int						myWidth;
+	int						myHeight;
+	Settings				mySettings;
+	bool					myValid;
+
+	std::vector<Rect>		myRects;
+	// Rectangles that reach the bottom of the previous and current row of tiles
+	std::vector<size_t>		myOpen;
+	std::vector<size_t>		myNextOpen;
+	std::vector<uint8_t>	myDirty;
+	int						myDirtyTiles;
+
+	// Window the dirty rectangles are recomputed in
+	std::vector<uint8_t>	myWindowMask;
+	std::vector<float>		myWindowDistances;
+
+	size_t					myAllocated;
+};
+
+#endif // !__DistanceCache__
@@ -0,0 +1,325 @@
+#include "DistanceField.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DISTANCEFIELD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// Splits [0, size) in one band per task and calls fn(band, begin, end) for each of them.
+	// Band starts are multiples of align so vector loops stay aligned with each other
+	template <class Fn>
+	void
+		forEachBand(WorkerPool* pool, int size, int align, const Fn& fn)
+	{
+		const int	numBands = pool ? std::max(std::min(pool->getNumThreads(), size / align), 1) : 1;
+		if (numBands <= 1)
+		{
+			fn(0, 0, size);
+			return;
+		}
+
+		pool->run(numBands, [&](int band)
+		{
+			const int	begin = static_cast<int>(static_cast<int64_t>(size / align) * band / numBands) * align;
+			const int	end = band == numBands - 1 ? size :
+				static_cast<int>(static_cast<int64_t>(size / align) * (band + 1) / numBands) * align;
+			fn(band, begin, end);
+		});
+	}
+
+	// Lower envelope of the parabolas (x - q)^2 + f[q]. v gets the roots of the parabolas
+	// in the envelope and z the x where each of them starts to be the lowest
+	void
+		lowerEnvelope(const int32_t* f, int width, int32_t* v, double* z)
+	{
+		int	k = 0;
+		v[0] = 0;
+		z[0] = -std::numeric_limits<double>::infinity();
+		z[1] = std::numeric_limits<double>::infinity();
+
+		for (int q = 1; q < width; ++q)
+		{
+			double	s;
+			while (true)
+			{
+				const int	p = v[k];
+				s = (static_cast<double>(f[q]) + static_cast<double>(q) * q - f[p] - static_cast<double>(p) * p) / (2.0 * (q - p));
+				if (s > z[k] || k == 0)
+					break;
+				k--;
+			}
+
+			// With k == 0 the new parabola may still be lower everywhere
+			if (s <= z[k])
+			{
+				v[k] = q;
+			}
+			else
+			{
+				k++;
+				v[k] = q;
+				z[k] = s;
+			}
+			z[k + 1] = std::numeric_limits<double>::infinity();
+		}
+	}
+
+	// Walks the envelope built by lowerEnvelope(), q has to grow between calls with the same k
+	inline float
+		envelopeAt(const int32_t* f, const int32_t* v, const double* z, int& k, int q)
+	{
+		while (z[k + 1] < q)
+			k++;
+		const int64_t	dx = q - v[k];
+		return std::sqrt(static_cast<float>(dx * dx + f[v[k]]));
+	}
+
+#ifdef DISTANCEFIELD_SSE2
+	// 4 masks of 32 bits, all ones where the 4 bytes at p are 0
+	inline __m128i
+		zeroMask4(const uint8_t* p)
+	{
+		int32_t	bytes;
+		std::memcpy(&bytes, p, sizeof(bytes));
+		__m128i	m = _mm_cmpeq_epi8(_mm_cvtsi32_si128(bytes), _mm_setzero_si128());
+		m = _mm_unpacklo_epi8(m, m);
+		return _mm_unpacklo_epi16(m, m);
+	}
+#endif
+}
+
+DistanceField::DistanceField()
+{
+}
+
+void
+DistanceField::compute(const uint8_t* mask, int width, int height, float* distances, WorkerPool* pool)
+{
+	if (width <= 0 || height <= 0)
+		return;
+
+	prepare(width, pool);
+
+	// Columns in bands of whole vectors, rows in any bands
+	forEachBand(pool, width, 4, [&](int, int begin, int end)
+	{
+		columnPass(mask, width, height, distances, begin, end);
+	});
+
+	forEachBand(pool, height, 1, [&](int band, int begin, int end)
+	{
+		for (int y = begin; y < end; ++y)
+			rowPass(distances + static_cast<size_t>(y) * width, width, myEnvelopes[band]);
+	});
+}
+
+void
+DistanceField::computeSigned(const uint8_t* mask, int width, int height, float* distances, float limit, float scale, WorkerPool* pool)
+{
+	if (width <= 0 || height <= 0)
+		return;
+
+	prepare(width, pool);
+
+	forEachBand(pool, width, 4, [&](int, int begin, int end)
+	{
+		signedColumnPass(mask, width, height, distances, begin, end);
+	});
+
+	forEachBand(pool, height, 1, [&](int band, int begin, int end)
+	{
+		for (int y = begin; y < end; ++y)
+		{
+			const size_t	offset = static_cast<size_t>(y) * width;
+			signedRowPass(mask + offset, distances + offset, width, limit, scale, myEnvelopes[band]);
+		}
+	});
+}
+
+void
+DistanceField::prepare(int width, WorkerPool* pool)
+{
+	const int	numTasks = pool ? pool->getNumThreads() : 1;
+	if (static_cast<int>(myEnvelopes.size()) < numTasks)
+		myEnvelopes.resize(numTasks);
+
+	for (Envelope& envelope : myEnvelopes)
+	{
+		envelope.values.resize(width);
+		envelope.otherValues.resize(width);
+		envelope.roots.resize(width);
+		envelope.bounds.resize(static_cast<size_t>(width) + 1);
+	}
+}
+
+void
+DistanceField::columnPass(const uint8_t* mask, int width, int height, float* distances, int begin, int end) const
+{
+	// Larger than any distance inside the image, and still exact once squared in 32 bits
+	const float	unreached = static_cast<float>(width + height);
+
+	// Down: distance to the nearest zero above or on the pixel
+	for (int y = 0; y < height; ++y)
+	{
+		const uint8_t*	in = mask + static_cast<size_t>(y) * width;
+		float*			out = distances + static_cast<size_t>(y) * width;
+		const float*	above = y ? out - width : nullptr;
+		int				x = begin;
+
+#ifdef DISTANCEFIELD_SSE2
+		const __m128	one = _mm_set1_ps(1.0f);
+		const __m128	unreachedV = _mm_set1_ps(unreached);
+		for (; x + 4 <= end; x += 4)
+		{
+			const __m128	prev = above ? _mm_add_ps(_mm_loadu_ps(above + x), one) : unreachedV;
+			const __m128	zero = _mm_castsi128_ps(zeroMask4(in + x));
+			_mm_storeu_ps(out + x, _mm_andnot_ps(zero, _mm_min_ps(prev, unreachedV)));
+		}
+#endif
+		for (; x < end; ++x)
+			out[x] = in[x] == 0 ? 0.0f : std::min(above ? above[x] + 1.0f : unreached, unreached);
+	}
+
+	// Up: keep the nearer of the zero above and the zero below
+	for (int y = height - 2; y >= 0; --y)
+	{
+		float*			out = distances + static_cast<size_t>(y) * width;
+		const float*	below = out + width;
+		int				x = begin;
+
+#ifdef DISTANCEFIELD_SSE2
+		const __m128	one = _mm_set1_ps(1.0f);
+		for (; x + 4 <= end; x += 4)
+			_mm_storeu_ps(out + x, _mm_min_ps(_mm_loadu_ps(out + x), _mm_add_ps(_mm_loadu_ps(below + x), one)));
+#endif
+		for (; x < end; ++x)
+			out[x] = std::min(out[x], below[x] + 1.0f);
+	}
+}
+
+void
+DistanceField::signedColumnPass(const uint8_t* mask, int width, int height, float* distances, int begin, int end) const
+{
+	const float	unreached = static_cast<float>(width + height);
+
+	// The nearest pixel of the other kind is 1 away when the neighbour is of the other kind,
+	// otherwise it is the neighbour's one plus 1. Runs of pixels of one kind never need more
+
+	// Down
+	for (int y = 0; y < height; ++y)
+	{
+		const uint8_t*	in = mask + static_cast<size_t>(y) * width;
+		float*			out = distances + static_cast<size_t>(y) * width;
+		int				x = begin;
+
+		if (y == 0)
+		{
+			std::fill(out + begin, out + end, unreached);
+			continue;
+		}
+
+		const uint8_t*	inAbove = in - width;
+		const float*	above = out - width;
+
+#ifdef DISTANCEFIELD_SSE2
+		const __m128	one = _mm_set1_ps(1.0f);
+		const __m128	unreachedV = _mm_set1_ps(unreached);
+		for (; x + 4 <= end; x += 4)
+		{
+			const __m128	same = _mm_castsi128_ps(_mm_cmpeq_epi32(zeroMask4(in + x), zeroMask4(inAbove + x)));
+			const __m128	prev = _mm_min_ps(_mm_add_ps(_mm_loadu_ps(above + x), one), unreachedV);
+			_mm_storeu_ps(out + x, _mm_or_ps(_mm_and_ps(same, prev), _mm_andnot_ps(same, one)));
+		}
+#endif
+		for (; x < end; ++x)
+			out[x] = (in[x] == 0) == (inAbove[x] == 0) ? std::min(above[x] + 1.0f, unreached) : 1.0f;
+	}
+
+	// Up
+	for (int y = height - 2; y >= 0; --y)
+	{
+		const uint8_t*	in = mask + static_cast<size_t>(y) * width;
+		const uint8_t*	inBelow = in + width;
+		float*			out = distances + static_cast<size_t>(y) * width;
+		const float*	below = out + width;
+		int				x = begin;
+
+#ifdef DISTANCEFIELD_SSE2
+		const __m128	one = _mm_set1_ps(1.0f);
+		for (; x + 4 <= end; x += 4)
+		{
+			const __m128	same = _mm_castsi128_ps(_mm_cmpeq_epi32(zeroMask4(in + x), zeroMask4(inBelow + x)));
+			const __m128	next = _mm_min_ps(_mm_loadu_ps(out + x), _mm_add_ps(_mm_loadu_ps(below + x), one));
+			_mm_storeu_ps(out + x, _mm_or_ps(_mm_and_ps(same, next), _mm_andnot_ps(same, one)));
+		}
+#endif
+		for (; x < end; ++x)
+			out[x] = (in[x] == 0) == (inBelow[x] == 0) ? std::min(out[x], below[x] + 1.0f) : 1.0f;
+	}
+}
+
+void
+DistanceField::rowPass(float* row, int width, Envelope& envelope) const
+{
+	int32_t*	f = envelope.values.data();
+	int32_t*	v = envelope.roots.data();
+	double*		z = envelope.bounds.data();
+
+	// Squared column distances, exact integers
+	for (int q = 0; q < width; ++q)
+	{
+		const int32_t	g = static_cast<int32_t>(row[q]);
+		f[q] = g * g;
+	}
+
+	lowerEnvelope(f, width, v, z);
+
+	int	k = 0;
+	for (int q = 0; q < width; ++q)
+		row[q] = envelopeAt(f, v, z, k, q);
+}
+
+void
+DistanceField::signedRowPass(const uint8_t* maskRow, float* row, int width, float limit, float scale, Envelope& envelope) const
+{
+	// The column distances go to the envelope of the kind of pixel they lead to, pixels of
+	// that kind are 0 in it
+	int32_t*	toZero = envelope.values.data();
+	int32_t*	toSet = envelope.otherValues.data();
+	int32_t*	v = envelope.roots.data();
+	double*		z = envelope.bounds.data();
+
+	for (int q = 0; q < width; ++q)
+	{
+		const int32_t	g = static_cast<int32_t>(row[q]);
+		toZero[q] = maskRow[q] ? g * g : 0;
+		toSet[q] = maskRow[q] ? 0 : g * g;
+	}
+
+	// Half a pixel less puts 0 on the edge between the two kinds
+	lowerEnvelope(toZero, width, v, z);
+	int	k = 0;
+	for (int q = 0; q < width; ++q)
+	{
+		const float	d = envelopeAt(toZero, v, z, k, q);
+		if (maskRow[q])
+			row[q] = std::max(0.5f - d, -limit) * scale;
+	}
+
+	lowerEnvelope(toSet, width, v, z);
+	k = 0;
+	for (int q = 0; q < width; ++q)
+	{
+		const float	d = envelopeAt(toSet, v, z, k, q);
+		if (!maskRow[q])
+			row[q] = std::min(d - 0.5f, limit) * scale;
+	}
+}
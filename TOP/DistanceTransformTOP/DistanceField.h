@@ -0,0 +1,64 @@
+#ifndef __DistanceField__
+#define __DistanceField__
+
+#include <cstdint>
+#include <vector>
+
+class WorkerPool;
+
+/*
+Exact Euclidean distance transform, Felzenszwalb and Huttenlocher, "Distance Transforms of
+Sampled Functions" (2012). The 2D transform splits in two 1D passes:
+	- Columns:	Distance to the nearest zero pixel in the same column. Two scans, down and up,
+		that go a row at a time and handle 4 columns per instruction with SSE2.
+	- Rows:		Lower envelope of the parabolas rooted at each column distance, which gives the
+		exact distance to the nearest zero pixel anywhere in linear time.
+Each pass is split in bands across the threads of a WorkerPool, columns for the first pass
+and rows for the second.
+
+Unlike the mask approximations the result is exact for any distance. A pixel with no zero
+pixel anywhere in the image gets width + height.
+
+computeSigned() measures every pixel to the nearest pixel of the other kind in the same two
+passes: the column scans track the distance to the other kind whichever kind the pixel is,
+and each row builds one envelope per kind.
+*/
+class DistanceField
+{
+public:
+	DistanceField();
+
+	// Distance in pixels from every pixel of mask to the nearest pixel that is 0. mask and
+	// distances are width x height, row after row
+	void	compute(const uint8_t* mask, int width, int height, float* distances, WorkerPool* pool = nullptr);
+
+	// Signed distance to the edge between zero and nonzero pixels, negative on nonzero pixels.
+	// It is clamped to [-limit, limit] then multiplied by scale
+	void	computeSigned(const uint8_t* mask, int width, int height, float* distances,
+						  float limit, float scale, WorkerPool* pool = nullptr);
+
+private:
+	struct Envelope
+	{
+		std::vector<int32_t>	values;
+		std::vector<int32_t>	otherValues;
+		std::vector<int32_t>	roots;
+		std::vector<double>		bounds;
+	};
+
+	// Sizes the scratch of every task for rows of width pixels
+	void	prepare(int width, WorkerPool* pool);
+
+	void	columnPass(const uint8_t* mask, int width, int height, float* distances, int begin, int end) const;
+
+	void	signedColumnPass(const uint8_t* mask, int width, int height, float* distances, int begin, int end) const;
+
+	void	rowPass(float* row, int width, Envelope& envelope) const;
+
+	void	signedRowPass(const uint8_t* maskRow, float* row, int width, float limit, float scale, Envelope& envelope) const;
+
+	// One per task so the row pass does not allocate
+	std::vector<Envelope>	myEnvelopes;
+};
+
+#endif // !__DistanceField__
@@ -15,6 +15,7 @@
 #include "DistanceTransformTOP.h"
 
 #include <cassert>
+#include <limits>
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
 
@@ -77,15 +78,22 @@ DestroyTOPInstance(TD::TOP_CPlusPlusBase* instance, TD::TOP_Context *context)
 
 DistanceTransformTOP::DistanceTransformTOP(const TD::OP_NodeInfo*, TD::TOP_Context *context) :
 	myFrame{ new cv::Mat() },
+	myChannel{ new cv::Mat() },
+	myDistances{ new cv::Mat() },
 	myExecuteCount{0},
-	myPrevDownRes{nullptr},
-	myContext{context}
+	myContext{context},
+	myFrameDownRes{nullptr},
+	myDownloads{ 1 },
+	myCookStats{ "download", "compute", "upload" },
+	myIncremental{ false }
 {
 }
 
 DistanceTransformTOP::~DistanceTransformTOP()
 {
 	delete myFrame;
+	delete myChannel;
+	delete myDistances;
 }
 
 void
@@ -99,37 +107,160 @@ void
 DistanceTransformTOP::execute(TD::TOP_Output* output, const TD::OP_Inputs* inputs, void*)
 {
 	using namespace cv;
-	
+
+	CookStats::Cook	cook(myCookStats);
+
+	ModeMenuItems mode = static_cast<ModeMenuItems>(inputs->getParInt("Mode"));
+	EngineMenuItems engine = static_cast<EngineMenuItems>(inputs->getParInt("Engine"));
+	SignedrangeMenuItems signedRange = static_cast<SignedrangeMenuItems>(inputs->getParInt("Signedrange"));
+	bool isSigned = mode == ModeMenuItems::Signed;
+	// The signed field always comes from the exact engine
+	bool useOpencv = !isSigned && engine == EngineMenuItems::Opencv;
+	inputs->enablePar("Engine", !isSigned);
+	inputs->enablePar("Distancetype", useOpencv);
+	inputs->enablePar("Masksize", useOpencv);
+	inputs->enablePar("Normalize", !isSigned);
+	// Incremental updates rely on the distances being limited, which the OpenCV engine does not do
+	bool incremental = !useOpencv && inputs->getParInt("Incremental");
+	inputs->enablePar("Signedrange", isSigned);
+	inputs->enablePar("Maxdistance", incremental || (isSigned && signedRange != SignedrangeMenuItems::None));
+	inputs->enablePar("Incremental", !useOpencv);
+	inputs->enablePar("Tilesize", incremental);
+	inputs->enablePar("Threads", !useOpencv);
+	myIncremental = incremental;
+
+	myCookStats.beginPhase(CookPhase::Download);
 	inputTopToMat(inputs);
+	myCookStats.endPhase();
 	if (myFrame->empty())
 		return;
 
-	if (!myPrevDownRes)
-		return;
+	bool isHalf = static_cast<OutputformatMenuItems>(inputs->getParInt("Outputformat")) == OutputformatMenuItems::Float16;
 
 	TD::TOP_UploadInfo info;
-	info.textureDesc.width = myPrevDownRes->textureDesc.width;
-	info.textureDesc.height = myPrevDownRes->textureDesc.height;
+	info.textureDesc.width = myFrame->cols;
+	info.textureDesc.height = myFrame->rows;
 	info.textureDesc.texDim = TD::OP_TexDim::e2D;
-	info.textureDesc.pixelFormat = TD::OP_PixelFormat::Mono32Float;
+	info.textureDesc.pixelFormat = isHalf ? TD::OP_PixelFormat::Mono16Float : TD::OP_PixelFormat::Mono32Float;
 	info.colorBufferIndex = 0;
 
 	int distanceType = getType(static_cast<DistancetypeMenuItems>(inputs->getParInt("Distancetype")));
 	int maskSize = getMask(static_cast<MasksizeMenuItems>(inputs->getParInt("Masksize")));
 
-	distanceTransform(*myFrame, *myFrame, distanceType, maskSize);
-	
-	bool donormalize = inputs->getParInt("Normalize") ? true : false;
+	size_t imgsize = myFrame->total() * (isHalf ? sizeof(uint16_t) : sizeof(float));
+	TD::OP_SmartRef<TD::TOP_Buffer> buf = myContext->createOutputBuffer(imgsize, TD::TOP_BufferFlags::None, nullptr);
+
+	myCookStats.beginPhase(CookPhase::Compute);
+	// 32 bit results are written straight into the output buffer. 16 bit ones go through
+	// myDistances, which is kept between cooks and only reallocated when the size changes
+	Mat distances;
+	if (isHalf)
+	{
+		if (myDistances->size() != myFrame->size())
+			myCookStats.addAllocated(myFrame->total() * sizeof(float));
+		myDistances->create(myFrame->size(), CV_32F);
+		distances = *myDistances;
+	}
+	else
+	{
+		distances = Mat(myFrame->rows, myFrame->cols, CV_32F, buf->data);
+	}
+
+	float maxDistance = static_cast<float>(inputs->getParDouble("Maxdistance"));
+	bool donormalize = !isSigned && inputs->getParInt("Normalize");
+
+	if (incremental)
+	{
+		// Distances are limited to Max Distance, so only the tiles that changed since the last
+		// cook and what is within Max Distance of them are recomputed
+		DistanceCache::Settings settings;
+		settings.isSigned = isSigned;
+		settings.maxDistance = maxDistance;
+		settings.scale = (isSigned ? signedRange == SignedrangeMenuItems::Normalize : donormalize) ? 1.0f / maxDistance : 1.0f;
+		settings.tileSize = inputs->getParInt("Tilesize");
+
+		myWorkerPool.setNumThreads(inputs->getParInt("Threads"));
+		const float* cached = myDistanceCache.update(myFrame->ptr<uint8_t>(), myFrame->cols, myFrame->rows, settings, &myWorkerPool);
+		memcpy(distances.ptr<float>(), cached, myFrame->total() * sizeof(float));
+		myCookStats.addAllocated(myDistanceCache.getAllocated());
+
+		// Normalized by Max Distance already
+		donormalize = false;
+	}
+	else if (isSigned)
+	{
+		// Clamp and normalize happen as the distances are written
+		float limit = signedRange == SignedrangeMenuItems::None ? std::numeric_limits<float>::infinity() : maxDistance;
+		float scale = signedRange == SignedrangeMenuItems::Normalize ? 1.0f / maxDistance : 1.0f;
+
+		myWorkerPool.setNumThreads(inputs->getParInt("Threads"));
+		myDistanceField.computeSigned(myFrame->ptr<uint8_t>(), myFrame->cols, myFrame->rows, distances.ptr<float>(), limit, scale, &myWorkerPool);
+	}
+	else if (engine == EngineMenuItems::Exact)
+	{
+		myWorkerPool.setNumThreads(inputs->getParInt("Threads"));
+		myDistanceField.compute(myFrame->ptr<uint8_t>(), myFrame->cols, myFrame->rows, distances.ptr<float>(), &myWorkerPool);
+	}
+	else
+	{
+		distanceTransform(*myFrame, distances, distanceType, maskSize);
+	}
 
 	if (donormalize)
-		normalize(*myFrame, *myFrame, 0, 1.0, NORM_MINMAX);
+		normalize(distances, distances, 0, 1.0, NORM_MINMAX);
+	myCookStats.endPhase();
 
-	cvMatToOutput(output, info);
+	myCookStats.beginPhase(CookPhase::Upload);
+	cvMatToOutput(distances, buf, output, info);
+	myCookStats.addAllocated(imgsize);
+	myCookStats.endPhase();
 }
 
 void
 DistanceTransformTOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 {
+	{
+		TD::OP_StringParameter p;
+		p.name = "Mode";
+		p.label = "Mode";
+		p.page = "Transform";
+		p.defaultValue = "Unsigned";
+		std::array<const char*, 2> Names =
+		{
+			"Unsigned",
+			"Signed"
+		};
+		std::array<const char*, 2> Labels =
+		{
+			"Unsigned",
+			"Signed"
+		};
+		TD::OP_ParAppendResult res = manager->appendMenu(p, int(Names.size()), Names.data(), Labels.data());
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_StringParameter p;
+		p.name = "Engine";
+		p.label = "Engine";
+		p.page = "Transform";
+		p.defaultValue = "Opencv";
+		std::array<const char*, 2> Names =
+		{
+			"Opencv",
+			"Exact"
+		};
+		std::array<const char*, 2> Labels =
+		{
+			"OpenCV",
+			"Exact"
+		};
+		TD::OP_ParAppendResult res = manager->appendMenu(p, int(Names.size()), Names.data(), Labels.data());
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
 	{
 		TD::OP_StringParameter p;
 		p.name = "Distancetype";
@@ -188,6 +319,73 @@ DistanceTransformTOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 		assert(res == TD::OP_ParAppendResult::Success);
 	}
 
+	{
+		TD::OP_StringParameter p;
+		p.name = "Signedrange";
+		p.label = "Signed Range";
+		p.page = "Transform";
+		p.defaultValue = "None";
+		std::array<const char*, 3> Names =
+		{
+			"None",
+			"Clamp",
+			"Normalize"
+		};
+		std::array<const char*, 3> Labels =
+		{
+			"None",
+			"Clamp",
+			"Normalize"
+		};
+		TD::OP_ParAppendResult res = manager->appendMenu(p, int(Names.size()), Names.data(), Labels.data());
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter np;
+		np.name = "Maxdistance";
+		np.label = "Max Distance";
+		np.page = "Transform";
+		np.defaultValues[0] = 32.0;
+		np.minSliders[0] = 1.0;
+		np.maxSliders[0] = 256.0;
+		np.minValues[0] = 0.001;
+		np.clampMins[0] = true;
+		TD::OP_ParAppendResult res = manager->appendFloat(np);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Incremental";
+		p.label = "Incremental";
+		p.page = "Transform";
+		p.defaultValues[0] = false;
+
+		TD::OP_ParAppendResult res = manager->appendToggle(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter np;
+		np.name = "Tilesize";
+		np.label = "Tile Size";
+		np.page = "Transform";
+		np.defaultValues[0] = 32;
+		np.minSliders[0] = 8.0;
+		np.maxSliders[0] = 128.0;
+		np.minValues[0] = 1.0;
+		np.maxValues[0] = 1024.0;
+		np.clampMins[0] = true;
+		np.clampMaxes[0] = true;
+		TD::OP_ParAppendResult res = manager->appendInt(np);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
 	{
 		TD::OP_StringParameter p;
 		p.name = "Channel";
@@ -212,23 +410,105 @@ DistanceTransformTOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 
 		assert(res == TD::OP_ParAppendResult::Success);
 	}
+
+	{
+		TD::OP_StringParameter p;
+		p.name = "Outputformat";
+		p.label = "Output Format";
+		p.page = "Transform";
+		p.defaultValue = "Float32";
+		std::array<const char*, 2> Names =
+		{
+			"Float32",
+			"Float16"
+		};
+		std::array<const char*, 2> Labels =
+		{
+			"32-bit float",
+			"16-bit float"
+		};
+		TD::OP_ParAppendResult res = manager->appendMenu(p, int(Names.size()), Names.data(), Labels.data());
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter np;
+		np.name = "Downloaddepth";
+		np.label = "Download Depth";
+		np.page = "Transform";
+		np.defaultValues[0] = 1;
+		np.minSliders[0] = 0.0;
+		np.maxSliders[0] = 4.0;
+		np.minValues[0] = 0.0;
+		np.maxValues[0] = 8.0;
+		np.clampMins[0] = true;
+		np.clampMaxes[0] = true;
+		TD::OP_ParAppendResult res = manager->appendInt(np);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter np;
+		np.name = "Threads";
+		np.label = "Threads";
+		np.page = "Transform";
+		np.defaultValues[0] = 1;
+		np.minSliders[0] = 1.0;
+		np.maxSliders[0] = 16.0;
+		np.minValues[0] = 1.0;
+		np.maxValues[0] = 64.0;
+		np.clampMins[0] = true;
+		np.clampMaxes[0] = true;
+		TD::OP_ParAppendResult res = manager->appendInt(np);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+}
+
+int32_t
+DistanceTransformTOP::getNumInfoCHOPChans(void*)
+{
+	return static_cast<int32_t>(InfoChopChan::Size) + myDownloads.getNumInfoCHOPChans() + myCookStats.getNumInfoCHOPChans();
 }
 
 void
-DistanceTransformTOP::cvMatToOutput(TD::TOP_Output* out, TD::TOP_UploadInfo info) const
+DistanceTransformTOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
 {
-	size_t	height = info.textureDesc.height;
-	size_t	width = info.textureDesc.width;
-	size_t imgsize = 1 * height * width * sizeof(float);
+	if (index < static_cast<int32_t>(InfoChopChan::Size))
+	{
+		switch (static_cast<InfoChopChan>(index))
+		{
+			case InfoChopChan::DirtyTiles:
+			default:
+			{
+				chan->name->setString("dirty_tiles");
+				chan->value = myIncremental ? static_cast<float>(myDistanceCache.getDirtyTiles()) : 0.0f;
+				break;
+			}
+		}
+		return;
+	}
+	index -= static_cast<int32_t>(InfoChopChan::Size);
 
-	TD::OP_SmartRef<TD::TOP_Buffer> buf = myContext->createOutputBuffer(imgsize, TD::TOP_BufferFlags::None, nullptr);
-	float* pixel = static_cast<float*>(buf->data);
+	// The downloads and cook statistics go after our own channels
+	if (index < myDownloads.getNumInfoCHOPChans())
+		myDownloads.getInfoCHOPChan(index, chan);
+	else
+		myCookStats.getInfoCHOPChan(index - myDownloads.getNumInfoCHOPChans(), chan);
+}
 
-	cv::resize(*myFrame, *myFrame, cv::Size(width, height));
-	cv::flip(*myFrame, *myFrame, 0);
-	float* data = static_cast<float*>(static_cast<void*>(myFrame->data));
+void
+DistanceTransformTOP::cvMatToOutput(const cv::Mat& M, TD::OP_SmartRef<TD::TOP_Buffer>& buf, TD::TOP_Output* out, TD::TOP_UploadInfo info) const
+{
+	// 32 bit results are already in buf
+	if (info.textureDesc.pixelFormat == TD::OP_PixelFormat::Mono16Float)
+	{
+		cv::Mat half(M.rows, M.cols, CV_16F, buf->data);
+		M.convertTo(half, CV_16F);
+	}
 
-	memcpy(pixel, data, imgsize);
 	out->uploadBuffer(&buf, info, nullptr);
 }
 
@@ -239,46 +519,58 @@ DistanceTransformTOP::inputTopToMat(const TD::OP_Inputs* in)
 	if (!top)
 	{
 		*myFrame = cv::Mat();
+		myDownloads.clear();
 		return;
 	}
 
 	int chan = in->getParInt("Channel");
 
+	// The transform gives the same result on a flipped image, so the frame stays in
+	// TouchDesigner's bottom up row order and neither the download nor the output is flipped.
+	// The red channel can be downloaded on its own, the others are picked out of RGBA8
 	TD::OP_TOPInputDownloadOptions	opts;
-	opts.verticalFlip = true;
-	opts.pixelFormat = TD::OP_PixelFormat::RGBA8Fixed;
+	opts.verticalFlip = false;
+	opts.pixelFormat = static_cast<ChannelMenuItems>(chan) == ChannelMenuItems::R ?
+		TD::OP_PixelFormat::Mono8Fixed : TD::OP_PixelFormat::RGBA8Fixed;
 
-	TD::OP_SmartRef<TD::OP_TOPDownloadResult> downRes = top->downloadTexture(opts, nullptr);
+	myDownloads.setDepth(in->getParInt("Downloaddepth"));
+	TD::OP_SmartRef<TD::OP_TOPDownloadResult> downRes = myDownloads.push(top, opts);
 
-	if (!downRes)
-	{
-		*myFrame = cv::Mat();
+	// The download is kept until the next cook since myFrame may point into it
+	*myFrame = cv::Mat();
+	myFrameDownRes = std::move(downRes);
+
+	if (!myFrameDownRes)
 		return;
-	}
 
-	if (myPrevDownRes)
-	{
-		uint8_t* pixel = (uint8_t*)myPrevDownRes->getData();
+	uint8_t* pixel = (uint8_t*)myFrameDownRes->getData();
+
+	if (!pixel)
+		return;
+
+	int	height = myFrameDownRes->textureDesc.height;
+	int	width = myFrameDownRes->textureDesc.width;
 
-		if (!pixel)
+	if (myFrameDownRes->textureDesc.pixelFormat == TD::OP_PixelFormat::Mono8Fixed)
+	{
+		size_t stride = height ? static_cast<size_t>(myFrameDownRes->size / height) : 0;
+		if (stride == static_cast<size_t>(width))
 		{
-			*myFrame = cv::Mat();
+			*myFrame = cv::Mat(height, width, CV_8UC1, pixel);
 			return;
 		}
 
-		int	height = top->textureDesc.height;
-		int	width = top->textureDesc.width;
-
-		*myFrame = cv::Mat(height, width, CV_8UC1);
-		uint8_t* data = (uint8_t*)myFrame->data;
-		for (int i = 0; i < height; i += 1) {
-			for (int j = 0; j < width; j += 1) {
-				int pixelN = i * width + j;
-				int index = 4 * pixelN + chan;
-				data[pixelN] = pixel[index];
-			}
-		}
+		// Padded rows are packed so the exact engine can walk the frame as one array
+		if (myChannel->size() != cv::Size(width, height))
+			myCookStats.addAllocated(static_cast<size_t>(width) * height);
+		cv::Mat(height, width, CV_8UC1, pixel, stride).copyTo(*myChannel);
+	}
+	else
+	{
+		if (myChannel->size() != cv::Size(width, height))
+			myCookStats.addAllocated(static_cast<size_t>(width) * height);
+		myChannel->create(height, width, CV_8UC1);
+		extractChannel(pixel, myChannel->ptr<uint8_t>(), myChannel->total(), chan);
 	}
-	myPrevDownRes = std::move(downRes);
-	
+	*myFrame = *myChannel;
 }
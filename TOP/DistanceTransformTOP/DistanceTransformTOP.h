@@ -16,12 +16,30 @@
 #define __DistanceTransformTOP__
 
 #include "TOP_CPlusPlusBase.h"
-
-#include <opencv2\core.hpp>
+#include "CookStats.h"
+#include "DownloadQueue.h"
+#include "DistanceField.h"
+#include "DistanceCache.h"
+#include "ChannelExtract.h"
+#include "WorkerPool.h"
+
+#include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
 #include <string>
 
 #pragma region Menus
+enum class ModeMenuItems
+{
+	Unsigned,
+	Signed
+};
+
+enum class EngineMenuItems
+{
+	Opencv,
+	Exact
+};
+
 enum class DistancetypeMenuItems
 {
 	L1,
@@ -42,6 +60,19 @@ enum class DownloadtypeMenuItems
 	Instant
 };
 
+enum class SignedrangeMenuItems
+{
+	None,
+	Clamp,
+	Normalize
+};
+
+enum class OutputformatMenuItems
+{
+	Float32,
+	Float16
+};
+
 enum class ChannelMenuItems
 {
 	R,
@@ -56,12 +87,38 @@ enum class ChannelMenuItems
 This example implements a TOP to calculate the distance transform using openCV.
 
 It takes the following parameters:
+	- Mode:	One of [Unsigned, Signed]. Unsigned is the distance of nonzero pixels to the nearest
+		zero pixel. Signed is the distance of every pixel to the edge between zero and nonzero
+		pixels, negative on nonzero pixels, in one pass of the Exact engine.
+	- Engine:	One of [OpenCV, Exact]. OpenCV uses the distance type and mask size below,
+		Exact computes the exact Euclidean distance with the separable transform in
+		DistanceField.h, split across Threads.
 	- Distance Type:        One of [L1, L2, C], which determines how to calculate the distance.
 	- Mask Size:        One of [3x3, 5x5, Precise], which determines the size of the transform mask.
-	- Normalize:	If On, normalize the output image.
+	- Normalize:	If On, normalize the output image. Unsigned mode only.
+	- Signed Range:	One of [None, Clamp, Normalize]. Clamp limits the signed distance to
+		[-Max Distance, Max Distance], Normalize also divides it by Max Distance.
+	- Max Distance:	Distance in pixels Signed Range and Incremental clamp to.
+	- Incremental:	If On, only the tiles of the input that changed since the last cook and
+		the pixels within Max Distance of them are recomputed, see DistanceCache.h. The
+		distances are limited to Max Distance, and Normalize divides by it. Not available
+		with the OpenCV engine.
+	- Tile Size:	Size in pixels of the tiles Incremental compares.
+	- Channel:	One of [R, G, B, A], the input channel that is transformed. R is downloaded
+		as a single channel texture, the others are extracted from an RGBA8 download.
+	- Output Format:	One of [32-bit float, 16-bit float].
+	- Download Depth:	Frames in flight between the GPU and this TOP, see DownloadQueue.h.
+		0 processes the current frame and may stall the cook, the default 1 lags a frame.
+	- Threads:	Number of threads the Exact engine splits each frame across.
 For more information visit: https://docs.opencv.org/3.4/d7/d1b/group__imgproc__misc.html#ga8a0b7fdfcb7a13dde018988ba3a43042
 
 This TOP takes one input which must be 8 bit single channel.
+
+It outputs the following channels to CHOPInfo:
+	- dirty_tiles:	Tiles Incremental found changed in the last cook, all of them when it
+		had to recompute everything.
+It also outputs the download channels described in DownloadQueue.h and the cook time
+statistics described in CookStats.h to CHOPInfo, with the download, compute and upload phases.
 */
 
 // To get more help about these functions, look at TOP_CPlusPlusBase.h
@@ -77,10 +134,27 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager*, void* reserved) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void* reserved) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void* reserved) override;
+
 private:
+	enum class InfoChopChan
+	{
+		DirtyTiles,
+		Size
+	};
+
+	enum class CookPhase
+	{
+		Download,
+		Compute,
+		Upload
+	};
+
 	void                inputTopToMat(const TD::OP_Inputs*);
 
-	void 				cvMatToOutput(TD::TOP_Output*, TD::TOP_UploadInfo) const;
+	void 				cvMatToOutput(const cv::Mat&, TD::OP_SmartRef<TD::TOP_Buffer>&, TD::TOP_Output*, TD::TOP_UploadInfo) const;
 
 	int getType(DistancetypeMenuItems dt)
 	{
@@ -110,11 +184,22 @@ private:
 		}
 	}
 
+	// Either wraps the download or points to myChannel
 	cv::Mat*		myFrame;
+	cv::Mat*		myChannel;
+	cv::Mat*		myDistances;
 
 	int					myExecuteCount;
 	TD::TOP_Context* myContext;
-	TD::OP_SmartRef<TD::OP_TOPDownloadResult> myPrevDownRes;
+	TD::OP_SmartRef<TD::OP_TOPDownloadResult> myFrameDownRes;
+
+	DownloadQueue		myDownloads;
+	CookStats			myCookStats;
+
+	DistanceField		myDistanceField;
+	DistanceCache		myDistanceCache;
+	bool				myIncremental;
+	WorkerPool			myWorkerPool;
 };
 
 #endif
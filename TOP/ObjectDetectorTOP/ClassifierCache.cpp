@@ -0,0 +1,151 @@
+#include "ClassifierCache.h"
+
+#include <chrono>
+#include <map>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+namespace
+{
+	struct Cached
+	{
+		std::weak_ptr<ClassifierCache::Entry>	entry;
+		int64_t		modified;
+		int64_t		size;
+	};
+
+	// The process-wide table. Loads happen under the lock so two detectors asking for the
+	// same file at once parse it only once
+	std::mutex							theLock;
+	std::map<std::string, Cached>		theCache;
+
+	// Modification time and size of path, false if it does not exist
+	bool
+		statFile(const std::string& path, int64_t& modified, int64_t& size)
+	{
+#ifdef _WIN32
+		struct _stat64	st;
+		if (_stat64(path.c_str(), &st) != 0)
+			return false;
+#else
+		struct stat		st;
+		if (stat(path.c_str(), &st) != 0)
+			return false;
+#endif
+		modified = static_cast<int64_t>(st.st_mtime);
+		size = static_cast<int64_t>(st.st_size);
+		return true;
+	}
+}
+
+ClassifierCache::ClassifierCache() :
+	myEntry{}, myPath{}, myModified{ 0 }, mySize{ 0 }, myFailed{ false },
+	myLoadTime{ 0.0 }, myLoads{ 0 }, myHits{ 0 }
+{
+}
+
+std::shared_ptr<ClassifierCache::Entry>
+ClassifierCache::acquire(const std::string& path)
+{
+	int64_t	modified = 0;
+	int64_t	size = 0;
+	if (path.empty() || !statFile(path, modified, size))
+	{
+		myEntry.reset();
+		myPath = path;
+		myFailed = true;
+		return nullptr;
+	}
+
+	// Same file as last cook
+	if (path == myPath && modified == myModified && size == mySize && (myEntry || myFailed))
+	{
+		if (myEntry)
+			++myHits;
+		return myEntry;
+	}
+
+	myPath = path;
+	myModified = modified;
+	mySize = size;
+	myFailed = false;
+	myLoadTime = 0.0;
+
+	std::lock_guard<std::mutex>	lock(theLock);
+
+	Cached&	cached = theCache[path];
+	myEntry = cached.entry.lock();
+	if (myEntry && cached.modified == modified && cached.size == size)
+	{
+		++myHits;
+		return myEntry;
+	}
+
+	// Not loaded, or the file changed. Detectors still holding the old classifier keep
+	// it until they notice the change themselves
+	auto	start = std::chrono::steady_clock::now();
+	myEntry = std::make_shared<Entry>();
+	bool	loaded = false;
+	try
+	{
+		loaded = myEntry->classifier.load(path);
+	}
+	catch (...)
+	{
+	}
+	myLoadTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	++myLoads;
+
+	if (!loaded || myEntry->classifier.empty())
+	{
+		myEntry.reset();
+		myFailed = true;
+		theCache.erase(path);
+		return nullptr;
+	}
+
+	cached.entry = myEntry;
+	cached.modified = modified;
+	cached.size = size;
+	return myEntry;
+}
+
+double
+ClassifierCache::getLoadTime() const
+{
+	return myLoadTime;
+}
+
+int64_t
+ClassifierCache::getLoads() const
+{
+	return myLoads;
+}
+
+int64_t
+ClassifierCache::getHits() const
+{
+	return myHits;
+}
+
+int
+ClassifierCache::getNumCached()
+{
+	std::lock_guard<std::mutex>	lock(theLock);
+
+	int	count = 0;
+	for (auto it = theCache.begin(); it != theCache.end();)
+	{
+		if (it->second.entry.expired())
+		{
+			it = theCache.erase(it);
+		}
+		else
+		{
+			++count;
+			++it;
+		}
+	}
+	return count;
+}
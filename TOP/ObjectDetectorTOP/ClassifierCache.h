@@ -0,0 +1,63 @@
+#ifndef __ClassifierCache__
+#define __ClassifierCache__
+
+#include <opencv2/objdetect.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/*
+Loads each cascade classifier file once for the whole process. Detectors that use the same
+file share one cv::CascadeClassifier instead of parsing the XML on every cook and holding a
+copy each. A file is loaded again when its modification time or size changes, and its
+classifier is freed when the last detector using it lets go of it.
+
+Every detector owns a ClassifierCache, which remembers the file it asked for last. While the
+path, modification time and size stay the same, acquire() only stats the file and returns
+the classifier it already holds. Otherwise it looks the file up in the process-wide table
+and loads it if no one holds it yet. A file that fails to load is not tried again until it
+changes, so a wrong path does not cost a parse every cook.
+
+detectMultiScale changes state inside the classifier, users of a shared classifier hold its
+lock while detecting.
+*/
+class ClassifierCache
+{
+public:
+	struct Entry
+	{
+		cv::CascadeClassifier	classifier;
+		std::mutex				lock;
+	};
+
+	ClassifierCache();
+
+	// The classifier in path, or null if it cannot be loaded
+	std::shared_ptr<Entry>	acquire(const std::string& path);
+
+	// Milliseconds the last load asked for by this detector took, 0 if it was shared
+	double		getLoadTime() const;
+
+	// Files this detector parsed, and acquire() calls served without parsing
+	int64_t		getLoads() const;
+	int64_t		getHits() const;
+
+	// Classifiers loaded in the process
+	static int	getNumCached();
+
+private:
+	std::shared_ptr<Entry>	myEntry;
+	std::string				myPath;
+	int64_t					myModified;
+	int64_t					mySize;
+	// Whether myPath failed to load as it is
+	bool					myFailed;
+
+	double					myLoadTime;
+	int64_t					myLoads;
+	int64_t					myHits;
+};
+
+#endif // !__ClassifierCache__
@@ -0,0 +1,102 @@
+#include "DetectorThread.h"
+
+DetectorThread::DetectorThread() :
+	myThread{}, myMutex{}, myCV{}, myThreadShouldExit{ false },
+	myHasFrame{ false }, myFrame{}, myClassifiers{}, mySettings{}, myFrameNumber{ 0 }, myDropped{ 0 },
+	myHasResult{ false }, myObjects{}, myLevelWeights{}, myClassifierOf{}, myResultFrame{ 0 }, myResultGray{},
+	myCascades{}
+{
+	myThread = new std::thread([this] { threadFn(); });
+}
+
+DetectorThread::~DetectorThread()
+{
+	{
+		std::lock_guard<std::mutex>	lock(myMutex);
+		myThreadShouldExit.store(true);
+	}
+	myCV.notify_all();
+	if (myThread->joinable())
+		myThread->join();
+
+	delete myThread;
+}
+
+void
+DetectorThread::post(const cv::Mat& gray, const Classifiers& classifiers, const Settings& settings, int64_t frame)
+{
+	{
+		std::lock_guard<std::mutex>	lock(myMutex);
+		if (myHasFrame)
+			++myDropped;
+
+		myHasFrame = true;
+		myFrame = gray;
+		myClassifiers = classifiers;
+		mySettings = settings;
+		myFrameNumber = frame;
+	}
+	myCV.notify_one();
+}
+
+bool
+DetectorThread::takeResult(std::vector<cv::Rect>& objects, std::vector<double>& levelWeights, std::vector<int>& classifierOf,
+						   int64_t& frame, cv::Mat& gray)
+{
+	std::lock_guard<std::mutex>	lock(myMutex);
+	if (!myHasResult)
+		return false;
+
+	objects.swap(myObjects);
+	levelWeights.swap(myLevelWeights);
+	classifierOf.swap(myClassifierOf);
+	frame = myResultFrame;
+	gray = myResultGray;
+	myResultGray = cv::Mat();
+	myHasResult = false;
+	return true;
+}
+
+int64_t
+DetectorThread::getDropped()
+{
+	std::lock_guard<std::mutex>	lock(myMutex);
+	return myDropped;
+}
+
+void
+DetectorThread::threadFn()
+{
+	// Only used by the thread
+	std::vector<cv::Rect>	objects;
+	std::vector<double>		levelWeights;
+	std::vector<int>		classifierOf;
+
+	while (true)
+	{
+		std::unique_lock<std::mutex>	lock(myMutex);
+		myCV.wait(lock, [this] { return myHasFrame || myThreadShouldExit; });
+		if (myThreadShouldExit)
+			return;
+
+		// Take the frame so post() can fill the mailbox while we detect
+		cv::Mat		gray = std::move(myFrame);
+		Classifiers	classifiers = std::move(myClassifiers);
+		const Settings	settings = mySettings;
+		const int64_t	frame = myFrameNumber;
+		myFrame = cv::Mat();
+		myClassifiers.clear();
+		myHasFrame = false;
+		lock.unlock();
+
+		myCascades.detect(classifiers, gray, settings, objects, levelWeights, classifierOf);
+
+		lock.lock();
+		myObjects.swap(objects);
+		myLevelWeights.swap(levelWeights);
+		myClassifierOf.swap(classifierOf);
+		myResultFrame = frame;
+		myResultGray = gray;
+		myHasResult = true;
+	}
+}
@@ -0,0 +1,78 @@
+#ifndef __DetectorThread__
+#define __DetectorThread__
+
+#include "ClassifierCache.h"
+#include "MultiCascade.h"
+
+#include <opencv2/core.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+Runs the classifiers on a thread of its own so a slow detection does not stall the cook,
+see MultiCascade.h.
+
+Frames are handed over through a mailbox with a single slot: post() puts a frame in it,
+replacing the one waiting there if the thread has not taken it yet, so the thread always
+detects on the newest frame and never falls behind. takeResult() returns the last detection
+that finished, with the number of the frame it was run on, so the caller can tell how old
+it is.
+*/
+class DetectorThread
+{
+public:
+	typedef MultiCascade::Settings	Settings;
+	typedef std::vector<std::shared_ptr<ClassifierCache::Entry>>	Classifiers;
+
+	DetectorThread();
+
+	// Waits for the detection in progress
+	~DetectorThread();
+
+	// gray is 8 bit single channel and must not be written to afterwards, it is shared
+	// with the thread. frame numbers it for takeResult()
+	void		post(const cv::Mat& gray, const Classifiers& classifiers, const Settings& settings, int64_t frame);
+
+	// Swaps the last finished detection into objects, levelWeights and classifierOf, false
+	// if none finished since the last call. gray is the frame it was run on
+	bool		takeResult(std::vector<cv::Rect>& objects, std::vector<double>& levelWeights, std::vector<int>& classifierOf,
+						   int64_t& frame, cv::Mat& gray);
+
+	// Frames replaced in the mailbox before the thread took them
+	int64_t		getDropped();
+
+private:
+	void	threadFn();
+
+	std::thread*			myThread;
+	std::mutex				myMutex;
+	std::condition_variable	myCV;
+	std::atomic_bool		myThreadShouldExit;
+
+	// The mailbox
+	bool					myHasFrame;
+	cv::Mat					myFrame;
+	Classifiers				myClassifiers;
+	Settings				mySettings;
+	int64_t					myFrameNumber;
+	int64_t					myDropped;
+
+	// The last detection that finished
+	bool					myHasResult;
+	std::vector<cv::Rect>	myObjects;
+	std::vector<double>		myLevelWeights;
+	std::vector<int>		myClassifierOf;
+	int64_t					myResultFrame;
+	cv::Mat					myResultGray;
+
+	// Only used by the thread
+	MultiCascade			myCascades;
+};
+
+#endif // !__DetectorThread__
@@ -0,0 +1,133 @@
+#include "GrayDownsample.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GRAYDOWNSAMPLE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// COLOR_BGRA2GRAY weights of B, G and R in 1/2^14
+	const int	GrayBits = 14;
+	const int	WeightB = 1868;
+	const int	WeightG = 9617;
+	const int	WeightR = 4899;
+
+	// The largest factor, a block of 16 channels still fits in 16 bits
+	const int	MaxFactor = 4;
+
+	int
+		log2Of(int factor)
+	{
+		return factor == 4 ? 2 : factor == 2 ? 1 : 0;
+	}
+
+	// Gray value of the block starting at x in rows, scalar
+	inline uint8_t
+		blockGray(const uint8_t* const* rows, int factor, int x, int shift)
+	{
+		int	b = 0;
+		int	g = 0;
+		int	r = 0;
+		for (int y = 0; y < factor; ++y)
+		{
+			const uint8_t*	px = rows[y] + 4 * x;
+			for (int i = 0; i < factor; ++i, px += 4)
+			{
+				b += px[0];
+				g += px[1];
+				r += px[2];
+			}
+		}
+		return static_cast<uint8_t>((b * WeightB + g * WeightG + r * WeightR + (1 << (shift - 1))) >> shift);
+	}
+
+#ifdef GRAYDOWNSAMPLE_SSE2
+	// Channel sums of the block starting at x in the low 4 16 bit lanes
+	inline __m128i
+		blockSum(const uint8_t* const* rows, int factor, int x)
+	{
+		const __m128i	zero = _mm_setzero_si128();
+		__m128i			sum = zero;
+		if (factor == 2)
+		{
+			for (int y = 0; y < 2; ++y)
+				sum = _mm_add_epi16(sum, _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(rows[y] + 4 * x)), zero));
+		}
+		else
+		{
+			for (int y = 0; y < 4; ++y)
+			{
+				const __m128i	px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[y] + 4 * x));
+				sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_unpacklo_epi8(px, zero), _mm_unpackhi_epi8(px, zero)));
+			}
+		}
+		// Two pixels in the lanes, fold them
+		return _mm_add_epi16(sum, _mm_srli_si128(sum, 8));
+	}
+#endif
+
+	void
+		downsampleRow(const uint8_t* const* rows, uint8_t* out, int width, int factor)
+	{
+		const int	shift = GrayBits + 2 * log2Of(factor);
+		int			x = 0;
+
+#ifdef GRAYDOWNSAMPLE_SSE2
+		const __m128i	weights = _mm_setr_epi16(WeightB, WeightG, WeightR, 0, WeightB, WeightG, WeightR, 0);
+		const __m128i	half = _mm_set1_epi32(1 << (shift - 1));
+		for (; x + 4 <= width; x += 4)
+		{
+			const int		in = x * factor;
+			// Two blocks per register, madd leaves B + G and R of each
+			const __m128i	a = _mm_madd_epi16(_mm_unpacklo_epi64(blockSum(rows, factor, in), blockSum(rows, factor, in + factor)), weights);
+			const __m128i	b = _mm_madd_epi16(_mm_unpacklo_epi64(blockSum(rows, factor, in + 2 * factor), blockSum(rows, factor, in + 3 * factor)), weights);
+			const __m128	af = _mm_castsi128_ps(a);
+			const __m128	bf = _mm_castsi128_ps(b);
+			const __m128i	even = _mm_castps_si128(_mm_shuffle_ps(af, bf, _MM_SHUFFLE(2, 0, 2, 0)));
+			const __m128i	odd = _mm_castps_si128(_mm_shuffle_ps(af, bf, _MM_SHUFFLE(3, 1, 3, 1)));
+			const __m128i	gray = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(even, odd), half), shift);
+			const __m128i	packed = _mm_packs_epi32(gray, gray);
+			const int		four = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+			std::memcpy(out + x, &four, sizeof(four));
+		}
+#endif
+
+		for (; x < width; ++x)
+			out[x] = blockGray(rows, factor, x * factor, shift);
+	}
+}
+
+void
+bgraToGrayDownsample(const cv::Mat& bgra, cv::Mat& gray, int factor)
+{
+	if (factor <= 1)
+	{
+		cv::cvtColor(bgra, gray, cv::COLOR_BGRA2GRAY);
+		return;
+	}
+
+	factor = factor >= MaxFactor ? MaxFactor : 2;
+
+	const int	width = bgra.cols / factor;
+	const int	height = bgra.rows / factor;
+	gray.create(height, width, CV_8UC1);
+	if (width == 0 || height == 0)
+		return;
+
+	cv::parallel_for_(cv::Range(0, height), [&](const cv::Range& range)
+	{
+		const uint8_t*	rows[MaxFactor];
+		for (int y = range.start; y < range.end; ++y)
+		{
+			for (int i = 0; i < factor; ++i)
+				rows[i] = bgra.ptr<uint8_t>(y * factor + i);
+			downsampleRow(rows, gray.ptr<uint8_t>(y), width, factor);
+		}
+	});
+}
@@ -0,0 +1,22 @@
+#ifndef __GrayDownsample__
+#define __GrayDownsample__
+
+#include <opencv2/core.hpp>
+
+/*
+Converts BGRA8 pixels to gray while shrinking them by an integer factor, in one pass
+instead of a cv::resize followed by a cv::cvtColor. Each gray pixel is the mean of a
+factor x factor block, weighted like COLOR_BGRA2GRAY: the channels of the block are summed
+and the sums weighted with the same 14 bit fixed point coefficients as OpenCV. The pixels
+past the last whole block on the right and bottom are left out.
+
+The SSE2 version makes 4 gray pixels per iteration: the rows of each block are added as
+16 bit channels, the pixels of the block folded together, and the channel sums weighted
+with _mm_madd_epi16. Rows are split in bands with cv::parallel_for_.
+*/
+
+// bgra is CV_8UC4, gray is made CV_8UC1 of bgra's size divided by factor. factor 1 is a
+// plain conversion
+void	bgraToGrayDownsample(const cv::Mat& bgra, cv::Mat& gray, int factor);
+
+#endif // !__GrayDownsample__
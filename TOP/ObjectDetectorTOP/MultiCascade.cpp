@@ -0,0 +1,225 @@
+#include "MultiCascade.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+namespace
+{
+	// What detectMultiScale groups with
+	const double	GroupEps = 0.2;
+
+	// Largest objects detectMultiScale looks for, the image when Max Object Size is not set
+	cv::Size
+		maxObjectSize(const cv::Size& maxSize, const cv::Mat& image)
+	{
+		return maxSize.width == 0 || maxSize.height == 0 ? cv::Size(image.cols, image.rows) : maxSize;
+	}
+}
+
+MultiCascade::MultiCascade() :
+	myLevels{}, myFactors{}, myMaxSize{}, myFound{}, myPyramidLevels{ 0 }
+{
+}
+
+void
+MultiCascade::detect(const std::vector<std::shared_ptr<ClassifierCache::Entry>>& classifiers, const cv::Mat& gray,
+					 const Settings& settings, std::vector<cv::Rect>& objects, std::vector<double>& levelWeights,
+					 std::vector<int>& classifierOf)
+{
+	objects.clear();
+	levelWeights.clear();
+	classifierOf.clear();
+	myPyramidLevels = 0;
+
+	std::vector<int>	used;
+	for (int i = 0; i < static_cast<int>(classifiers.size()); ++i)
+	{
+		if (classifiers[i])
+			used.push_back(i);
+	}
+	if (used.empty())
+		return;
+
+	if (myFound.size() < classifiers.size())
+		myFound.resize(classifiers.size());
+
+	if (used.size() == 1)
+	{
+		ClassifierCache::Entry&	classifier = *classifiers[used[0]];
+		Found&					found = myFound[used[0]];
+		try
+		{
+			std::lock_guard<std::mutex>	lock(classifier.lock);
+			classifier.classifier.detectMultiScale(gray, found.objects, found.rejectLevels, found.levelWeights, settings.scaleFactor,
+												   settings.minNeighbors, 0, settings.minSize, settings.maxSize, true);
+		}
+		catch (...)
+		{
+			// If something went wrong just empty detected objects
+			found.objects.clear();
+			found.levelWeights.clear();
+		}
+	}
+	else
+	{
+		std::vector<cv::Size>	windows;
+		for (int i : used)
+		{
+			std::lock_guard<std::mutex>	lock(classifiers[i]->lock);
+			windows.push_back(classifiers[i]->classifier.getOriginalWindowSize());
+		}
+		buildPyramid(gray, settings, windows);
+
+		// The parallel loops inside detectMultiScale run serially within a task
+		cv::parallel_for_(cv::Range(0, static_cast<int>(used.size())), [&](const cv::Range& range)
+		{
+			for (int i = range.start; i < range.end; ++i)
+				detectOne(*classifiers[used[i]], settings, myFound[used[i]]);
+		}, static_cast<double>(used.size()));
+	}
+
+	for (int i : used)
+	{
+		const Found&	found = myFound[i];
+		for (size_t j = 0; j < found.objects.size(); ++j)
+		{
+			objects.push_back(found.objects[j]);
+			levelWeights.push_back(j < found.levelWeights.size() ? found.levelWeights[j] : 0.0);
+			classifierOf.push_back(i);
+		}
+	}
+}
+
+int
+MultiCascade::getPyramidLevels() const
+{
+	return myPyramidLevels;
+}
+
+void
+MultiCascade::buildPyramid(const cv::Mat& gray, const Settings& settings, const std::vector<cv::Size>& windows)
+{
+	myFactors.clear();
+	myMaxSize = maxObjectSize(settings.maxSize, gray);
+	std::vector<cv::Size>	sizes;
+	if (settings.scaleFactor <= 1.0)
+	{
+		myLevels.clear();
+		return;
+	}
+
+	const cv::Size&	maxSize = myMaxSize;
+
+	// The factors detectMultiScale steps through, a level is made when one of the
+	// classifiers looks at it
+	for (double factor = 1.0; ; factor *= settings.scaleFactor)
+	{
+		bool	fits = false;
+		bool	needed = false;
+		for (const cv::Size& window : windows)
+		{
+			const cv::Size	windowSize(cvRound(window.width * factor), cvRound(window.height * factor));
+			if (windowSize.width > maxSize.width || windowSize.height > maxSize.height ||
+				windowSize.width > gray.cols || windowSize.height > gray.rows)
+				continue;
+
+			fits = true;
+			if (windowSize.width >= settings.minSize.width && windowSize.height >= settings.minSize.height)
+				needed = true;
+		}
+
+		// Windows only grow from here
+		if (!fits)
+			break;
+
+		// detectMultiScale sizes the levels with the factor as a float
+		const float	f = static_cast<float>(factor);
+		myFactors.push_back(factor);
+		sizes.push_back(needed ? cv::Size(cvRound(gray.cols / f), cvRound(gray.rows / f)) : cv::Size());
+	}
+
+	// Made like detectMultiScale makes them, so the levels hold the same pixels
+	myLevels.resize(myFactors.size());
+	cv::parallel_for_(cv::Range(0, static_cast<int>(myLevels.size())), [&](const cv::Range& range)
+	{
+		for (int i = range.start; i < range.end; ++i)
+		{
+			if (sizes[i].width == 0)
+				myLevels[i] = cv::Mat();
+			else if (i == 0)
+				myLevels[i] = gray;
+			else
+			{
+				const double	inverse = 1.0 / static_cast<float>(myFactors[i]);
+				cv::resize(gray, myLevels[i], sizes[i], inverse, inverse, cv::INTER_LINEAR_EXACT);
+			}
+		}
+	});
+
+	for (const cv::Size& size : sizes)
+	{
+		if (size.width != 0)
+			++myPyramidLevels;
+	}
+}
+
+void
+MultiCascade::detectOne(ClassifierCache::Entry& classifier, const Settings& settings, Found& found)
+{
+	found.objects.clear();
+	found.rejectLevels.clear();
+	found.levelWeights.clear();
+
+	try
+	{
+		std::lock_guard<std::mutex>	lock(classifier.lock);
+		const cv::Size	window = classifier.classifier.getOriginalWindowSize();
+		const cv::Size&	maxSize = myMaxSize;
+		for (size_t i = 0; i < myLevels.size(); ++i)
+		{
+			const cv::Mat&	level = myLevels[i];
+			const double	factor = myFactors[i];
+			const cv::Size	windowSize(cvRound(window.width * factor), cvRound(window.height * factor));
+			if (windowSize.width > maxSize.width || windowSize.height > maxSize.height)
+				break;
+			if (level.empty() || windowSize.width < settings.minSize.width || windowSize.height < settings.minSize.height)
+				continue;
+
+			// A single scale, any factor above 1 stops after it. It steps 2 pixels at a time,
+			// detectMultiScale steps 1 from factor 2 up, there the level is also scanned
+			// shifted by a pixel right, down and both
+			const float		scale = static_cast<float>(factor);
+			const cv::Size	scaledWindow(cvRound(window.width * scale), cvRound(window.height * scale));
+			const int		shifts = scale >= 2.0f ? 2 : 1;
+			for (int dy = 0; dy < shifts; ++dy)
+			{
+				for (int dx = 0; dx < shifts; ++dx)
+				{
+					if (level.cols - dx < window.width || level.rows - dy < window.height)
+						continue;
+
+					const cv::Mat	shifted = level(cv::Rect(dx, dy, level.cols - dx, level.rows - dy));
+					classifier.classifier.detectMultiScale(shifted, found.levelObjects, found.levelRejectLevels, found.levelLevelWeights,
+														   1.1, 0, 0, window, window, true);
+					for (size_t j = 0; j < found.levelObjects.size(); ++j)
+					{
+						const cv::Rect&	r = found.levelObjects[j];
+						found.objects.push_back(cv::Rect(cvRound((r.x + dx) * scale), cvRound((r.y + dy) * scale),
+														 scaledWindow.width, scaledWindow.height));
+						found.rejectLevels.push_back(j < found.levelRejectLevels.size() ? found.levelRejectLevels[j] : 0);
+						found.levelWeights.push_back(j < found.levelLevelWeights.size() ? found.levelLevelWeights[j] : 0.0);
+					}
+				}
+			}
+		}
+
+		cv::groupRectangles(found.objects, found.rejectLevels, found.levelWeights, settings.minNeighbors, GroupEps);
+	}
+	catch (...)
+	{
+		found.objects.clear();
+		found.levelWeights.clear();
+	}
+}
@@ -0,0 +1,83 @@
+#ifndef __MultiCascade__
+#define __MultiCascade__
+
+#include "ClassifierCache.h"
+
+#include <opencv2/core.hpp>
+
+#include <memory>
+#include <vector>
+
+/*
+Runs several cascade classifiers on the same gray image.
+
+cv::CascadeClassifier::detectMultiScale scales the image down once per Scale Factor step
+on its own, so N classifiers would build N pyramids of the same image. Here the pyramid is
+built once, at the factors and with the interpolation detectMultiScale uses, and every
+classifier is run on each level at a single scale: minimum and maximum size both set to its
+window. The candidates of all the levels are then scaled back and grouped with
+cv::groupRectangles and the Min Neighbors threshold. The classifiers are evaluated in
+parallel, one task each.
+
+At a single scale detectMultiScale steps its window by 2 pixels, while on its own it steps
+by 1 on the levels scaled down by 2 or more. Those levels are therefore also scanned shifted
+by a pixel right, down and both, so every window position OpenCV tries is tried here too.
+What remains different is that OpenCV skips the position after one rejected at the first
+stage of the cascade, which on those levels depends on the pixel order of the scan: a few
+candidates in a thousand differ. After grouping, most objects come out exactly as with each
+classifier run on its own, some are placed a few pixels off and once in a while one is found
+or missed.
+
+With a single classifier detectMultiScale is called directly, it already runs in parallel
+and gives the objects OpenCV gives.
+*/
+class MultiCascade
+{
+public:
+	struct Settings
+	{
+		double		scaleFactor = 1.1;
+		int			minNeighbors = 3;
+		cv::Size	minSize;
+		cv::Size	maxSize;
+	};
+
+	MultiCascade();
+
+	// Detects with every classifier on gray, 8 bit single channel. Null classifiers are
+	// skipped. classifierOf tells the index in classifiers of the one that found each object
+	void	detect(const std::vector<std::shared_ptr<ClassifierCache::Entry>>& classifiers, const cv::Mat& gray,
+				   const Settings& settings, std::vector<cv::Rect>& objects, std::vector<double>& levelWeights,
+				   std::vector<int>& classifierOf);
+
+	// Levels of the last shared pyramid, 0 if it was not needed
+	int		getPyramidLevels() const;
+
+private:
+	// Candidates of one classifier
+	struct Found
+	{
+		std::vector<cv::Rect>	objects;
+		std::vector<int>		rejectLevels;
+		std::vector<double>		levelWeights;
+		// Candidates of one level
+		std::vector<cv::Rect>	levelObjects;
+		std::vector<int>		levelRejectLevels;
+		std::vector<double>		levelLevelWeights;
+	};
+
+	// windows are the original window sizes of the classifiers
+	void	buildPyramid(const cv::Mat& gray, const Settings& settings, const std::vector<cv::Size>& windows);
+
+	void	detectOne(ClassifierCache::Entry& classifier, const Settings& settings, Found& found);
+
+	// Level i is the image divided by myFactors[i], empty if no classifier needs it
+	std::vector<cv::Mat>	myLevels;
+	std::vector<double>		myFactors;
+	// Largest object looked for in the image
+	cv::Size				myMaxSize;
+	std::vector<Found>		myFound;
+	int						myPyramidLevels;
+};
+
+#endif // !__MultiCascade__
@@ -13,11 +13,18 @@
 */
 
 #include "ObjectDetectorTOP.h"
+#include "DetectorThread.h"
+#include "ObjectTracker.h"
+#include "GrayDownsample.h"
 
 #include <cassert>
+#include <cstdio>
 #include <string>
 #include <sstream>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <array>
 #include <opencv2/core.hpp>
 #include <opencv2/objdetect.hpp>
 #include <opencv2/imgproc.hpp>
@@ -31,6 +38,28 @@ InfoChopChan
 	Ty,
 	W,
 	H,
+	Id,
+	Classifier,
+	Size
+};
+
+// Channels after the objects
+enum class
+DetectionChan
+{
+	Age,
+	Dropped,
+	Size
+};
+
+// Rows of the Info DAT after the objects
+enum class
+InfoDatRow
+{
+	LoadTime,
+	Loads,
+	CacheHits,
+	Cached,
 	Size
 };
 
@@ -90,20 +119,24 @@ DestroyTOPInstance(TD::TOP_CPlusPlusBase* instance, TD::TOP_Context *context)
 
 
 ObjectDetectorTOP::ObjectDetectorTOP(const TD::OP_NodeInfo* info, TD::TOP_Context* context ) : 
-	myFrame{ new cv::Mat() }, myClassifier{ new cv::CascadeClassifier() }, 
-	myObjects{}, myLevelWeights{}, myRejectLevels{}, myPath{}, myScale{}, 
+	myFrame{ new cv::Mat() }, myClassifiers{}, 
+	myObjects{}, myLevelWeights{}, myClassifierOf{}, myCascades{}, myPaths{}, myScale{}, 
 	myMinNeighbors{}, myLimitSize{}, myMinSize{}, myMaxSize{}, myDrawBoundingBox{}, 
-	myLimitObjs{}, myMaxObjs{},
+	myLimitObjs{}, myMaxObjs{}, myAsync{ false }, myDetector{ nullptr },
+	myFrameCount{ 0 }, myDetectedFrame{ 0 }, myDetections{}, myObjectIds{}, myDetectScale{ 1 },
+	myTrack{ false }, myTrackSettings{}, myTracker{},
 	myContext(context),
 	myExecuteCount(0),
-	myPrevDownRes(nullptr)
+	myFrameDownRes(nullptr),
+	myDownloads{ 1 },
+	myCookStats{ "download", "load", "detect", "track", "upload" }
 {
 }
 
 ObjectDetectorTOP::~ObjectDetectorTOP()
 {
+	delete myDetector;
 	delete myFrame;
-	delete myClassifier;
 }
 
 void
@@ -118,15 +151,15 @@ ObjectDetectorTOP::execute(TD::TOP_Output* output,
 						const TD::OP_Inputs* inputs,
 						void* reserved1)
 {
+	CookStats::Cook	cook(myCookStats);
 	myExecuteCount++;
 
 	using namespace cv;
 
+	myCookStats.beginPhase(CookPhase::Download);
 	inputToMat(inputs);
-	if (myFrame->empty())
-		return;
-
-	if (!myPrevDownRes)
+	myCookStats.endPhase();
+	if (myFrame->empty() || !myFrameDownRes)
 		return;
 
 	handleParameters(inputs);
@@ -134,32 +167,119 @@ ObjectDetectorTOP::execute(TD::TOP_Output* output,
 
 
 	TD::TOP_UploadInfo info;
-	info.textureDesc = myPrevDownRes->textureDesc;
+	info.textureDesc = myFrameDownRes->textureDesc;
 	info.colorBufferIndex = 0;
 
+	myCookStats.beginPhase(CookPhase::Detect);
 	resize(*myFrame, *myFrame, cv::Size(info.textureDesc.width, info.textureDesc.height));
 
+	// Detection and tracking happen on the gray image, scaled down by Detection Scale
 	Mat	frameGray;
-	cvtColor(*myFrame, frameGray, COLOR_BGRA2GRAY);
+	bgraToGrayDownsample(*myFrame, frameGray, myDetectScale);
+	myCookStats.addAllocated(frameGray.total());
+	myCookStats.endPhase();
+
+	// An empty Classifier 2 is a null entry, so the others keep their index
+	myCookStats.beginPhase(CookPhase::Load);
+	DetectorThread::Classifiers	classifiers(MaxClassifiers);
+	bool						anyClassifier = false;
+	for (int i = 0; i < MaxClassifiers; ++i)
+	{
+		classifiers[i] = myClassifiers[i].acquire(myPaths[i]);
+		if (classifiers[i])
+			anyClassifier = true;
+	}
+	myCookStats.endPhase();
 
-	try
+	++myFrameCount;
+	if (!anyClassifier)
+	{
+		myDetections.clear();
+		myClassifierOf.clear();
+		myObjectIds.clear();
+		myTracker.clear();
+		myDetectedFrame = myFrameCount;
+	}
+	else
 	{
-		myClassifier->load(myPath);
-		myClassifier->detectMultiScale(frameGray, myObjects, myRejectLevels, myLevelWeights, myScale, myMinNeighbors, 0, myMinSize, myMaxSize, true);
+		DetectorThread::Settings	settings;
+		settings.scaleFactor = myScale;
+		settings.minNeighbors = myMinNeighbors;
+		settings.minSize = cv::Size(myMinSize.width / myDetectScale, myMinSize.height / myDetectScale);
+		settings.maxSize = cv::Size(myMaxSize.width / myDetectScale, myMaxSize.height / myDetectScale);
+
+		// While tracking, detect only when the tracker asks for it
+		const bool	detectNow = !myTrack || myTracker.needsDetection(myTrackSettings);
+		bool		detected = false;
+		Mat			detectedGray = frameGray;
+
+		myCookStats.beginPhase(CookPhase::Detect);
+		if (myAsync)
+		{
+			// Show the newest detection that finished, the objects stay until a newer one does
+			if (detectNow)
+				myDetector->post(frameGray, classifiers, settings, myFrameCount);
+			detected = myDetector->takeResult(myDetections, myLevelWeights, myClassifierOf, myDetectedFrame, detectedGray);
+		}
+		else if (detectNow)
+		{
+			myCascades.detect(classifiers, frameGray, settings, myDetections, myLevelWeights, myClassifierOf);
+			myDetectedFrame = myFrameCount;
+			detected = true;
+		}
+		myCookStats.endPhase();
+
+		if (myTrack)
+		{
+			CookStats::Phase	track(myCookStats, CookPhase::Track);
+			if (detected)
+				myTracker.update(detectedGray, myDetections, myLevelWeights, myClassifierOf);
+
+			// Objects detected on an earlier frame are tracked up to this one
+			if (!detected || myDetectedFrame != myFrameCount)
+				myTracker.track(frameGray, myTrackSettings);
+
+			const std::vector<ObjectTracker::Object>&	tracked = myTracker.getObjects();
+			myDetections.resize(tracked.size());
+			myLevelWeights.resize(tracked.size());
+			myClassifierOf.resize(tracked.size());
+			myObjectIds.resize(tracked.size());
+			for (size_t i = 0; i < tracked.size(); ++i)
+			{
+				myDetections[i] = tracked[i].box;
+				myLevelWeights[i] = tracked[i].levelWeight;
+				myClassifierOf[i] = tracked[i].classifier;
+				myObjectIds[i] = tracked[i].id;
+			}
+		}
+		else if (detected)
+		{
+			myObjectIds.resize(myDetections.size());
+			for (size_t i = 0; i < myObjectIds.size(); ++i)
+				myObjectIds[i] = static_cast<int>(i) + 1;
+		}
 	}
-	catch (...)
+
+	// Back to output pixels
+	myObjects.resize(myDetections.size());
+	for (size_t i = 0; i < myDetections.size(); ++i)
 	{
-		// If something went wrong just empty detected objects
-		myObjects.clear();
+		const cv::Rect&	d = myDetections[i];
+		myObjects[i] = cv::Rect(d.x * myDetectScale, d.y * myDetectScale, d.width * myDetectScale, d.height * myDetectScale);
 	}
 
 	if (myLimitObjs && myObjects.size() > myMaxObjs)
+	{
 		myObjects.resize(myMaxObjs);
+		myObjectIds.resize(myMaxObjs);
+	}
 
+	CookStats::Phase	upload(myCookStats, CookPhase::Upload);
 	if (myDrawBoundingBox)
 		drawBoundingBoxes();
 
 	cvMatToOutput(*myFrame, output, info);
+	myCookStats.addAllocated(myFrameDownRes->size);
 }
 
 void
@@ -176,6 +296,20 @@ ObjectDetectorTOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 		assert(res == TD::OP_ParAppendResult::Success);
 	}
 
+	for (int i = 2; i <= MaxClassifiers; ++i)
+	{
+		const std::string	name = "Classifier" + std::to_string(i);
+		const std::string	label = "Classifier " + std::to_string(i);
+		TD::OP_StringParameter p;
+		p.name = name.c_str();
+		p.label = label.c_str();
+		p.page = "Object Detector";
+		p.defaultValue = "";
+		TD::OP_ParAppendResult res = manager->appendFile(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
 	{
 		TD::OP_NumericParameter p;
 		p.name = "Scalefactor";
@@ -330,24 +464,169 @@ ObjectDetectorTOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 
 		assert(res == TD::OP_ParAppendResult::Success);
 	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Downloaddepth";
+		p.label = "Download Depth";
+		p.page = "Object Detector";
+		p.defaultValues[0] = 1;
+		p.minSliders[0] = 0.0;
+		p.maxSliders[0] = 4.0;
+		p.minValues[0] = 0.0;
+		p.maxValues[0] = 8.0;
+		p.clampMins[0] = true;
+		p.clampMaxes[0] = true;
+		TD::OP_ParAppendResult res = manager->appendInt(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_StringParameter p;
+		p.name = "Detectionscale";
+		p.label = "Detection Scale";
+		p.page = "Object Detector";
+		p.defaultValue = "Full";
+		std::array<const char*, 3> Names =
+		{
+			"Full",
+			"Half",
+			"Quarter"
+		};
+		std::array<const char*, 3> Labels =
+		{
+			"Full",
+			"Half",
+			"Quarter"
+		};
+		TD::OP_ParAppendResult res = manager->appendMenu(p, int(Names.size()), Names.data(), Labels.data());
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Asynchronous";
+		p.label = "Asynchronous";
+		p.page = "Object Detector";
+		p.defaultValues[0] = false;
+
+		TD::OP_ParAppendResult res = manager->appendToggle(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Track";
+		p.label = "Track Between Detections";
+		p.page = "Object Detector";
+		p.defaultValues[0] = false;
+
+		TD::OP_ParAppendResult res = manager->appendToggle(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Detectinterval";
+		p.label = "Detect Interval";
+		p.page = "Object Detector";
+		p.defaultValues[0] = 10;
+		p.minSliders[0] = 1.0;
+		p.maxSliders[0] = 60.0;
+		p.minValues[0] = 1.0;
+		p.maxValues[0] = 1.0;
+		p.clampMins[0] = true;
+		p.clampMaxes[0] = false;
+		TD::OP_ParAppendResult res = manager->appendInt(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Minconfidence";
+		p.label = "Min Confidence";
+		p.page = "Object Detector";
+		p.defaultValues[0] = 0.6;
+		p.minSliders[0] = 0.0;
+		p.maxSliders[0] = 1.0;
+		p.minValues[0] = 0.0;
+		p.maxValues[0] = 1.0;
+		p.clampMins[0] = true;
+		p.clampMaxes[0] = true;
+		TD::OP_ParAppendResult res = manager->appendFloat(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Searchmargin";
+		p.label = "Search Margin";
+		p.page = "Object Detector";
+		p.defaultValues[0] = 0.5;
+		p.minSliders[0] = 0.0;
+		p.maxSliders[0] = 2.0;
+		p.minValues[0] = 0.0;
+		p.maxValues[0] = 1.0;
+		p.clampMins[0] = true;
+		p.clampMaxes[0] = false;
+		TD::OP_ParAppendResult res = manager->appendFloat(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
 }
 
 int32_t 
 ObjectDetectorTOP::getNumInfoCHOPChans(void*)
 {
-	if (myLimitObjs)
-		return static_cast<int32_t>(InfoChopChan::Size) * myMaxObjs + 1;
-	else
-		return static_cast<int32_t>(InfoChopChan::Size) * static_cast<int32_t>(myObjects.size()) + 1;
+	return getNumObjectChans() + static_cast<int32_t>(DetectionChan::Size) + myDownloads.getNumInfoCHOPChans() + myCookStats.getNumInfoCHOPChans();
 }
 
 void 
 ObjectDetectorTOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chop, void*)
 {
+	// The detection, downloads and cook statistics go after the object channels
+	if (index >= getNumObjectChans())
+	{
+		index -= getNumObjectChans();
+		if (index < static_cast<int32_t>(DetectionChan::Size))
+		{
+			switch (static_cast<DetectionChan>(index))
+			{
+				case DetectionChan::Age:
+				default:
+				{
+					chop->name->setString("detection_age");
+					chop->value = static_cast<float>(myFrameCount - myDetectedFrame);
+					break;
+				}
+				case DetectionChan::Dropped:
+				{
+					chop->name->setString("detection_frames_dropped");
+					chop->value = myDetector ? static_cast<float>(myDetector->getDropped()) : 0.0f;
+					break;
+				}
+			}
+			return;
+		}
+		index -= static_cast<int32_t>(DetectionChan::Size);
+
+		if (index < myDownloads.getNumInfoCHOPChans())
+			myDownloads.getInfoCHOPChan(index, chop);
+		else
+			myCookStats.getInfoCHOPChan(index - myDownloads.getNumInfoCHOPChans(), chop);
+		return;
+	}
+
 	if (index == 0)
 	{
 		chop->name->setString("objects_tracked");
-		chop->value = static_cast<float>(myObjects.size());
+		chop->value = static_cast<float>(getNumObjects());
 		return;
 	}
 
@@ -355,7 +634,7 @@ ObjectDetectorTOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chop, voi
 
 	int					obj = index / static_cast<int>(InfoChopChan::Size) + 1;
 	int					prop = index % static_cast<int>(InfoChopChan::Size);
-	bool				tracked = myObjects.size() >= obj;
+	bool				tracked = hasObject(obj - 1);
 
 	if (!tracked)
 		chop->value = 0.0f;
@@ -407,6 +686,20 @@ ObjectDetectorTOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chop, voi
 				chop->value = static_cast<float>(myObjects.at(obj - 1).height);
 			break;
 		}
+		case InfoChopChan::Id:
+		{
+			oss << "id";
+			if (tracked)
+				chop->value = static_cast<float>(myObjectIds.at(obj - 1));
+			break;
+		}
+		case InfoChopChan::Classifier:
+		{
+			oss << "classifier";
+			if (tracked)
+				chop->value = static_cast<float>(myClassifierOf.at(obj - 1));
+			break;
+		}
 	}
 
 	const std::string& tmp = oss.str();
@@ -418,7 +711,7 @@ ObjectDetectorTOP::getInfoDATSize(TD::OP_InfoDATSize* info, void*)
 {
 	info->byColumn = false;
 	info->cols = static_cast<int>(InfoChopChan::Size) + 1;
-	info->rows = myLimitObjs ? myMaxObjs + 1 : static_cast<int32_t>(myObjects.size() + 1);
+	info->rows = getNumObjectRows() + static_cast<int32_t>(InfoDatRow::Size);
 	return true;
 }
 
@@ -434,6 +727,51 @@ ObjectDetectorTOP::getInfoDATEntries(int32_t index, int32_t nEntries, TD::OP_Inf
 		entries->values[4]->setString("Ty");
 		entries->values[5]->setString("W");
 		entries->values[6]->setString("H");
+		entries->values[7]->setString("ID");
+		entries->values[8]->setString("Classifier");
+	}
+	else if (index >= getNumObjectRows())
+	{
+		double	loadTime = 0.0;
+		int64_t	loads = 0;
+		int64_t	hits = 0;
+		for (const ClassifierCache& cache : myClassifiers)
+		{
+			loadTime += cache.getLoadTime();
+			loads += cache.getLoads();
+			hits += cache.getHits();
+		}
+
+		char buffer[64];
+		switch (static_cast<InfoDatRow>(index - getNumObjectRows()))
+		{
+			case InfoDatRow::LoadTime:
+			default:
+			{
+				entries->values[0]->setString("classifier_load_ms");
+				std::snprintf(buffer, sizeof(buffer), "%f", loadTime);
+				break;
+			}
+			case InfoDatRow::Loads:
+			{
+				entries->values[0]->setString("classifier_loads");
+				std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(loads));
+				break;
+			}
+			case InfoDatRow::CacheHits:
+			{
+				entries->values[0]->setString("classifier_cache_hits");
+				std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(hits));
+				break;
+			}
+			case InfoDatRow::Cached:
+			{
+				entries->values[0]->setString("classifiers_cached");
+				std::snprintf(buffer, sizeof(buffer), "%d", ClassifierCache::getNumCached());
+				break;
+			}
+		}
+		entries->values[1]->setString(buffer);
 	}
 	else
 	{
@@ -441,7 +779,7 @@ ObjectDetectorTOP::getInfoDATEntries(int32_t index, int32_t nEntries, TD::OP_Inf
 		oss << "obj" << index;
 		const std::string& tmp = oss.str();
 		entries->values[0]->setString(tmp.c_str());
-		if (index > myObjects.size())
+		if (!hasObject(index - 1))
 		{
 			entries->values[1]->setString("0");
 			entries->values[2]->setString("0");
@@ -449,30 +787,72 @@ ObjectDetectorTOP::getInfoDATEntries(int32_t index, int32_t nEntries, TD::OP_Inf
 			entries->values[4]->setString("0");
 			entries->values[5]->setString("0");
 			entries->values[6]->setString("0");
+			entries->values[7]->setString("0");
+			entries->values[8]->setString("0");
 		}
 		else
 		{
 			int obj = index - 1;
 			char buffer[64];
-			entries->values[1]->setString("1");\
-			sprintf_s(buffer, "%f", myLevelWeights.at(obj));
+			entries->values[1]->setString("1");
+			std::snprintf(buffer, sizeof(buffer), "%f", myLevelWeights.at(obj));
 			entries->values[2]->setString(buffer);
-			sprintf_s(buffer, "%d", myObjects.at(obj).x);
+			std::snprintf(buffer, sizeof(buffer), "%d", myObjects.at(obj).x);
 			entries->values[3]->setString(buffer);
-			sprintf_s(buffer, "%d", myObjects.at(obj).y);
+			std::snprintf(buffer, sizeof(buffer), "%d", myObjects.at(obj).y);
 			entries->values[4]->setString(buffer);
-			sprintf_s(buffer, "%d", myObjects.at(obj).width);
+			std::snprintf(buffer, sizeof(buffer), "%d", myObjects.at(obj).width);
 			entries->values[5]->setString(buffer);
-			sprintf_s(buffer, "%d", myObjects.at(obj).height);
+			std::snprintf(buffer, sizeof(buffer), "%d", myObjects.at(obj).height);
 			entries->values[6]->setString(buffer);
+			std::snprintf(buffer, sizeof(buffer), "%d", myObjectIds.at(obj));
+			entries->values[7]->setString(buffer);
+			std::snprintf(buffer, sizeof(buffer), "%d", myClassifierOf.at(obj));
+			entries->values[8]->setString(buffer);
 		}
 	}
 }
 
+int32_t
+ObjectDetectorTOP::getNumObjectChans() const
+{
+	if (myLimitObjs)
+		return static_cast<int32_t>(InfoChopChan::Size) * myMaxObjs + 1;
+	else
+		return static_cast<int32_t>(InfoChopChan::Size) * static_cast<int32_t>(myObjects.size()) + 1;
+}
+
+int32_t
+ObjectDetectorTOP::getNumObjects() const
+{
+	int32_t	count = 0;
+	for (int id : myObjectIds)
+	{
+		if (id != 0)
+			++count;
+	}
+	return count;
+}
+
+bool
+ObjectDetectorTOP::hasObject(size_t slot) const
+{
+	return slot < myObjects.size() && slot < myObjectIds.size() && myObjectIds[slot] != 0;
+}
+
+int32_t
+ObjectDetectorTOP::getNumObjectRows() const
+{
+	// The header and a row per object
+	return myLimitObjs ? myMaxObjs + 1 : static_cast<int32_t>(myObjects.size() + 1);
+}
+
 void 
 ObjectDetectorTOP::handleParameters(const TD::OP_Inputs* in)
 {
-	myPath = in->getParFilePath("Classifier");
+	myPaths[0] = in->getParFilePath("Classifier");
+	for (int i = 1; i < MaxClassifiers; ++i)
+		myPaths[i] = in->getParFilePath(("Classifier" + std::to_string(i + 1)).c_str());
 	myScale = in->getParDouble("Scalefactor");
 	myMinNeighbors = in->getParDouble("Minneighbors");
 
@@ -485,8 +865,8 @@ ObjectDetectorTOP::handleParameters(const TD::OP_Inputs* in)
 	if (myLimitSize)
 	{
 		const TD::OP_TOPInput* top = in->getInputTOP(0);
-		int32_t totalH = myPrevDownRes->textureDesc.height;
-		int32_t totalW = myPrevDownRes->textureDesc.width;
+		int32_t totalH = myFrameDownRes->textureDesc.height;
+		int32_t totalW = myFrameDownRes->textureDesc.width;
 
 		double	w, h;
 		w = in->getParDouble("Minobjectwidth");
@@ -506,6 +886,44 @@ ObjectDetectorTOP::handleParameters(const TD::OP_Inputs* in)
 	myLimitObjs = in->getParInt("Limitobjectsdetected");
 	in->enablePar("Maximumobjects", myLimitObjs);
 	myMaxObjs = myLimitObjs ? in->getParInt("Maximumobjects") : 0;
+
+	// Detections and templates of another scale do not fit the new one
+	int		detectScale = getScale(static_cast<DetectionscaleMenuItems>(in->getParInt("Detectionscale")));
+	if (detectScale != myDetectScale)
+	{
+		myDetections.clear();
+		myClassifierOf.clear();
+		myObjectIds.clear();
+		myTracker.clear();
+		if (myDetector)
+		{
+			delete myDetector;
+			myDetector = new DetectorThread();
+		}
+		myDetectScale = detectScale;
+	}
+
+	bool	async = in->getParInt("Asynchronous") ? true : false;
+	if (async != myAsync)
+	{
+		// Waits for the detection in progress when turned off
+		delete myDetector;
+		myDetector = async ? new DetectorThread() : nullptr;
+		myAsync = async;
+	}
+
+	bool	track = in->getParInt("Track") ? true : false;
+	if (track != myTrack)
+	{
+		myTracker.clear();
+		myTrack = track;
+	}
+	in->enablePar("Detectinterval", myTrack);
+	in->enablePar("Minconfidence", myTrack);
+	in->enablePar("Searchmargin", myTrack);
+	myTrackSettings.detectInterval = in->getParInt("Detectinterval");
+	myTrackSettings.minConfidence = static_cast<float>(in->getParDouble("Minconfidence"));
+	myTrackSettings.searchMargin = static_cast<float>(in->getParDouble("Searchmargin"));
 }
 
 void 
@@ -513,7 +931,7 @@ ObjectDetectorTOP::cvMatToOutput(const cv::Mat& M, TD::TOP_Output* out, TD::TOP_
 {
 	size_t		height = info.textureDesc.height;
 	size_t		width = info.textureDesc.width;
-	size_t		imgsize = myPrevDownRes->size;
+	size_t		imgsize = myFrameDownRes->size;
 
 	TD::OP_SmartRef<TD::TOP_Buffer> buf = myContext->createOutputBuffer(imgsize, TD::TOP_BufferFlags::None, nullptr);
 
@@ -530,35 +948,43 @@ ObjectDetectorTOP::inputToMat(const TD::OP_Inputs* in)
 {
 	const TD::OP_TOPInput*	top = in->getInputTOP(0);
 	if (!top)
+	{
+		*myFrame = cv::Mat();
+		myDownloads.clear();
 		return;
+	}
 
 	TD::OP_TOPInputDownloadOptions	opts;
 	opts.verticalFlip = true;
 	opts.pixelFormat = TD::OP_PixelFormat::BGRA8Fixed;
 
-	TD::OP_SmartRef<TD::OP_TOPDownloadResult> downRes = top->downloadTexture(opts, nullptr);
-
-	// myPrevDownRes does the job of delaying reading the texture by one frame - replace with downRes to read texture instantly
-	if (myPrevDownRes)
+	// The queue delays reading the texture by Download Depth frames, 0 reads it instantly
+	myDownloads.setDepth(in->getParInt("Downloaddepth"));
+	TD::OP_SmartRef<TD::OP_TOPDownloadResult> downRes = myDownloads.push(top, opts);
+	if (!downRes)
 	{
-		int height = downRes->textureDesc.height;
-		int	width = downRes->textureDesc.width;
+		*myFrame = cv::Mat();
+		return;
+	}
 
-		*myFrame = cv::Mat(height, width, CV_8UC4);
-		uint8_t* data = (uint8_t*)myFrame->data;
+	myFrameDownRes = std::move(downRes);
 
-		memcpy(data, myPrevDownRes->getData(), 4 * height * width * sizeof(uint8_t));
-	}
-	myPrevDownRes = std::move(downRes);
-	
+	int height = myFrameDownRes->textureDesc.height;
+	int	width = myFrameDownRes->textureDesc.width;
+
+	*myFrame = cv::Mat(height, width, CV_8UC4);
+	uint8_t* data = (uint8_t*)myFrame->data;
+
+	memcpy(data, myFrameDownRes->getData(), 4 * height * width * sizeof(uint8_t));
 }
 
 void
 ObjectDetectorTOP::drawBoundingBoxes() const
 {
 	cv::Scalar color = cv::Scalar(255, 0, 0);
-	for (const cv::Rect& obj : myObjects)
+	for (size_t i = 0; i < myObjects.size(); ++i)
 	{
-		rectangle(*myFrame, obj, color, 2);
+		if (hasObject(i))
+			rectangle(*myFrame, myObjects[i], color, 2);
 	}
 }
@@ -15,15 +15,21 @@
 #define __ObjectDetectorTOP__
 
 #include "TOP_CPlusPlusBase.h"
+#include "CookStats.h"
+#include "DownloadQueue.h"
+#include "ClassifierCache.h"
+#include "MultiCascade.h"
+#include "ObjectTracker.h"
 
+#include <array>
 #include <vector>
 #include <string>
+#include <cstdint>
 #include <opencv2/core.hpp>
 
 namespace cv
 {
     class Mat;
-    class CascadeClassifier;
 }
 
 /*
@@ -32,7 +38,11 @@ more information on the parameters check cv::CascadeClassifier documentation.
 It takes the following parameters:
 	- Classifier:   A path to a .xml pretrained classifier. It can be either Haar or 
 		LBP. OpenCV includes pretrained classiffiers and can be found in 
-		opencv/sources/data.
+		opencv/sources/data. It is loaded once and shared by all the detectors using it, and
+		loaded again when the file changes, see ClassifierCache.h.
+	- Classifier 2, 3 and 4:	More classifiers to detect with on the same frame, left empty
+		when unused. The frame is downloaded and made gray once for all of them, and they run
+		in parallel on a single image pyramid, see MultiCascade.h.
 	- Scale Factor: Specifies how much the image size is reduced at each image scale.
 	- Min Neighbors:    How many neighbors each candidate rectangle should have to retain it.
 	- Limit Object Size:    If on, limit the size of the detected objects.
@@ -43,7 +53,24 @@ It takes the following parameters:
 	- Limit Objects Detected:   If on, limit the number of objects detected. Turn this parameter on
 		if you need the channels outputted to CHOPInfo to be constant.
 	- Maximum Objects:  The maximum number of objects that the TOP can detects
-        - Download Type:    How the input texture is downloaded.
+	- Download Depth:	Frames in flight between the GPU and this TOP, see DownloadQueue.h.
+		0 processes the current frame and may stall the cook, the default 1 lags a frame.
+	- Detection Scale:	Detect and track on a gray image of half or a quarter of the input size,
+		made in one pass with GrayDownsample.h. The boxes are scaled back to the input and
+		Min and Max Object Size keep their meaning, but objects need to be at least the size
+		of the classifier window in the scaled down image, typically 24 pixels, to be found.
+	- Asynchronous:	If on, detect on a thread of its own so a slow detection does not stall the
+		cook. The newest frame waits there for the detection in progress to finish, older ones
+		are dropped, and the output shows the last detection that finished drawn on the
+		current frame. See DetectorThread.h.
+	- Track Between Detections:	If on, run the cascade only every few frames and follow the
+		objects in between by matching the pixels of each one around its last position, see
+		ObjectTracker.h. Each object keeps its ID and its obj# channels while it is followed.
+	- Detect Interval:	Frames between detections while tracking, 1 detects every frame.
+	- Min Confidence:	Detect again as soon as the match of a tracked object, from 0 to 1,
+		drops below this.
+	- Search Margin:	How far around its last box an object is looked for, as a fraction of
+		its size on each side.
 
 This TOP takes one input where to detect faces. Outputs the input data with the bounding boxes for the 
 detected objects. It outputs the following information to CHOPInfo and DATInfo: 
@@ -55,11 +82,41 @@ detected objects. It outputs the following information to CHOPInfo and DATInfo:
 	- obj#:ty:  Y position of the bounding box.
 	- obj#:w:   Width of the bounding box.
 	- obj#:h:   Height of the bounding box.
-
-Note that it will take two cooks to get be able to see the output of an inputted frame - as the output is delayed by one frame
+	- obj#:id:	ID of the object. While tracking, an object keeps its ID and its obj# group
+		from the detection that found it until it is lost, and a lost object leaves its
+		group with tracked 0 until a new object takes it. Otherwise the IDs count the
+		objects of each detection from 1.
+	- obj#:classifier:	Which classifier found the object, 0 for Classifier, 1 for
+		Classifier 2 and so on. A tracked object only keeps its ID when found again by the
+		same classifier.
+The Info CHOP then has:
+	- detection_age:	Frames between the frame the objects were detected on and the one
+		they are drawn on. Always 0 unless Asynchronous or Track Between Detections is on;
+		tracked objects are moved to the frame they are drawn on.
+	- detection_frames_dropped:	Frames Asynchronous skipped because a newer one arrived
+		while the detection was busy.
+The Info DAT then has a row for each of:
+	- classifier_load_ms:	Time the last loads of the classifiers took, 0 if they were already
+		loaded by another detector.
+	- classifier_loads:	Times this TOP parsed a classifier file.
+	- classifier_cache_hits:	Times a cook used an already loaded classifier.
+	- classifiers_cached:	Classifier files loaded by all the detectors in the process.
+It also outputs the download channels described in DownloadQueue.h and the cook time
+statistics described in CookStats.h to CHOPInfo, after the object channels, with the
+download, load, detect, track and upload phases.
+
+Note that the output of an inputted frame is delayed by Download Depth cooks
 */
 
 enum class OP_TOPInputDownloadType;
+class DetectorThread;
+
+enum class DetectionscaleMenuItems
+{
+	Full,
+	Half,
+	Quarter
+};
 
 // To get more help about these functions, look at TOP_CPlusPlusBase.h
 class ObjectDetectorTOP : public TD::TOP_CPlusPlusBase
@@ -83,8 +140,43 @@ public:
     virtual void        getInfoDATEntries(int32_t, int32_t, TD::OP_InfoDATEntries*, void*) override;
 
 private:
+    enum class CookPhase
+    {
+        Download,
+        Load,
+        Detect,
+        Track,
+        Upload
+    };
+
     void                handleParameters(const TD::OP_Inputs*);
 
+    int32_t             getNumObjectChans() const;
+
+    int32_t             getNumObjectRows() const;
+
+    // Objects in myObjects, a slot can be empty while tracking
+    int32_t             getNumObjects() const;
+
+    bool                hasObject(size_t slot) const;
+
+    // Classifier, Classifier 2 and so on
+    static const int    MaxClassifiers = 4;
+
+    int getScale(DetectionscaleMenuItems ds)
+    {
+        switch (ds)
+        {
+        default:
+        case DetectionscaleMenuItems::Full:
+            return 1;
+        case DetectionscaleMenuItems::Half:
+            return 2;
+        case DetectionscaleMenuItems::Quarter:
+            return 4;
+        }
+    }
+
     void                cvMatToOutput(const cv::Mat&, TD::TOP_Output*, TD::TOP_UploadInfo info) const;
 
     void                inputToMat(const TD::OP_Inputs*);
@@ -92,13 +184,16 @@ private:
     void                drawBoundingBoxes() const;
 
     cv::Mat*                myFrame;
-    cv::CascadeClassifier*  myClassifier;
+    std::array<ClassifierCache, MaxClassifiers> myClassifiers;
     std::vector<cv::Rect>   myObjects;
     std::vector<double>     myLevelWeights;
-    std::vector<int>        myRejectLevels;
+    // Index of the classifier that found each object
+    std::vector<int>        myClassifierOf;
+    // Only while Asynchronous is off
+    MultiCascade            myCascades;
 
     // Parameters
-    std::string myPath;
+    std::array<std::string, MaxClassifiers> myPaths;
     double      myScale;
     int         myMinNeighbors;
     bool        myLimitSize;
@@ -107,10 +202,30 @@ private:
     bool        myDrawBoundingBox;
     bool        myLimitObjs;
     int         myMaxObjs;
+    bool        myAsync;
+
+    // Only while Asynchronous is on
+    DetectorThread*         myDetector;
+    // Frames detected on, and the one myObjects come from
+    int64_t                 myFrameCount;
+    int64_t                 myDetectedFrame;
+    // myObjects in pixels of the image detected on
+    std::vector<cv::Rect>   myDetections;
+    // ID of the object in each slot of myObjects, 0 for an empty slot
+    std::vector<int>        myObjectIds;
+    int                     myDetectScale;
+
+    bool                    myTrack;
+    ObjectTracker::Settings myTrackSettings;
+    ObjectTracker           myTracker;
 
 	int					myExecuteCount;
 	TD::TOP_Context* myContext;
-	TD::OP_SmartRef<TD::OP_TOPDownloadResult> myPrevDownRes;
+	// The download the current frame came from
+	TD::OP_SmartRef<TD::OP_TOPDownloadResult> myFrameDownRes;
+
+	DownloadQueue		myDownloads;
+	CookStats			myCookStats;
 };
 
 #endif
@@ -0,0 +1,217 @@
+#include "ObjectTracker.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace
+{
+	// Detections that overlap a tracked object less than this are new objects
+	const double	MinOverlap = 0.3;
+
+	double
+		overlap(const cv::Rect& a, const cv::Rect& b)
+	{
+		const double	inter = (a & b).area();
+		const double	uni = a.area() + b.area() - inter;
+		return uni > 0.0 ? inter / uni : 0.0;
+	}
+}
+
+ObjectTracker::ObjectTracker() :
+	myObjects{}, myTracked{}, myNextId{ 1 }, myFramesSinceDetection{ 0 }, myDetected{ false }
+{
+}
+
+bool
+ObjectTracker::needsDetection(const Settings& settings) const
+{
+	if (!myDetected || myFramesSinceDetection + 1 >= settings.detectInterval)
+		return true;
+
+	for (const Object& obj : myObjects)
+	{
+		if (obj.id != 0 && obj.confidence < settings.minConfidence)
+			return true;
+	}
+	return false;
+}
+
+void
+ObjectTracker::update(const cv::Mat& gray, const std::vector<cv::Rect>& objects, const std::vector<double>& levelWeights,
+					  const std::vector<int>& classifierOf)
+{
+	const cv::Rect	frame(0, 0, gray.cols, gray.rows);
+
+	// Greedily pair the detections with the tracked objects that overlap them the most
+	std::vector<std::tuple<double, int, int>>	pairs;
+	for (int d = 0; d < static_cast<int>(objects.size()); ++d)
+	{
+		const int	classifier = d < static_cast<int>(classifierOf.size()) ? classifierOf[d] : 0;
+		for (int s = 0; s < static_cast<int>(myObjects.size()); ++s)
+		{
+			if (myObjects[s].id == 0 || myObjects[s].classifier != classifier)
+				continue;
+
+			const double	o = overlap(objects[d], myObjects[s].box);
+			if (o >= MinOverlap)
+				pairs.emplace_back(o, d, s);
+		}
+	}
+	std::sort(pairs.begin(), pairs.end(), [](const std::tuple<double, int, int>& a, const std::tuple<double, int, int>& b)
+	{
+		return std::get<0>(a) > std::get<0>(b);
+	});
+
+	std::vector<int>	slotOf(objects.size(), -1);
+	std::vector<bool>	slotTaken(myObjects.size(), false);
+	for (const std::tuple<double, int, int>& p : pairs)
+	{
+		const int	d = std::get<1>(p);
+		const int	s = std::get<2>(p);
+		if (slotOf[d] < 0 && !slotTaken[s])
+		{
+			slotOf[d] = s;
+			slotTaken[s] = true;
+		}
+	}
+
+	// Objects that were not detected again leave their slot empty
+	for (size_t s = 0; s < myObjects.size(); ++s)
+	{
+		if (!slotTaken[s])
+			myObjects[s] = Object();
+	}
+
+	size_t	freeSlot = 0;
+	for (size_t d = 0; d < objects.size(); ++d)
+	{
+		int	s = slotOf[d];
+		if (s < 0)
+		{
+			while (freeSlot < myObjects.size() && slotTaken[freeSlot])
+				++freeSlot;
+			if (freeSlot == myObjects.size())
+			{
+				myObjects.emplace_back();
+				myTracked.resize(myObjects.size());
+				slotTaken.push_back(false);
+			}
+			s = static_cast<int>(freeSlot);
+			slotTaken[s] = true;
+			myObjects[s].id = myNextId++;
+		}
+
+		Object&		obj = myObjects[s];
+		Tracked&	tracked = myTracked[s];
+		obj.box = objects[d] & frame;
+		obj.levelWeight = d < levelWeights.size() ? levelWeights[d] : 0.0;
+		obj.classifier = d < classifierOf.size() ? classifierOf[d] : 0;
+		obj.confidence = 1.0f;
+
+		gray(obj.box).copyTo(tracked.templ);
+		const int	side = std::max(obj.box.width, obj.box.height);
+		tracked.scale = side > TemplateSize ? static_cast<float>(TemplateSize) / side : 1.0f;
+		if (tracked.scale < 1.0f)
+		{
+			const cv::Size	small(std::max(static_cast<int>(std::lround(obj.box.width * tracked.scale)), 1),
+								  std::max(static_cast<int>(std::lround(obj.box.height * tracked.scale)), 1));
+			cv::resize(tracked.templ, tracked.smallTempl, small, 0.0, 0.0, cv::INTER_AREA);
+		}
+	}
+
+	while (!myObjects.empty() && myObjects.back().id == 0)
+		myObjects.pop_back();
+	myTracked.resize(myObjects.size());
+
+	myFramesSinceDetection = 0;
+	myDetected = true;
+}
+
+void
+ObjectTracker::track(const cv::Mat& gray, const Settings& settings)
+{
+	cv::parallel_for_(cv::Range(0, static_cast<int>(myObjects.size())), [&](const cv::Range& range)
+	{
+		for (int i = range.start; i < range.end; ++i)
+		{
+			if (myObjects[i].id != 0)
+				trackOne(gray, settings, myObjects[i], myTracked[i]);
+		}
+	});
+	++myFramesSinceDetection;
+}
+
+void
+ObjectTracker::clear()
+{
+	myObjects.clear();
+	myTracked.clear();
+	myFramesSinceDetection = 0;
+	myDetected = false;
+}
+
+const std::vector<ObjectTracker::Object>&
+ObjectTracker::getObjects() const
+{
+	return myObjects;
+}
+
+int
+ObjectTracker::getFramesSinceDetection() const
+{
+	return myFramesSinceDetection;
+}
+
+void
+ObjectTracker::trackOne(const cv::Mat& gray, const Settings& settings, Object& object, Tracked& tracked)
+{
+	const cv::Rect	frame(0, 0, gray.cols, gray.rows);
+	const cv::Rect&	box = object.box;
+	const int		marginX = std::max(static_cast<int>(box.width * settings.searchMargin), 2);
+	const int		marginY = std::max(static_cast<int>(box.height * settings.searchMargin), 2);
+	cv::Rect		window = cv::Rect(box.x - marginX, box.y - marginY, box.width + 2 * marginX, box.height + 2 * marginY) & frame;
+
+	double		best = 0.0;
+	cv::Point	at;
+	if (tracked.templ.empty())
+	{
+		object.confidence = 0.0f;
+		return;
+	}
+
+	if (tracked.scale < 1.0f)
+	{
+		// Coarse match on the scaled down window, then refine around it within a scaled pixel
+		const cv::Size	small(static_cast<int>(window.width * tracked.scale), static_cast<int>(window.height * tracked.scale));
+		if (small.width < tracked.smallTempl.cols || small.height < tracked.smallTempl.rows)
+		{
+			object.confidence = 0.0f;
+			return;
+		}
+
+		cv::resize(gray(window), tracked.smallWindow, small, 0.0, 0.0, cv::INTER_AREA);
+		cv::matchTemplate(tracked.smallWindow, tracked.smallTempl, tracked.scores, cv::TM_CCOEFF_NORMED);
+		cv::minMaxLoc(tracked.scores, nullptr, nullptr, nullptr, &at);
+
+		const int	radius = static_cast<int>(std::ceil(1.0f / tracked.scale));
+		const int	x = window.x + static_cast<int>(at.x / tracked.scale);
+		const int	y = window.y + static_cast<int>(at.y / tracked.scale);
+		window = cv::Rect(x - radius, y - radius, box.width + 2 * radius, box.height + 2 * radius) & frame;
+	}
+
+	if (window.width < tracked.templ.cols || window.height < tracked.templ.rows)
+	{
+		object.confidence = 0.0f;
+		return;
+	}
+
+	cv::matchTemplate(gray(window), tracked.templ, tracked.scores, cv::TM_CCOEFF_NORMED);
+	cv::minMaxLoc(tracked.scores, nullptr, &best, nullptr, &at);
+
+	object.box.x = window.x + at.x;
+	object.box.y = window.y + at.y;
+	object.confidence = static_cast<float>(best);
+}
@@ -0,0 +1,89 @@
+#ifndef __ObjectTracker__
+#define __ObjectTracker__
+
+#include <opencv2/core.hpp>
+
+#include <vector>
+
+/*
+Follows detected objects between detections, so the cascade only runs every few frames.
+
+update() takes the objects of a detection. Each one is matched to the tracked object of the
+same classifier it overlaps the most, and keeps its ID and slot; the rest get a new ID and
+an empty slot, and tracked objects that were not detected again are dropped. The pixels
+inside every box are kept as its template.
+
+track() looks for every template around its last box, in a search window grown by Search
+Margin times the box size on each side, with normalized cross-correlation. Large boxes are
+first matched on the window scaled down to TemplateSize pixels, then refined at full
+resolution around that match. The best correlation is the confidence of the object: when
+one drops below Min Confidence, or Detect Interval frames have passed since the last
+update(), needsDetection() asks for a new detection.
+
+The objects are tracked in parallel with cv::parallel_for_.
+*/
+class ObjectTracker
+{
+public:
+	struct Settings
+	{
+		// Frames between detections, 1 detects every frame
+		int		detectInterval = 10;
+		float	minConfidence = 0.6f;
+		float	searchMargin = 0.5f;
+	};
+
+	struct Object
+	{
+		// 0 for an empty slot
+		int			id = 0;
+		cv::Rect	box;
+		double		levelWeight = 0.0;
+		// Index of the classifier that found it
+		int			classifier = 0;
+		// Correlation of the last match, 1 right after a detection
+		float		confidence = 0.0f;
+	};
+
+	ObjectTracker();
+
+	bool	needsDetection(const Settings& settings) const;
+
+	// objects, levelWeights and classifierOf were detected on gray, 8 bit single channel
+	void	update(const cv::Mat& gray, const std::vector<cv::Rect>& objects, const std::vector<double>& levelWeights,
+				   const std::vector<int>& classifierOf);
+
+	// Moves the objects to where their templates match best in gray
+	void	track(const cv::Mat& gray, const Settings& settings);
+
+	void	clear();
+
+	// An object keeps its slot while it is tracked, the last slot is never empty
+	const std::vector<Object>&	getObjects() const;
+
+	int		getFramesSinceDetection() const;
+
+private:
+	// Side of the template the coarse match scales large boxes to
+	static const int	TemplateSize = 32;
+
+	// Templates and scratch images of a slot
+	struct Tracked
+	{
+		cv::Mat		templ;
+		cv::Mat		smallTempl;
+		float		scale = 1.0f;
+		cv::Mat		smallWindow;
+		cv::Mat		scores;
+	};
+
+	void	trackOne(const cv::Mat& gray, const Settings& settings, Object& object, Tracked& tracked);
+
+	std::vector<Object>		myObjects;
+	std::vector<Tracked>	myTracked;
+	int						myNextId;
+	int						myFramesSinceDetection;
+	bool					myDetected;
+};
+
+#endif // !__ObjectTracker__
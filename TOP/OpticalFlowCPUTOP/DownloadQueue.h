@@ -0,0 +1,150 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#ifndef __DownloadQueue__
+#define __DownloadQueue__
+
+#include "CPlusPlus_Common.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+
+/*
+Downloads an input TOP to CPU memory with a configurable number of frames in flight. The
+same header is copied in every CPU memory TOP folder, like CookStats.h.
+
+push() starts the download of this cook and returns the one that is due:
+	- Depth 0:	The download just started. getData() stalls the cook until the GPU is done,
+		but the output is from the current frame.
+	- Depth N:	The download started N cooks ago, which has usually arrived by then. The
+		output lags N frames behind the input.
+It returns an empty reference while the queue fills up. When the depth is lowered the
+older downloads are dropped so the lag shrinks at once.
+
+It outputs the following channels to the Info CHOP:
+	- download_latency_ms:	Time from starting the due download to its data being ready in
+		the cook that uses it. At depth 0 that is the transfer, at depth N it is mostly the N
+		cooks in between, however fast the transfer was.
+	- download_stall_ms:	Part of that time the cook spent waiting in getData(), at the
+		current depth. When it is high raising the depth removes it. A stall near 0 does not
+		tell whether a lower depth would stall, only lowering the depth and watching this
+		channel does.
+*/
+class DownloadQueue
+{
+public:
+	DownloadQueue(int depth = 1) :
+		myDepth{ std::max(depth, 0) }, myLatencyMs{ 0.0 }, myStallMs{ 0.0 }
+	{
+	}
+
+	void
+	setDepth(int depth)
+	{
+		myDepth = std::max(depth, 0);
+	}
+
+	int
+	getDepth() const
+	{
+		return myDepth;
+	}
+
+	// Returns an empty reference when the download could not be started or the queue is
+	// not full yet. The data of the result is ready, getData() does not wait
+	TD::OP_SmartRef<TD::OP_TOPDownloadResult>
+	push(const TD::OP_TOPInput* top, const TD::OP_TOPInputDownloadOptions& opts)
+	{
+		TD::OP_SmartRef<TD::OP_TOPDownloadResult>	downRes = top->downloadTexture(opts, nullptr);
+		if (!downRes)
+			return TD::OP_SmartRef<TD::OP_TOPDownloadResult>();
+
+		myPending.push_back({ std::move(downRes), Clock::now() });
+		if (myPending.size() <= static_cast<size_t>(myDepth))
+			return TD::OP_SmartRef<TD::OP_TOPDownloadResult>();
+
+		while (myPending.size() > static_cast<size_t>(myDepth) + 1)
+			myPending.pop_front();
+
+		Pending	due = std::move(myPending.front());
+		myPending.pop_front();
+
+		const Clock::time_point	waitStart = Clock::now();
+		due.result->getData();
+		const Clock::time_point	ready = Clock::now();
+
+		myStallMs = std::chrono::duration<double, std::milli>(ready - waitStart).count();
+		myLatencyMs = std::chrono::duration<double, std::milli>(ready - due.started).count();
+		return std::move(due.result);
+	}
+
+	// Drops the downloads in flight, for when the input goes away
+	void
+	clear()
+	{
+		myPending.clear();
+	}
+
+	int32_t
+	getNumInfoCHOPChans() const
+	{
+		return static_cast<int32_t>(InfoChan::Size);
+	}
+
+	void
+	getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan) const
+	{
+		switch (static_cast<InfoChan>(index))
+		{
+			case InfoChan::Latency:
+			default:
+			{
+				chan->name->setString("download_latency_ms");
+				chan->value = static_cast<float>(myLatencyMs);
+				break;
+			}
+			case InfoChan::Stall:
+			{
+				chan->name->setString("download_stall_ms");
+				chan->value = static_cast<float>(myStallMs);
+				break;
+			}
+		}
+	}
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	enum class InfoChan
+	{
+		Latency,
+		Stall,
+		Size
+	};
+
+	struct Pending
+	{
+		TD::OP_SmartRef<TD::OP_TOPDownloadResult>	result;
+		Clock::time_point							started;
+	};
+
+	int					myDepth;
+	std::deque<Pending>	myPending;
+	double				myLatencyMs;
+	double				myStallMs;
+};
+
+#endif // !__DownloadQueue__
@@ -0,0 +1,116 @@
+#include "FlowUpsample.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	// Standard deviation of the spatial weight, in flow cells
+	const float	SigmaSpatial = 1.0f;
+
+	// Neighbouring cells and their spatial weights for each output column or row
+	struct Taps
+	{
+		int		index[3];
+		float	weight[3];
+	};
+
+	void
+		makeTaps(std::vector<Taps>& taps, int outSize, int inSize)
+	{
+		const float	ratio = static_cast<float>(inSize) / outSize;
+		taps.resize(outSize);
+		for (int i = 0; i < outSize; ++i)
+		{
+			// Position of the output pixel centre in flow cells
+			const float	f = (i + 0.5f) * ratio - 0.5f;
+			const int	nearest = static_cast<int>(std::lround(f));
+			for (int k = 0; k < 3; ++k)
+			{
+				const int	c = nearest + k - 1;
+				const float	d = c - f;
+				taps[i].index[k] = std::min(std::max(c, 0), inSize - 1);
+				taps[i].weight[k] = std::exp(-d * d / (2.0f * SigmaSpatial * SigmaSpatial));
+			}
+		}
+	}
+}
+
+void
+upsampleFlow(const cv::Mat& flow, cv::Mat& out, cv::Size size)
+{
+	const double	sx = static_cast<double>(size.width) / flow.cols;
+	const double	sy = static_cast<double>(size.height) / flow.rows;
+
+	cv::resize(flow, out, size, 0, 0, cv::INTER_LINEAR);
+	cv::multiply(out, cv::Scalar(sx, sy), out);
+}
+
+void
+upsampleFlowJointBilateral(const cv::Mat& flow, const cv::Mat& smallGuide, const cv::Mat& guide,
+						   cv::Mat& out, float sigmaRange)
+{
+	const int	width = guide.cols;
+	const int	height = guide.rows;
+	const float	sx = static_cast<float>(width) / flow.cols;
+	const float	sy = static_cast<float>(height) / flow.rows;
+
+	out.create(height, width, CV_32FC2);
+
+	std::vector<Taps>	columns;
+	std::vector<Taps>	rows;
+	makeTaps(columns, width, flow.cols);
+	makeTaps(rows, height, flow.rows);
+
+	std::array<float, 256>	range;
+	const float	sigma = std::max(sigmaRange, 0.5f);
+	for (int i = 0; i < 256; ++i)
+		range[i] = std::exp(-static_cast<float>(i * i) / (2.0f * sigma * sigma));
+
+	cv::parallel_for_(cv::Range(0, height), [&](const cv::Range& band)
+	{
+		for (int y = band.start; y < band.end; ++y)
+		{
+			const Taps&		ty = rows[y];
+			const uint8_t*	g = guide.ptr<uint8_t>(y);
+			cv::Vec2f*		o = out.ptr<cv::Vec2f>(y);
+
+			for (int x = 0; x < width; ++x)
+			{
+				const Taps&	tx = columns[x];
+				float	sum = 0.0f;
+				float	vx = 0.0f;
+				float	vy = 0.0f;
+
+				for (int j = 0; j < 3; ++j)
+				{
+					const cv::Vec2f*	f = flow.ptr<cv::Vec2f>(ty.index[j]);
+					const uint8_t*		s = smallGuide.ptr<uint8_t>(ty.index[j]);
+					for (int i = 0; i < 3; ++i)
+					{
+						const int	c = tx.index[i];
+						const float	w = ty.weight[j] * tx.weight[i] * range[std::abs(g[x] - s[c])];
+						vx += w * f[c][0];
+						vy += w * f[c][1];
+						sum += w;
+					}
+				}
+
+				// Every cell around is far off in luminance, take the nearest one
+				if (sum < 1e-12f)
+				{
+					const cv::Vec2f&	f = flow.ptr<cv::Vec2f>(ty.index[1])[tx.index[1]];
+					o[x] = cv::Vec2f(f[0] * sx, f[1] * sy);
+				}
+				else
+				{
+					o[x] = cv::Vec2f(vx / sum * sx, vy / sum * sy);
+				}
+			}
+		}
+	});
+}
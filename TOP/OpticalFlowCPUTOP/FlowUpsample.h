@@ -0,0 +1,27 @@
+#ifndef __FlowUpsample__
+#define __FlowUpsample__
+
+#include <opencv2/core.hpp>
+
+/*
+Brings a flow computed on a smaller frame back to the output size. The vectors are
+multiplied by the size ratio of each axis, so they stay in output pixels.
+
+upsampleFlow() is a bilinear resize. upsampleFlowJointBilateral() is a joint bilateral
+upsample (Kopf et al. 2007): every output pixel averages the 3x3 flow cells around it,
+weighted by their distance and by how close the luminance of the cell, taken from the
+small guide, is to the luminance of the pixel, taken from the full size guide. Flow then
+follows the edges of the full size frame instead of bleeding across them. The spatial
+weights are separable and precomputed per row and column, the range weights come from a
+256 entry table, and the rows are split with cv::parallel_for_.
+*/
+
+// flow is CV_32FC2, out is created with size
+void	upsampleFlow(const cv::Mat& flow, cv::Mat& out, cv::Size size);
+
+// smallGuide is the 8 bit frame flow was computed from, guide the same frame at the output
+// size. sigmaRange is in 8 bit luminance levels
+void	upsampleFlowJointBilateral(const cv::Mat& flow, const cv::Mat& smallGuide, const cv::Mat& guide,
+								   cv::Mat& out, float sigmaRange);
+
+#endif // !__FlowUpsample__
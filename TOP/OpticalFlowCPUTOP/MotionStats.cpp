@@ -0,0 +1,334 @@
+#include "MotionStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MOTIONSTATS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// tan(22.5 degrees), where a direction bin ends
+	const float	BinEdge = 0.41421356f;
+
+	enum class Chan
+	{
+		MeanVx,
+		MeanVy,
+		MeanMagnitude,
+		MaxMagnitude,
+		Size
+	};
+
+	const int	NumRegionChans = 3;
+
+	// Bin 0 is +x and they turn towards +y, -1 for no motion
+	inline int
+		directionOf(float vx, float vy)
+	{
+		const float	ax = std::fabs(vx);
+		const float	ay = std::fabs(vy);
+		if (ay < BinEdge * ax)
+			return vx > 0.0f ? 0 : 4;
+		if (ax < BinEdge * ay)
+			return vy > 0.0f ? 2 : 6;
+		if (vx > 0.0f)
+			return vy > 0.0f ? 1 : 7;
+		if (vx < 0.0f)
+			return vy > 0.0f ? 3 : 5;
+		return -1;
+	}
+
+#ifdef MOTIONSTATS_SSE2
+	inline float
+		horizontalSum(__m128 v)
+	{
+		v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+		v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+		return _mm_cvtss_f32(v);
+	}
+
+	inline float
+		horizontalMax(__m128 v)
+	{
+		v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+		v = _mm_max_ss(v, _mm_shuffle_ps(v, v, 1));
+		return _mm_cvtss_f32(v);
+	}
+#endif
+}
+
+void
+MotionStats::Sums::add(const Sums& other)
+{
+	vx += other.vx;
+	vy += other.vy;
+	magnitude += other.magnitude;
+	maxMagnitude = std::max(maxMagnitude, other.maxMagnitude);
+	for (int i = 0; i < NumDirections; ++i)
+		directions[i] += other.directions[i];
+}
+
+MotionStats::MotionStats() :
+	myScaleX{ 1.0f }, myScaleY{ 1.0f }, myRegionsX{ 0 }, myRegionsY{ 0 }, myNumPixels{ 0 }
+{
+}
+
+void
+MotionStats::compute(const cv::Mat& flow, int regionsX, int regionsY, float scaleX, float scaleY)
+{
+	myScaleX = scaleX;
+	myScaleY = scaleY;
+	const int	width = flow.cols;
+	const int	height = flow.rows;
+	myRegionsX = std::min(std::max(regionsX, 1), std::max(width, 1));
+	myRegionsY = std::min(std::max(regionsY, 1), std::max(height, 1));
+	myNumPixels = static_cast<uint64_t>(width) * height;
+
+	const int	numRegions = myRegionsX * myRegionsY;
+	const int	numBands = std::max(std::min(cv::getNumThreads(), height), 1);
+
+	// Column x is in region x * regionsX / width, myColumns holds where each region starts
+	myColumns.resize(myRegionsX + 1);
+	for (int i = 0; i <= myRegionsX; ++i)
+		myColumns[i] = (i * width + myRegionsX - 1) / myRegionsX;
+
+	myBands.assign(static_cast<size_t>(numBands) * numRegions, Sums());
+	cv::parallel_for_(cv::Range(0, numBands), [&](const cv::Range& range)
+	{
+		for (int band = range.start; band < range.end; ++band)
+		{
+			Sums*	sums = myBands.data() + static_cast<size_t>(band) * numRegions;
+			for (int y = height * band / numBands; y < height * (band + 1) / numBands; ++y)
+				reduceRow(flow.ptr<float>(y), width, sums + (y * myRegionsY / height) * myRegionsX);
+		}
+	});
+
+	myTotal = Sums();
+	myRegions.assign(numRegions, Sums());
+	for (int band = 0; band < numBands; ++band)
+	{
+		for (int r = 0; r < numRegions; ++r)
+			myRegions[r].add(myBands[static_cast<size_t>(band) * numRegions + r]);
+	}
+
+	myRegionPixels.assign(myRegionsY, 0);
+	for (int y = 0; y < height; ++y)
+		myRegionPixels[y * myRegionsY / height]++;
+
+	for (int ry = 0; ry < myRegionsY; ++ry)
+	{
+		for (int rx = 0; rx < myRegionsX; ++rx)
+		{
+			Sums&	region = myRegions[ry * myRegionsX + rx];
+			myTotal.add(region);
+
+			const double	count = static_cast<double>(myRegionPixels[ry]) * (myColumns[rx + 1] - myColumns[rx]);
+			if (count > 0.0)
+			{
+				region.vx /= count;
+				region.vy /= count;
+				region.magnitude /= count;
+			}
+		}
+	}
+
+	const double	totalMagnitude = myTotal.magnitude;
+	for (double& d : myTotal.directions)
+		d = totalMagnitude > 0.0 ? d / totalMagnitude : 0.0;
+	if (myNumPixels > 0)
+	{
+		myTotal.vx /= myNumPixels;
+		myTotal.vy /= myNumPixels;
+		myTotal.magnitude /= myNumPixels;
+	}
+}
+
+void
+MotionStats::clear()
+{
+	myRegionsX = 0;
+	myRegionsY = 0;
+	myNumPixels = 0;
+	myTotal = Sums();
+	myRegions.clear();
+}
+
+int32_t
+MotionStats::getNumInfoCHOPChans() const
+{
+	return static_cast<int32_t>(Chan::Size) + NumDirections + NumRegionChans * static_cast<int32_t>(myRegions.size());
+}
+
+void
+MotionStats::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan) const
+{
+	if (index < static_cast<int32_t>(Chan::Size))
+	{
+		switch (static_cast<Chan>(index))
+		{
+			case Chan::MeanVx:
+			default:
+			{
+				chan->name->setString("motion_mean_vx");
+				chan->value = static_cast<float>(myTotal.vx);
+				break;
+			}
+			case Chan::MeanVy:
+			{
+				chan->name->setString("motion_mean_vy");
+				chan->value = static_cast<float>(myTotal.vy);
+				break;
+			}
+			case Chan::MeanMagnitude:
+			{
+				chan->name->setString("motion_mean_magnitude");
+				chan->value = static_cast<float>(myTotal.magnitude);
+				break;
+			}
+			case Chan::MaxMagnitude:
+			{
+				chan->name->setString("motion_max_magnitude");
+				chan->value = myTotal.maxMagnitude;
+				break;
+			}
+		}
+		return;
+	}
+	index -= static_cast<int32_t>(Chan::Size);
+
+	if (index < NumDirections)
+	{
+		std::string	name = "motion_direction" + std::to_string(index);
+		chan->name->setString(name.c_str());
+		chan->value = static_cast<float>(myTotal.directions[index]);
+		return;
+	}
+	index -= NumDirections;
+
+	const int	region = index / NumRegionChans;
+	const Sums&	sums = myRegions[region];
+	std::string	name = "motion_region" + std::to_string(region % myRegionsX) + "_" + std::to_string(region / myRegionsX);
+	switch (index % NumRegionChans)
+	{
+		case 0:
+		default:
+			name += "_vx";
+			chan->value = static_cast<float>(sums.vx);
+			break;
+		case 1:
+			name += "_vy";
+			chan->value = static_cast<float>(sums.vy);
+			break;
+		case 2:
+			name += "_magnitude";
+			chan->value = static_cast<float>(sums.magnitude);
+			break;
+	}
+	chan->name->setString(name.c_str());
+}
+
+void
+MotionStats::reduceRow(const float* row, int width, Sums* regions)
+{
+	for (int rx = 0; rx < myRegionsX; ++rx)
+	{
+		const int	begin = myColumns[rx];
+		const int	end = std::min(myColumns[rx + 1], width);
+		const float*	p = row + 2 * begin;
+		const int	count = end - begin;
+		int			i = 0;
+
+		float	vx = 0.0f;
+		float	vy = 0.0f;
+		float	magnitude = 0.0f;
+		float	maxMagnitude = 0.0f;
+		std::array<float, NumDirections>	directions{};
+
+#ifdef MOTIONSTATS_SSE2
+		const __m128	edge = _mm_set1_ps(BinEdge);
+		const __m128	absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+		const __m128	zero = _mm_setzero_ps();
+		const __m128	scaleX = _mm_set1_ps(myScaleX);
+		const __m128	scaleY = _mm_set1_ps(myScaleY);
+		__m128	sumX = zero;
+		__m128	sumY = zero;
+		__m128	sumM = zero;
+		__m128	maxM = zero;
+		__m128	bins[NumDirections];
+		for (__m128& b : bins)
+			b = zero;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			// Two vx, vy pairs in each load, split into 4 vx and 4 vy
+			const __m128	a = _mm_loadu_ps(p + 2 * i);
+			const __m128	b = _mm_loadu_ps(p + 2 * i + 4);
+			const __m128	x = _mm_mul_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), scaleX);
+			const __m128	y = _mm_mul_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)), scaleY);
+			const __m128	m = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)));
+
+			sumX = _mm_add_ps(sumX, x);
+			sumY = _mm_add_ps(sumY, y);
+			sumM = _mm_add_ps(sumM, m);
+			maxM = _mm_max_ps(maxM, m);
+
+			const __m128	ax = _mm_and_ps(x, absMask);
+			const __m128	ay = _mm_and_ps(y, absMask);
+			const __m128	horizontal = _mm_cmplt_ps(ay, _mm_mul_ps(edge, ax));
+			const __m128	vertical = _mm_cmplt_ps(ax, _mm_mul_ps(edge, ay));
+			const __m128	mh = _mm_and_ps(horizontal, m);
+			const __m128	mv = _mm_and_ps(vertical, m);
+			const __m128	md = _mm_andnot_ps(_mm_or_ps(horizontal, vertical), m);
+			const __m128	px = _mm_cmpgt_ps(x, zero);
+			const __m128	nx = _mm_cmplt_ps(x, zero);
+			const __m128	py = _mm_cmpgt_ps(y, zero);
+			const __m128	ny = _mm_cmplt_ps(y, zero);
+			const __m128	mdpx = _mm_and_ps(md, px);
+			const __m128	mdnx = _mm_and_ps(md, nx);
+
+			bins[0] = _mm_add_ps(bins[0], _mm_and_ps(mh, px));
+			bins[1] = _mm_add_ps(bins[1], _mm_and_ps(mdpx, py));
+			bins[2] = _mm_add_ps(bins[2], _mm_and_ps(mv, py));
+			bins[3] = _mm_add_ps(bins[3], _mm_and_ps(mdnx, py));
+			bins[4] = _mm_add_ps(bins[4], _mm_and_ps(mh, nx));
+			bins[5] = _mm_add_ps(bins[5], _mm_and_ps(mdnx, ny));
+			bins[6] = _mm_add_ps(bins[6], _mm_and_ps(mv, ny));
+			bins[7] = _mm_add_ps(bins[7], _mm_and_ps(mdpx, ny));
+		}
+
+		vx = horizontalSum(sumX);
+		vy = horizontalSum(sumY);
+		magnitude = horizontalSum(sumM);
+		maxMagnitude = horizontalMax(maxM);
+		for (int d = 0; d < NumDirections; ++d)
+			directions[d] = horizontalSum(bins[d]);
+#endif
+
+		for (; i < count; ++i)
+		{
+			const float	x = p[2 * i] * myScaleX;
+			const float	y = p[2 * i + 1] * myScaleY;
+			const float	m = std::sqrt(x * x + y * y);
+			vx += x;
+			vy += y;
+			magnitude += m;
+			maxMagnitude = std::max(maxMagnitude, m);
+
+			const int	d = directionOf(x, y);
+			if (d >= 0)
+				directions[d] += m;
+		}
+
+		Sums&	sums = regions[rx];
+		sums.vx += vx;
+		sums.vy += vy;
+		sums.magnitude += magnitude;
+		sums.maxMagnitude = std::max(sums.maxMagnitude, maxMagnitude);
+		for (int d = 0; d < NumDirections; ++d)
+			sums.directions[d] += directions[d];
+	}
+}
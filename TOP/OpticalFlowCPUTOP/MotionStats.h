@@ -0,0 +1,76 @@
+#ifndef __MotionStats__
+#define __MotionStats__
+
+#include "CPlusPlus_Common.h"
+
+#include <opencv2/core.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/*
+Reduces a CV_32FC2 flow to a few numbers for the Info CHOP, so they do not have to be
+computed from a readback of the output texture:
+	- motion_mean_vx, motion_mean_vy:	Mean flow vector.
+	- motion_mean_magnitude, motion_max_magnitude:	Mean and largest vector length.
+	- motion_direction0 to motion_direction7:	Share of the total magnitude moving in each
+		of 8 directions, 45 degrees apart, starting at +x and turning towards +y. They add
+		up to 1, or are all 0 without motion.
+	- motion_region<x>_<y>_vx, _vy, _magnitude:	Mean vector and length inside each cell of
+		a regions x by regions y grid, x and y counting from the first column and row of
+		the flow.
+All of them are in the units and orientation of the flow itself.
+
+The frame is split in row bands reduced with cv::parallel_for_. Each row is cut at the
+region columns and every piece is reduced 4 pixels at a time with SSE2: the direction bin
+is picked by comparing |vx| and |vy| against tan(22.5 degrees) instead of an atan2.
+*/
+class MotionStats
+{
+public:
+	static const int	NumDirections = 8;
+
+	MotionStats();
+
+	// The vectors are multiplied by scaleX and scaleY first, to report a flow computed on a
+	// scaled down frame in output pixels
+	void		compute(const cv::Mat& flow, int regionsX, int regionsY, float scaleX = 1.0f, float scaleY = 1.0f);
+
+	// No motion and no regions, until the next compute()
+	void		clear();
+
+	int32_t		getNumInfoCHOPChans() const;
+
+	void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan) const;
+
+private:
+	// Sums of one region, or of the whole frame
+	struct Sums
+	{
+		double	vx = 0.0;
+		double	vy = 0.0;
+		double	magnitude = 0.0;
+		float	maxMagnitude = 0.0f;
+		std::array<double, NumDirections>	directions{};
+
+		void	add(const Sums& other);
+	};
+
+	void	reduceRow(const float* row, int width, Sums* regions);
+
+	float					myScaleX;
+	float					myScaleY;
+	int						myRegionsX;
+	int						myRegionsY;
+	uint64_t				myNumPixels;
+	Sums					myTotal;
+	// Region sums, then their means once compute() is done
+	std::vector<Sums>		myRegions;
+	// Region sums of each band
+	std::vector<Sums>		myBands;
+	std::vector<int>		myRegionPixels;
+	std::vector<int>		myColumns;
+};
+
+#endif // !__MotionStats__
@@ -14,8 +14,11 @@
 
 #include "OpticalFlowCPUTOP.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
 #include <opencv2/video/tracking.hpp>
 
 // These functions are basic C function, which the DLL loader can find
@@ -75,7 +78,12 @@ DestroyTOPInstance(TD::TOP_CPlusPlusBase* instance, TD::TOP_Context *context)
 
 OpticalFlowCPUTOP::OpticalFlowCPUTOP(const TD::OP_NodeInfo*, TD::TOP_Context *context) :
 	myFrame{ new cv::Mat() }, myPrev{ new cv::Mat() }, myFlow{ new cv::Mat() },
-	myContext(context), myExecuteCount(0), myPrevDownRes(nullptr)
+	myPrevGuide{ new cv::Mat() }, myUpsampled{ new cv::Mat() },
+	myFrameCount{ 0 }, myPrevFrame{ 0 },
+	myDISPreset{ DispresetMenuItems::Ultrafast }, myTrackedPoints{ 0 }, myPyramidsBuilt{ 0 }, myTileMargin{ 0 }, myHasMotionStats{ false },
+	myContext(context), myExecuteCount(0),
+	myDownloads{ 1 },
+	myCookStats{ "download", "flow", "upload" }
 {
 }
 
@@ -84,6 +92,8 @@ OpticalFlowCPUTOP::~OpticalFlowCPUTOP()
 	delete myFrame;
 	delete myPrev;
 	delete myFlow;
+	delete myPrevGuide;
+	delete myUpsampled;
 }
 
 void
@@ -96,57 +106,405 @@ OpticalFlowCPUTOP::getGeneralInfo(TD::TOP_GeneralInfo* ginfo, const TD::OP_Input
 void
 OpticalFlowCPUTOP::execute(TD::TOP_Output* output, const TD::OP_Inputs* inputs, void*)
 {
+	CookStats::Cook	cook(myCookStats);
 	myExecuteCount++;
 
 	using namespace cv;
 
+	AlgorithmMenuItems algorithm = static_cast<AlgorithmMenuItems>(inputs->getParInt("Algorithm"));
+	bool isFarneback = algorithm == AlgorithmMenuItems::Farneback;
+	bool isSparse = algorithm == AlgorithmMenuItems::Sparsetodense;
+	inputs->enablePar("Dispreset", algorithm == AlgorithmMenuItems::Dis);
+	inputs->enablePar("Gridstep", isSparse);
+	inputs->enablePar("Numlevels", isFarneback || isSparse);
+	inputs->enablePar("Windowsize", isFarneback || isSparse);
+	inputs->enablePar("Iterations", isFarneback || isSparse);
+	inputs->enablePar("Pyramidscale", isFarneback);
+	inputs->enablePar("Polyn", isFarneback);
+	inputs->enablePar("Polysigma", isFarneback);
+	inputs->enablePar("Usegaussianfilter", isFarneback);
+	inputs->enablePar("Usepreviousflow", isFarneback);
+	inputs->enablePar("Tiles", isFarneback);
+	inputs->enablePar("Tileoverlap", isFarneback && inputs->getParInt("Tiles", 0) * inputs->getParInt("Tiles", 1) > 1);
+	int scale = getScale(static_cast<ComputescaleMenuItems>(inputs->getParInt("Computescale")));
+	bool edgeAware = scale > 1 && inputs->getParInt("Edgeaware");
+	inputs->enablePar("Edgeaware", scale > 1);
+	inputs->enablePar("Edgesigma", edgeAware);
+	bool motionStats = inputs->getParInt("Motionstats") ? true : false;
+	inputs->enablePar("Statsregions", motionStats);
+	if (!motionStats)
+		myMotionStats.clear();
+	myHasMotionStats = motionStats;
+	myTrackedPoints = 0;
+	myPyramidsBuilt = 0;
+	myTileMargin = 0;
+
+	myCookStats.beginPhase(CookPhase::Download);
 	inputToMat(inputs);
+	myCookStats.endPhase();
 	if (myFrame->empty())
 		return;
 
-	if (!myPrevDownRes)
-		return;
+	// Numbers the frames for the pyramid cache
+	myFrameCount++;
 
 	TD::TOP_UploadInfo info;
-	info.textureDesc.width = myPrevDownRes->textureDesc.width;
-	info.textureDesc.height = myPrevDownRes->textureDesc.height;
+	info.textureDesc.width = myFrame->cols;
+	info.textureDesc.height = myFrame->rows;
 	info.textureDesc.texDim = TD::OP_TexDim::e2D;
 	info.textureDesc.pixelFormat = TD::OP_PixelFormat::RG32Float;
 	info.colorBufferIndex = 0;
 
 	Size outSize = Size(info.textureDesc.width, info.textureDesc.height);
-	resize(*myFrame, *myFrame, outSize);
-	
-	if (myPrev->empty() || myPrev->size() != outSize)
+	myCookStats.beginPhase(CookPhase::Flow);
+
+	// The flow is computed on myFrame, the input size frame is kept to guide the upsample
+	Mat full = *myFrame;
+	Size computeSize = outSize;
+	if (scale > 1)
+	{
+		computeSize = Size(std::max(outSize.width / scale, 1), std::max(outSize.height / scale, 1));
+		resize(full, *myFrame, computeSize, 0, 0, INTER_AREA);
+		myCookStats.addAllocated(myFrame->total());
+	}
+
+	if (myPrev->empty() || myPrev->size() != computeSize)
 	{
 		*myPrev = std::move(*myFrame);
+		*myPrevGuide = scale > 1 ? full : Mat();
+		myPrevFrame = myFrameCount;
+		myCookStats.endPhase();
 		return;
 	}
 
-	bool usegaussianfilter = inputs->getParInt("Usegaussianfilter") ? true : false;
-	bool usepreviousflow = inputs->getParInt("Usepreviousflow") ? true : false;
-	int myFlags = usegaussianfilter ? cv::OPTFLOW_FARNEBACK_GAUSSIAN : 0;
-	myFlags |= usepreviousflow ? cv::OPTFLOW_USE_INITIAL_FLOW : 0;
+	calcFlow(algorithm, inputs);
 
-	if (myFlow->empty() || myFlow->size() != outSize)
+	// Reduced before the upsample, with the vectors scaled to output pixels
+	if (motionStats)
 	{
-		*myFlow = Mat(outSize, CV_32FC2);
-		myFlags &= ~OPTFLOW_USE_INITIAL_FLOW;
+		float sx = static_cast<float>(outSize.width) / computeSize.width;
+		float sy = static_cast<float>(outSize.height) / computeSize.height;
+		myMotionStats.compute(*myFlow, inputs->getParInt("Statsregions", 0), inputs->getParInt("Statsregions", 1), sx, sy);
 	}
 
-	calcOpticalFlowFarneback(
-		*myPrev, *myFrame, *myFlow, inputs->getParDouble("Pyramidscale"), inputs->getParInt("Numlevels"), inputs->getParInt("Windowsize"),
-		inputs->getParInt("Iterations"), inputs->getParInt("Polyn"), inputs->getParDouble("Polysigma"), myFlags
-	);
+	const Mat* result = myFlow;
+	if (scale > 1)
+	{
+		Size oldSize = myUpsampled->size();
+		if (edgeAware && myPrevGuide->size() == outSize)
+		{
+			float sigma = static_cast<float>(inputs->getParDouble("Edgesigma"));
+			upsampleFlowJointBilateral(*myFlow, *myPrev, *myPrevGuide, *myUpsampled, sigma);
+		}
+		else
+		{
+			upsampleFlow(*myFlow, *myUpsampled, outSize);
+		}
+		if (myUpsampled->size() != oldSize)
+			myCookStats.addAllocated(myUpsampled->total() * myUpsampled->elemSize());
+		result = myUpsampled;
+	}
 
 	*myPrev = std::move(*myFrame);
+	*myPrevGuide = scale > 1 ? full : Mat();
+	myPrevFrame = myFrameCount;
+	myCookStats.endPhase();
+
+	myCookStats.beginPhase(CookPhase::Upload);
+	cvMatToOutput(*result, output, info);
+	myCookStats.addAllocated(result->total() * result->elemSize());
+	myCookStats.endPhase();
+}
 
-	cvMatToOutput(*myFlow, output, info);
+void
+OpticalFlowCPUTOP::calcFlow(AlgorithmMenuItems algorithm, const TD::OP_Inputs* inputs)
+{
+	using namespace cv;
+
+	Size size = myFrame->size();
+	bool newFlow = myFlow->empty() || myFlow->size() != size;
+	if (newFlow)
+	{
+		*myFlow = Mat(size, CV_32FC2);
+		myCookStats.addAllocated(myFlow->total() * myFlow->elemSize());
+	}
+
+	switch (algorithm)
+	{
+		case AlgorithmMenuItems::Dis:
+		{
+			DispresetMenuItems preset = static_cast<DispresetMenuItems>(inputs->getParInt("Dispreset"));
+			if (!myDIS || preset != myDISPreset)
+			{
+				int disPreset = DISOpticalFlow::PRESET_ULTRAFAST;
+				if (preset == DispresetMenuItems::Fast)
+					disPreset = DISOpticalFlow::PRESET_FAST;
+				else if (preset == DispresetMenuItems::Medium)
+					disPreset = DISOpticalFlow::PRESET_MEDIUM;
+
+				myDIS = DISOpticalFlow::create(disPreset);
+				myDISPreset = preset;
+			}
+			myDIS->calc(*myPrev, *myFrame, *myFlow);
+			break;
+		}
+		case AlgorithmMenuItems::Sparsetodense:
+		{
+			SparseFlow::Settings settings;
+			settings.gridStep = inputs->getParInt("Gridstep");
+			settings.windowSize = inputs->getParInt("Windowsize");
+			settings.maxLevel = inputs->getParInt("Numlevels") - 1;
+			settings.iterations = inputs->getParInt("Iterations");
+			mySparseFlow.calc(myPrevFrame, *myPrev, myFrameCount, *myFrame, *myFlow, settings);
+			myCookStats.addAllocated(mySparseFlow.getAllocated());
+			myTrackedPoints = mySparseFlow.getNumTracked();
+			myPyramidsBuilt = mySparseFlow.getPyramidsBuilt();
+			break;
+		}
+		case AlgorithmMenuItems::Farneback:
+		default:
+		{
+			bool usegaussianfilter = inputs->getParInt("Usegaussianfilter") ? true : false;
+			bool usepreviousflow = inputs->getParInt("Usepreviousflow") ? true : false;
+			int myFlags = usegaussianfilter ? cv::OPTFLOW_FARNEBACK_GAUSSIAN : 0;
+			myFlags |= usepreviousflow && !newFlow ? cv::OPTFLOW_USE_INITIAL_FLOW : 0;
+
+			double pyramidScale = inputs->getParDouble("Pyramidscale");
+			int numLevels = inputs->getParInt("Numlevels");
+			int windowSize = inputs->getParInt("Windowsize");
+			int iterations = inputs->getParInt("Iterations");
+			int polyN = inputs->getParInt("Polyn");
+			double polySigma = inputs->getParDouble("Polysigma");
+
+			int tilesX = inputs->getParInt("Tiles", 0);
+			int tilesY = inputs->getParInt("Tiles", 1);
+			if (tilesX * tilesY > 1)
+			{
+				// Each tile runs a whole Farneback on its own core
+				double overlap = inputs->getParDouble("Tileoverlap");
+				myTileMargin = static_cast<int>(std::ceil(overlap * TiledFlow::farnebackMargin(windowSize, polyN, numLevels, pyramidScale)));
+				myTiledFlow.calc(*myPrev, *myFrame, *myFlow, tilesX, tilesY, myTileMargin, (myFlags & OPTFLOW_USE_INITIAL_FLOW) != 0,
+					[&](const Mat& prev, const Mat& next, Mat& flow)
+					{
+						calcOpticalFlowFarneback(prev, next, flow, pyramidScale, numLevels, windowSize, iterations, polyN, polySigma, myFlags);
+					});
+				myCookStats.addAllocated(myTiledFlow.getAllocated());
+			}
+			else
+			{
+				calcOpticalFlowFarneback(*myPrev, *myFrame, *myFlow, pyramidScale, numLevels, windowSize, iterations, polyN, polySigma, myFlags);
+			}
+			break;
+		}
+	}
+}
+
+int32_t
+OpticalFlowCPUTOP::getNumInfoCHOPChans(void*)
+{
+	int32_t motionChans = myHasMotionStats ? myMotionStats.getNumInfoCHOPChans() : 0;
+	return static_cast<int32_t>(InfoChopChan::Size) + motionChans + myDownloads.getNumInfoCHOPChans() + myCookStats.getNumInfoCHOPChans();
+}
+
+void
+OpticalFlowCPUTOP::getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void*)
+{
+	if (index < static_cast<int32_t>(InfoChopChan::Size))
+	{
+		switch (static_cast<InfoChopChan>(index))
+		{
+			case InfoChopChan::TrackedPoints:
+			{
+				chan->name->setString("tracked_points");
+				chan->value = static_cast<float>(myTrackedPoints);
+				break;
+			}
+			case InfoChopChan::PyramidsBuilt:
+			{
+				chan->name->setString("pyramids_built");
+				chan->value = static_cast<float>(myPyramidsBuilt);
+				break;
+			}
+			case InfoChopChan::TileMargin:
+			default:
+			{
+				chan->name->setString("tile_margin");
+				chan->value = static_cast<float>(myTileMargin);
+				break;
+			}
+		}
+		return;
+	}
+	index -= static_cast<int32_t>(InfoChopChan::Size);
+
+	if (myHasMotionStats)
+	{
+		if (index < myMotionStats.getNumInfoCHOPChans())
+		{
+			myMotionStats.getInfoCHOPChan(index, chan);
+			return;
+		}
+		index -= myMotionStats.getNumInfoCHOPChans();
+	}
+
+	// The downloads and cook statistics go after our own channels
+	if (index < myDownloads.getNumInfoCHOPChans())
+		myDownloads.getInfoCHOPChan(index, chan);
+	else
+		myCookStats.getInfoCHOPChan(index - myDownloads.getNumInfoCHOPChans(), chan);
 }
 
 void
 OpticalFlowCPUTOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 {
+	{
+		TD::OP_StringParameter p;
+		p.name = "Algorithm";
+		p.label = "Algorithm";
+		p.page = "Optical Flow";
+		p.defaultValue = "Farneback";
+		std::array<const char*, 3> Names =
+		{
+			"Farneback",
+			"Dis",
+			"Sparsetodense"
+		};
+		std::array<const char*, 3> Labels =
+		{
+			"Farneback",
+			"DIS",
+			"Sparse to Dense"
+		};
+		TD::OP_ParAppendResult res = manager->appendMenu(p, int(Names.size()), Names.data(), Labels.data());
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_StringParameter p;
+		p.name = "Dispreset";
+		p.label = "DIS Preset";
+		p.page = "Optical Flow";
+		p.defaultValue = "Fast";
+		std::array<const char*, 3> Names =
+		{
+			"Ultrafast",
+			"Fast",
+			"Medium"
+		};
+		std::array<const char*, 3> Labels =
+		{
+			"Ultrafast",
+			"Fast",
+			"Medium"
+		};
+		TD::OP_ParAppendResult res = manager->appendMenu(p, int(Names.size()), Names.data(), Labels.data());
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Gridstep";
+		p.label = "Grid Step";
+		p.page = "Optical Flow";
+		p.defaultValues[0] = 8;
+		p.minSliders[0] = 2.0;
+		p.maxSliders[0] = 32.0;
+		p.minValues[0] = 1.0;
+		p.maxValues[0] = 256.0;
+		p.clampMins[0] = true;
+		p.clampMaxes[0] = true;
+		TD::OP_ParAppendResult res = manager->appendInt(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_StringParameter p;
+		p.name = "Computescale";
+		p.label = "Compute Scale";
+		p.page = "Optical Flow";
+		p.defaultValue = "Full";
+		std::array<const char*, 3> Names =
+		{
+			"Full",
+			"Half",
+			"Quarter"
+		};
+		std::array<const char*, 3> Labels =
+		{
+			"Full",
+			"Half",
+			"Quarter"
+		};
+		TD::OP_ParAppendResult res = manager->appendMenu(p, int(Names.size()), Names.data(), Labels.data());
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Edgeaware";
+		p.label = "Edge Aware Upsample";
+		p.page = "Optical Flow";
+		p.defaultValues[0] = true;
+
+		TD::OP_ParAppendResult res = manager->appendToggle(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Edgesigma";
+		p.label = "Edge Sigma";
+		p.page = "Optical Flow";
+		p.defaultValues[0] = 12.0;
+		p.minSliders[0] = 1.0;
+		p.maxSliders[0] = 64.0;
+		p.minValues[0] = 0.5;
+		p.maxValues[0] = 255.0;
+		p.clampMins[0] = true;
+		p.clampMaxes[0] = true;
+		TD::OP_ParAppendResult res = manager->appendFloat(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Motionstats";
+		p.label = "Motion Stats";
+		p.page = "Optical Flow";
+		p.defaultValues[0] = true;
+
+		TD::OP_ParAppendResult res = manager->appendToggle(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Statsregions";
+		p.label = "Stats Regions";
+		p.page = "Optical Flow";
+		p.defaultValues[0] = 4;
+		p.defaultValues[1] = 3;
+		for (int i = 0; i < 2; ++i)
+		{
+			p.minSliders[i] = 1.0;
+			p.maxSliders[i] = 8.0;
+			p.minValues[i] = 1.0;
+			p.maxValues[i] = 32.0;
+			p.clampMins[i] = true;
+			p.clampMaxes[i] = true;
+		}
+		TD::OP_ParAppendResult res = manager->appendInt(p, 2);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
 	{
 		TD::OP_NumericParameter p;
 		p.name = "Numlevels";
@@ -273,6 +631,44 @@ OpticalFlowCPUTOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 		assert(res == TD::OP_ParAppendResult::Success);
 	}
 
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Tiles";
+		p.label = "Tiles";
+		p.page = "Optical Flow";
+		p.defaultValues[0] = 1;
+		p.defaultValues[1] = 1;
+		for (int i = 0; i < 2; ++i)
+		{
+			p.minSliders[i] = 1.0;
+			p.maxSliders[i] = 8.0;
+			p.minValues[i] = 1.0;
+			p.maxValues[i] = 16.0;
+			p.clampMins[i] = true;
+			p.clampMaxes[i] = true;
+		}
+		TD::OP_ParAppendResult res = manager->appendInt(p, 2);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Tileoverlap";
+		p.label = "Tile Overlap";
+		p.page = "Optical Flow";
+		p.defaultValues[0] = 0.25;
+		p.minSliders[0] = 0.0;
+		p.maxSliders[0] = 1.0;
+		p.minValues[0] = 0.0;
+		p.maxValues[0] = 1.0;
+		p.clampMins[0] = true;
+		p.clampMaxes[0] = true;
+		TD::OP_ParAppendResult res = manager->appendFloat(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
 	{
 		TD::OP_StringParameter p;
 		p.name = "Channel";
@@ -298,6 +694,23 @@ OpticalFlowCPUTOP::setupParameters(TD::OP_ParameterManager* manager, void*)
 		assert(res == TD::OP_ParAppendResult::Success);
 	}
 
+	{
+		TD::OP_NumericParameter p;
+		p.name = "Downloaddepth";
+		p.label = "Download Depth";
+		p.page = "Optical Flow";
+		p.defaultValues[0] = 1;
+		p.minSliders[0] = 0.0;
+		p.maxSliders[0] = 4.0;
+		p.minValues[0] = 0.0;
+		p.maxValues[0] = 8.0;
+		p.clampMins[0] = true;
+		p.clampMaxes[0] = true;
+		TD::OP_ParAppendResult res = manager->appendInt(p);
+
+		assert(res == TD::OP_ParAppendResult::Success);
+	}
+
 }
 
 void 
@@ -309,12 +722,10 @@ OpticalFlowCPUTOP::cvMatToOutput(const cv::Mat& M, TD::TOP_Output* out, TD::TOP_
 
 	TD::OP_SmartRef<TD::TOP_Buffer> buf = myContext->createOutputBuffer(imgsize, TD::TOP_BufferFlags::None, nullptr);
 
-	float*	pixel = static_cast<float*>(buf->data);
-	
-	cv::flip(M, M, 0);
-	float*	data = static_cast<float*>(static_cast<void*>(M.data));
-
-	memcpy(pixel, data, 2 * height * width * sizeof(float));
+	// Flipped straight into the buffer, M is the flow the next cook starts from and has to
+	// stay the right way up
+	cv::Mat	pixels(static_cast<int>(height), static_cast<int>(width), CV_32FC2, buf->data);
+	cv::flip(M, pixels, 0);
 
 	out->uploadBuffer(&buf, info, nullptr);
 }
@@ -326,13 +737,15 @@ OpticalFlowCPUTOP::inputToMat(const TD::OP_Inputs* in)
 	if (!top)
         {
                 *myFrame = cv::Mat();
+		myDownloads.clear();
 		return;
         }
 
 	TD::OP_TOPInputDownloadOptions	opts;
 	opts.verticalFlip = true;
 	opts.pixelFormat = TD::OP_PixelFormat::BGRA8Fixed;
-	TD::OP_SmartRef<TD::OP_TOPDownloadResult> downRes = top->downloadTexture(opts, nullptr);
+	myDownloads.setDepth(in->getParInt("Downloaddepth"));
+	TD::OP_SmartRef<TD::OP_TOPDownloadResult> downRes = myDownloads.push(top, opts);
 
 	if (!downRes)
 	{
@@ -340,32 +753,25 @@ OpticalFlowCPUTOP::inputToMat(const TD::OP_Inputs* in)
 		return;
 	}
 
-	if (myPrevDownRes)
-	{
-		uint8_t* pixel = (uint8_t*)myPrevDownRes->getData();
-
-
-		if (!pixel)
-		{
-			*myFrame = cv::Mat();
-			return;
-		}
-
-		int height = top->textureDesc.height;
-		int width = top->textureDesc.width;
+	uint8_t* pixel = (uint8_t*)downRes->getData();
 
+	if (!pixel)
+	{
+		*myFrame = cv::Mat();
+		return;
+	}
 
-		*myFrame = cv::Mat(height, width, CV_8UC1);
-		uint8_t* data = (uint8_t*)myFrame->data;
-		for (int i = 0; i < height; i += 1) {
-			for (int j = 0; j < width; j += 1) {
-				int pixelN = i * width + j;
-				int index = 4 * pixelN + static_cast<int>(in->getParInt("Channel"));
-				data[pixelN] = pixel[index];
-			}
+	int height = downRes->textureDesc.height;
+	int width = downRes->textureDesc.width;
+
+	*myFrame = cv::Mat(height, width, CV_8UC1);
+	myCookStats.addAllocated(myFrame->total());
+	uint8_t* data = (uint8_t*)myFrame->data;
+	for (int i = 0; i < height; i += 1) {
+		for (int j = 0; j < width; j += 1) {
+			int pixelN = i * width + j;
+			int index = 4 * pixelN + static_cast<int>(in->getParInt("Channel"));
+			data[pixelN] = pixel[index];
 		}
 	}
-	myPrevDownRes = std::move(downRes);
-
-	
 }
@@ -15,29 +15,88 @@
 #define __OpticalFlowCPUTOP__
 
 #include "TOP_CPlusPlusBase.h"
+#include "CookStats.h"
+#include "DownloadQueue.h"
+#include "SparseFlow.h"
+#include "FlowUpsample.h"
+#include "MotionStats.h"
+#include "TiledFlow.h"
 
-namespace cv
+#include <opencv2/core.hpp>
+#include <opencv2/video/tracking.hpp>
+
+enum class AlgorithmMenuItems
 {
-	class Mat;
-}
+	Farneback,
+	Dis,
+	Sparsetodense
+};
+
+enum class DispresetMenuItems
+{
+	Ultrafast,
+	Fast,
+	Medium
+};
+
+enum class ComputescaleMenuItems
+{
+	Full,
+	Half,
+	Quarter
+};
 
 /*
 This example implements a TOP to expose cv::cuda::FarnebackOpticalFlow class functionallity. For
 more information on the parameters check 
 https://docs.opencv.org/3.4/d9/d30/classcv_1_1cuda_1_1FarnebackOpticalFlow.html
 
+It can also compute the flow with cv::DISOpticalFlow, or track a grid of points with
+cv::calcOpticalFlowPyrLK and interpolate them to a dense flow, see SparseFlow.h. All of them
+output the flow in pixels as RG32Float.
+
 It takes the following parameters:
-	- Num Levels:	Number of pyramid layers including the intial image.
+	- Algorithm:	Farneback, DIS or Sparse to Dense. Ordered from best quality to fastest.
+	- DIS Preset:	Ultrafast, Fast or Medium preset of cv::DISOpticalFlow.
+	- Grid Step:	Distance in pixels between the points Sparse to Dense tracks.
+	- Compute Scale:	Full, Half or Quarter. The flow is computed on the input scaled down by
+		this much and upsampled back to the input size, see FlowUpsample.h. The vectors are
+		always in pixels of the output.
+	- Edge Aware Upsample:	Upsamples with a joint bilateral filter guided by the full size
+		frame instead of bilinearly, so the flow keeps to its edges.
+	- Edge Sigma:	Luminance difference, in 8 bit levels, at which Edge Aware Upsample stops
+		mixing flow across an edge.
+	- Motion Stats:	Reduces the flow to the motion statistics channels described in MotionStats.h
+		and outputs them to CHOPInfo.
+	- Stats Regions:	Columns and rows of the grid Motion Stats averages the flow in.
+	- Num Levels:	Number of pyramid layers including the intial image. Also used by Sparse to Dense.
 	- Pyramid Scale:	Image scale to build pyramid layers.
-	- Window Size:	Averaging window size.
-	- Iterations:	Number of iteration at each pyramid level.
+	- Window Size:	Averaging window size. Also the search window of Sparse to Dense.
+	- Iterations:	Number of iteration at each pyramid level. Also used by Sparse to Dense.
 	- Poly N:	Size of the pixel neighborhood used to find polynomial expansion in each pixel.
 	- Poly Sigma:	Standard deviation of the Gaussian thta is used to smooth derivatives used as
 		basis for the polynomial expansion.
 	- Use Gaussian Filter:	Uses the Gaussian Window Size x Window Size filter instead of a box filter.
 	- Use Previous Flow:	Use the optical flow of the previous frame as an estimate for the current frame.
+	- Tiles:	Columns and rows of tiles Farneback is split in, each computed on its own core,
+		see TiledFlow.h. 1 1 computes the frame in one piece.
+	- Tile Overlap:	Margin added around each tile, as a fraction of the reach of the coarsest
+		pyramid level given by Window Size, Poly N, Num Levels and Pyramid Scale. Less is faster,
+		but at 0 the flow of large motions is off over whole tiles, see TiledFlow.h.
+	- Download Depth:	Frames in flight between the GPU and this TOP, see DownloadQueue.h.
+		0 processes the current frame and may stall the cook, the default 1 lags a frame.
 
 This TOP takes one input where the optical flow of sequencial frames is calculated.
+
+It outputs the following channels to CHOPInfo:
+	- tracked_points:	Points Sparse to Dense tracked in the last cook, 0 for the other algorithms.
+	- pyramids_built:	Image pyramids Sparse to Dense built in the last cook. The pyramid of
+		each frame is cached and reused as the previous one in the next cook, see PyramidCache.h,
+		so this stays at 1 unless the frames or the pyramid settings change.
+	- tile_margin:	Margin in pixels added around each Farneback tile, 0 when not tiled.
+When Motion Stats is On, those are followed by the motion channels described in MotionStats.h.
+It also outputs the download channels described in DownloadQueue.h and the cook time
+statistics described in CookStats.h to CHOPInfo, with the download, flow and upload phases.
 */
 
 // To get more help about these functions, look at TOP_CPlusPlusBase.h
@@ -53,18 +112,71 @@ public:
 
 	virtual void		setupParameters(TD::OP_ParameterManager*, void* reserved) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void* reserved) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, TD::OP_InfoCHOPChan* chan, void* reserved) override;
+
 private:
+	enum class InfoChopChan
+	{
+		TrackedPoints,
+		PyramidsBuilt,
+		TileMargin,
+		Size
+	};
+
+	enum class CookPhase
+	{
+		Download,
+		Flow,
+		Upload
+	};
+
     void                            inputToMat(const TD::OP_Inputs*);
 
+	void				calcFlow(AlgorithmMenuItems, const TD::OP_Inputs*);
+
+	int getScale(ComputescaleMenuItems cs)
+	{
+		switch (cs)
+		{
+		default:
+		case ComputescaleMenuItems::Full:
+			return 1;
+		case ComputescaleMenuItems::Half:
+			return 2;
+		case ComputescaleMenuItems::Quarter:
+			return 4;
+		}
+	}
+
 	void 				cvMatToOutput(const cv::Mat&, TD::TOP_Output*, TD::TOP_UploadInfo) const;
 
 	cv::Mat*	myFrame;
 	cv::Mat*	myPrev;
 	cv::Mat*	myFlow;
+	// Previous frame at the input size and the flow upsampled to it, when computing scaled down
+	cv::Mat*	myPrevGuide;
+	cv::Mat*	myUpsampled;
+
+	// Number of the frame in myFrame and of the one in myPrev
+	int64_t		myFrameCount;
+	int64_t		myPrevFrame;
+
+	cv::Ptr<cv::DISOpticalFlow>	myDIS;
+	DispresetMenuItems			myDISPreset;
+	SparseFlow					mySparseFlow;
+	int							myTrackedPoints;
+	int							myPyramidsBuilt;
+	TiledFlow					myTiledFlow;
+	int							myTileMargin;
+	MotionStats					myMotionStats;
+	bool						myHasMotionStats;
 
 	int					myExecuteCount;
 	TD::TOP_Context* myContext;
-	TD::OP_SmartRef<TD::OP_TOPDownloadResult> myPrevDownRes;
+	DownloadQueue		myDownloads;
+	CookStats			myCookStats;
 };
 
 #endif
@@ -0,0 +1,198 @@
+#include "PyramidCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	// BORDER_REFLECT_101 index of i in [0, n)
+	inline int
+		reflect101(int i, int n)
+	{
+		if (n == 1)
+			return 0;
+		while (i < 0 || i >= n)
+			i = i < 0 ? -i : 2 * n - 2 - i;
+		return i;
+	}
+
+	// Row y of level, which may be in the border above or below it. Mat::ptr() asserts
+	// the row is inside the view in debug builds
+	inline uint8_t*
+		row(const cv::Mat& level, int y)
+	{
+		return level.data + static_cast<ptrdiff_t>(static_cast<size_t>(level.step)) * y;
+	}
+
+	// Fills the left and right border of rows [begin, end) of level, a view with border pixels
+	// of its buffer on each side
+	void
+		fillRowBorders(cv::Mat& level, int border, int begin, int end)
+	{
+		for (int y = begin; y < end; ++y)
+		{
+			uint8_t*	r = row(level, y);
+			for (int i = 1; i <= border; ++i)
+			{
+				r[-i] = r[reflect101(-i, level.cols)];
+				r[level.cols - 1 + i] = r[reflect101(level.cols - 1 + i, level.cols)];
+			}
+		}
+	}
+
+	// Copies whole rows, borders included, to the rows above and below level
+	void
+		fillColumnBorders(cv::Mat& level, int border)
+	{
+		const size_t	bytes = level.cols + 2 * border;
+		for (int i = 1; i <= border; ++i)
+		{
+			std::memcpy(row(level, -i) - border, row(level, reflect101(-i, level.rows)) - border, bytes);
+			std::memcpy(row(level, level.rows - 1 + i) - border, row(level, reflect101(level.rows - 1 + i, level.rows)) - border, bytes);
+		}
+	}
+
+	// Rows [begin, end) of dst from src, whose borders are at least 2 pixels and filled
+	void
+		pyrDownRows(const cv::Mat& src, cv::Mat& dst, int begin, int end, std::vector<int>& column)
+	{
+		// Vertical [1 4 6 4 1] of the 2 * dst.cols + 3 source columns an output row reads
+		const int	width = 2 * dst.cols + 3;
+		column.resize(width);
+
+		for (int y = begin; y < end; ++y)
+		{
+			const uint8_t*	r0 = row(src, 2 * y - 2) - 2;
+			const uint8_t*	r1 = row(src, 2 * y - 1) - 2;
+			const uint8_t*	r2 = row(src, 2 * y) - 2;
+			const uint8_t*	r3 = row(src, 2 * y + 1) - 2;
+			const uint8_t*	r4 = row(src, 2 * y + 2) - 2;
+			for (int x = 0; x < width; ++x)
+				column[x] = r0[x] + 4 * (r1[x] + r3[x]) + 6 * r2[x] + r4[x];
+
+			uint8_t*	out = dst.ptr<uint8_t>(y);
+			for (int x = 0; x < dst.cols; ++x)
+			{
+				const int*	c = column.data() + 2 * x;
+				const int	sum = c[0] + 4 * (c[1] + c[3]) + 6 * c[2] + c[4];
+				out[x] = static_cast<uint8_t>((sum + 128) >> 8);
+			}
+		}
+	}
+}
+
+PyramidCache::PyramidCache() :
+	myUseCount{ 0 }, myBuilt{ 0 }, myAllocated{ 0 }
+{
+}
+
+const std::vector<cv::Mat>&
+PyramidCache::get(int64_t frame, const cv::Mat& image, int numLevels, int border)
+{
+	numLevels = std::max(numLevels, 1);
+	border = std::max(border, 2);
+	myUseCount++;
+
+	for (Entry& entry : myEntries)
+	{
+		if (entry.frame == frame && entry.numLevels == numLevels && entry.border == border &&
+			!entry.levels.empty() && entry.levels[0].size() == image.size())
+		{
+			entry.lastUse = myUseCount;
+			return entry.levels;
+		}
+	}
+
+	// Replace the entry used longest ago, never the one get() returned just before
+	Entry&	entry = myEntries[0].lastUse <= myEntries[1].lastUse ? myEntries[0] : myEntries[1];
+	entry.frame = frame;
+	entry.numLevels = numLevels;
+	entry.border = border;
+	entry.lastUse = myUseCount;
+	build(entry, image);
+	myBuilt++;
+	return entry.levels;
+}
+
+void
+PyramidCache::clear()
+{
+	for (Entry& entry : myEntries)
+	{
+		entry.frame = -1;
+		entry.lastUse = 0;
+	}
+}
+
+int
+PyramidCache::getBuilt()
+{
+	const int	built = myBuilt;
+	myBuilt = 0;
+	return built;
+}
+
+size_t
+PyramidCache::getAllocated()
+{
+	const size_t	bytes = myAllocated;
+	myAllocated = 0;
+	return bytes;
+}
+
+void
+PyramidCache::build(Entry& entry, const cv::Mat& image)
+{
+	const int	border = entry.border;
+
+	// Sized up front, level() must not move the levels already built
+	if (static_cast<int>(entry.buffers.size()) < entry.numLevels)
+		entry.buffers.resize(entry.numLevels);
+	entry.levels.resize(entry.numLevels);
+
+	cv::Mat&	base = level(entry, 0, image.cols, image.rows);
+	cv::parallel_for_(cv::Range(0, image.rows), [&](const cv::Range& band)
+	{
+		for (int y = band.start; y < band.end; ++y)
+			std::memcpy(base.ptr<uint8_t>(y), image.ptr<uint8_t>(y), image.cols);
+		fillRowBorders(base, border, band.start, band.end);
+	});
+	fillColumnBorders(base, border);
+
+	int	numLevels = 1;
+	while (numLevels < entry.numLevels)
+	{
+		const cv::Mat&	src = entry.levels[numLevels - 1];
+		const int		width = (src.cols + 1) / 2;
+		const int		height = (src.rows + 1) / 2;
+		if (width <= border || height <= border)
+			break;
+
+		cv::Mat&	dst = level(entry, numLevels, width, height);
+		cv::parallel_for_(cv::Range(0, height), [&](const cv::Range& band)
+		{
+			std::vector<int>	column;
+			pyrDownRows(src, dst, band.start, band.end, column);
+			fillRowBorders(dst, border, band.start, band.end);
+		});
+		fillColumnBorders(dst, border);
+		numLevels++;
+	}
+
+	entry.levels.resize(numLevels);
+}
+
+cv::Mat&
+PyramidCache::level(Entry& entry, int index, int width, int height)
+{
+	const int	border = entry.border;
+	cv::Mat&	buffer = entry.buffers[index];
+	if (buffer.rows != height + 2 * border || buffer.cols != width + 2 * border)
+	{
+		buffer.create(height + 2 * border, width + 2 * border, CV_8UC1);
+		myAllocated += buffer.total();
+	}
+
+	entry.levels[index] = buffer(cv::Rect(border, border, width, height));
+	return entry.levels[index];
+}
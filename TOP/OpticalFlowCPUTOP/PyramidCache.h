@@ -0,0 +1,62 @@
+#ifndef __PyramidCache__
+#define __PyramidCache__
+
+#include <opencv2/core.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+Image pyramids of the last two frames, in the layout cv::calcOpticalFlowPyrLK takes instead
+of images: one 8 bit level per entry, each a view into a buffer with a border of at least
+the search window filled by reflection. Frames are keyed by a number the caller gives them,
+so the frame that was "next" in one cook is found again as "prev" in the following one and
+only one pyramid is built per cook.
+
+Levels are built like cv::pyrDown, a 5x5 Gaussian with BORDER_REFLECT_101. Because the
+border is already in the buffer, each output row only reads memory and the rows of a level
+are split with cv::parallel_for_. Building stops early at a level no larger than the window,
+like cv::buildOpticalFlowPyramid.
+*/
+class PyramidCache
+{
+public:
+	PyramidCache();
+
+	// Returns the pyramid of frame, building it from image if it is not cached with the same
+	// number of levels and border. image is 8 bit single channel
+	const std::vector<cv::Mat>&	get(int64_t frame, const cv::Mat& image, int numLevels, int border);
+
+	void		clear();
+
+	// Pyramids built since the last call, 1 per cook once the cache is warm
+	int			getBuilt();
+
+	// Bytes allocated since the last call
+	size_t		getAllocated();
+
+private:
+	struct Entry
+	{
+		int64_t					frame = -1;
+		int						numLevels = 0;
+		int						border = 0;
+		int64_t					lastUse = 0;
+		std::vector<cv::Mat>	buffers;
+		std::vector<cv::Mat>	levels;
+	};
+
+	void	build(Entry& entry, const cv::Mat& image);
+
+	// Gives level index the size and border of the entry, reusing its buffer when it fits
+	cv::Mat&	level(Entry& entry, int index, int width, int height);
+
+	std::array<Entry, 2>	myEntries;
+	int64_t					myUseCount;
+	int						myBuilt;
+	size_t					myAllocated;
+};
+
+#endif // !__PyramidCache__
@@ -0,0 +1,143 @@
+#include "SparseFlow.h"
+
+#include <opencv2/imgproc.hpp>
+#include <opencv2/video/tracking.hpp>
+
+#include <algorithm>
+
+namespace
+{
+	// Blur of the normalized convolution, in cells
+	const double	CellSigma = 1.0;
+
+	// Cells with less weight than this after the blur had no tracked point near them
+	const float		MinWeight = 1e-3f;
+
+	size_t
+		matBytes(const cv::Mat& m)
+	{
+		return m.total() * m.elemSize();
+	}
+}
+
+SparseFlow::SparseFlow() :
+	myNumTracked{ 0 }, myAllocated{ 0 }
+{
+}
+
+void
+SparseFlow::calc(int64_t prevFrame, const cv::Mat& prev, int64_t nextFrame, const cv::Mat& next,
+				 cv::Mat& flow, const Settings& settings)
+{
+	const int	step = std::max(settings.gridStep, 1);
+	const int	cols = (prev.cols + step - 1) / step;
+	const int	rows = (prev.rows + step - 1) / step;
+
+	// Points sit where the bilinear upsample puts the centre of their cell
+	const float	offset = 0.5f * (step - 1);
+	reserve(static_cast<size_t>(cols) * rows);
+	myPoints.clear();
+	for (int cy = 0; cy < rows; ++cy)
+	{
+		const float	y = std::min(cy * step + offset, prev.rows - 1.0f);
+		for (int cx = 0; cx < cols; ++cx)
+			myPoints.push_back(cv::Point2f(std::min(cx * step + offset, prev.cols - 1.0f), y));
+	}
+
+	// calcOpticalFlowPyrLK needs a border of the window around every level
+	const int	window = std::max(settings.windowSize, 3);
+	const int	numLevels = std::max(settings.maxLevel, 0) + 1;
+	const std::vector<cv::Mat>&	prevPyramid = myPyramids.get(prevFrame, prev, numLevels, window);
+	const std::vector<cv::Mat>&	nextPyramid = myPyramids.get(nextFrame, next, numLevels, window);
+	myAllocated += myPyramids.getAllocated();
+
+	const int	maxLevel = static_cast<int>(std::min(prevPyramid.size(), nextPyramid.size())) - 1;
+	cv::TermCriteria	criteria(cv::TermCriteria::COUNT | cv::TermCriteria::EPS, std::max(settings.iterations, 1), 0.01);
+	cv::calcOpticalFlowPyrLK(prevPyramid, nextPyramid, myPoints, myTracked, myStatus, myErrors,
+		cv::Size(window, window), maxLevel, criteria);
+
+	if (myCells.rows != rows || myCells.cols != cols)
+	{
+		myCells.create(rows, cols, CV_32FC3);
+		myCellFlow.create(rows, cols, CV_32FC2);
+		myAllocated += matBytes(myCells) + matBytes(myCellFlow);
+	}
+
+	myNumTracked = 0;
+	for (int cy = 0; cy < rows; ++cy)
+	{
+		cv::Vec3f*	cell = myCells.ptr<cv::Vec3f>(cy);
+		for (int cx = 0; cx < cols; ++cx)
+		{
+			const size_t	i = static_cast<size_t>(cy) * cols + cx;
+			if (myStatus[i])
+			{
+				cell[cx] = cv::Vec3f(myTracked[i].x - myPoints[i].x, myTracked[i].y - myPoints[i].y, 1.0f);
+				myNumTracked++;
+			}
+			else
+			{
+				cell[cx] = cv::Vec3f(0.0f, 0.0f, 0.0f);
+			}
+		}
+	}
+
+	cv::GaussianBlur(myCells, myCells, cv::Size(), CellSigma);
+
+	for (int cy = 0; cy < rows; ++cy)
+	{
+		const cv::Vec3f*	cell = myCells.ptr<cv::Vec3f>(cy);
+		cv::Vec2f*			out = myCellFlow.ptr<cv::Vec2f>(cy);
+		for (int cx = 0; cx < cols; ++cx)
+		{
+			const float	w = cell[cx][2];
+			out[cx] = w > MinWeight ? cv::Vec2f(cell[cx][0] / w, cell[cx][1] / w) : cv::Vec2f(0.0f, 0.0f);
+		}
+	}
+
+	if (flow.rows != prev.rows || flow.cols != prev.cols || flow.type() != CV_32FC2)
+	{
+		flow.create(prev.rows, prev.cols, CV_32FC2);
+		myAllocated += matBytes(flow);
+	}
+	cv::resize(myCellFlow, flow, flow.size(), 0, 0, cv::INTER_LINEAR);
+}
+
+int
+SparseFlow::getNumTracked() const
+{
+	return myNumTracked;
+}
+
+int
+SparseFlow::getNumPoints() const
+{
+	return static_cast<int>(myPoints.size());
+}
+
+int
+SparseFlow::getPyramidsBuilt()
+{
+	return myPyramids.getBuilt();
+}
+
+size_t
+SparseFlow::getAllocated()
+{
+	const size_t	bytes = myAllocated;
+	myAllocated = 0;
+	return bytes;
+}
+
+void
+SparseFlow::reserve(size_t numPoints)
+{
+	if (numPoints <= myPoints.capacity())
+		return;
+
+	myPoints.reserve(numPoints);
+	myTracked.reserve(numPoints);
+	myStatus.reserve(numPoints);
+	myErrors.reserve(numPoints);
+	myAllocated += numPoints * (2 * sizeof(cv::Point2f) + sizeof(uint8_t) + sizeof(float));
+}
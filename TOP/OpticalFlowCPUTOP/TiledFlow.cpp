@@ -0,0 +1,92 @@
+#include "TiledFlow.h"
+
+#include <algorithm>
+#include <cmath>
+
+TiledFlow::TiledFlow() :
+	myAllocated{ 0 }
+{
+}
+
+void
+TiledFlow::calc(const cv::Mat& prev, const cv::Mat& next, cv::Mat& flow, int tilesX, int tilesY,
+				int margin, bool initialFlow, const FlowFn& fn)
+{
+	const int	width = prev.cols;
+	const int	height = prev.rows;
+	tilesX = std::min(std::max(tilesX, 1), std::max(width, 1));
+	tilesY = std::min(std::max(tilesY, 1), std::max(height, 1));
+	margin = std::max(margin, 0);
+
+	const int	numTiles = tilesX * tilesY;
+	if (static_cast<int>(myTileFlows.size()) < numTiles)
+		myTileFlows.resize(numTiles);
+
+	// Sized here rather than in the tasks so the allocations are counted
+	std::vector<cv::Rect>	centres(numTiles);
+	std::vector<cv::Rect>	tiles(numTiles);
+	for (int ty = 0; ty < tilesY; ++ty)
+	{
+		const int	y0 = height * ty / tilesY;
+		const int	y1 = height * (ty + 1) / tilesY;
+		const int	ey0 = std::max(y0 - margin, 0);
+		const int	ey1 = std::min(y1 + margin, height);
+		for (int tx = 0; tx < tilesX; ++tx)
+		{
+			const int	x0 = width * tx / tilesX;
+			const int	x1 = width * (tx + 1) / tilesX;
+			const int	ex0 = std::max(x0 - margin, 0);
+			const int	ex1 = std::min(x1 + margin, width);
+
+			const int	i = ty * tilesX + tx;
+			centres[i] = cv::Rect(x0, y0, x1 - x0, y1 - y0);
+			tiles[i] = cv::Rect(ex0, ey0, ex1 - ex0, ey1 - ey0);
+
+			cv::Mat&	tileFlow = myTileFlows[i];
+			if (tileFlow.rows != tiles[i].height || tileFlow.cols != tiles[i].width)
+			{
+				tileFlow.create(tiles[i].height, tiles[i].width, CV_32FC2);
+				myAllocated += tileFlow.total() * tileFlow.elemSize();
+			}
+
+			// Taken before any task writes its centre to flow, the margins overlap the
+			// centres of the neighbours
+			if (initialFlow)
+				flow(tiles[i]).copyTo(tileFlow);
+		}
+	}
+
+	// One stripe per tile. The parallel loops inside fn run serially within a task
+	cv::parallel_for_(cv::Range(0, numTiles), [&](const cv::Range& range)
+	{
+		for (int i = range.start; i < range.end; ++i)
+		{
+			const cv::Rect&	tile = tiles[i];
+			const cv::Rect&	centre = centres[i];
+			cv::Mat&		tileFlow = myTileFlows[i];
+			fn(prev(tile), next(tile), tileFlow);
+
+			cv::Mat	out = flow(centre);
+			tileFlow(cv::Rect(centre.x - tile.x, centre.y - tile.y, centre.width, centre.height)).copyTo(out);
+		}
+	}, numTiles);
+}
+
+size_t
+TiledFlow::getAllocated()
+{
+	const size_t	bytes = myAllocated;
+	myAllocated = 0;
+	return bytes;
+}
+
+int
+TiledFlow::farnebackMargin(int windowSize, int polyN, int numLevels, double pyramidScale)
+{
+	// Farneback builds numLevels levels above the frame, each pyramidScale times the size
+	// of the one below
+	const double	scale = std::max(pyramidScale, 0.01);
+	const int		levels = std::min(std::max(numLevels, 0), 10);
+	const double	radius = windowSize / 2 + polyN;
+	return static_cast<int>(std::min(std::ceil(radius * std::pow(1.0 / scale, levels)), 1.0e6));
+}
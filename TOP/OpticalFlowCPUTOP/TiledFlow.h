@@ -0,0 +1,52 @@
+#ifndef __TiledFlow__
+#define __TiledFlow__
+
+#include <opencv2/core.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/*
+Splits a dense flow into tiles that are computed in parallel, one task per tile. OpenCV's
+own flow functions only parallelize part of their work, with many cores most of them wait.
+
+Each tile is grown by a margin on the sides that are inside the frame, and the flow is
+computed on the grown tile so pixels near its edge still see the texture and motion
+around them. Only the centre of each tile is copied to the output, the centres cover the
+frame without overlapping. With a margin as large as what the flow looks at, the tiled
+flow matches the untiled one except for small differences along the seams. A smaller
+margin is faster, but a tile much smaller than the reach of the coarse pyramid levels loses
+them and large motions come out wrong over the whole tile, not only along its edges.
+
+farnebackMargin() is that distance for cv::calcOpticalFlowFarneback: the averaging window
+and polynomial neighbourhood at the coarsest pyramid level, in pixels of the frame. It is an
+upper bound, most of the flow comes from the finer levels and a fraction of it is usually
+enough: with OpenCV 4.11 defaults, a quarter of it keeps 4x4 tiles of a 1280x720 frame
+within 0.1 pixel of the untiled flow, while no margin leaves them off by 2 to 4 pixels on
+a 6 pixel motion. The README has the full measurements.
+*/
+class TiledFlow
+{
+public:
+	// Computes the flow of one tile, flow is the size of prev and next
+	typedef std::function<void(const cv::Mat& prev, const cv::Mat& next, cv::Mat& flow)>	FlowFn;
+
+	TiledFlow();
+
+	// flow must be CV_32FC2 the size of prev and next. If initialFlow, every tile starts
+	// from the part of flow it covers, for OPTFLOW_USE_INITIAL_FLOW
+	void		calc(const cv::Mat& prev, const cv::Mat& next, cv::Mat& flow, int tilesX, int tilesY,
+					 int margin, bool initialFlow, const FlowFn& fn);
+
+	// Bytes allocated since the last call
+	size_t		getAllocated();
+
+	static int	farnebackMargin(int windowSize, int polyN, int numLevels, double pyramidScale);
+
+private:
+	std::vector<cv::Mat>	myTileFlows;
+	size_t					myAllocated;
+};
+
+#endif // !__TiledFlow__
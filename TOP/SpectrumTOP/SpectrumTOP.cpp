@@ -114,7 +114,8 @@ SpectrumTOP::SpectrumTOP(const OP_NodeInfo*, TOP_Context *context) :
 	myError(""),
 	myNumChan(-1),
 	myContext(context),
-	myChanFormat(GpuUtils::ChannelFormat::U16)
+	myChanFormat(GpuUtils::ChannelFormat::U16),
+	myCookStats{ "input", "transform", "output" }
 {
 	cudaStreamCreate(&myStream);
 }
@@ -138,6 +139,7 @@ SpectrumTOP::execute(TOP_Output* output, const OP_Inputs* inputs, void*)
 {
 	using namespace cv::cuda;
 
+	CookStats::Cook	cook(myCookStats);
 	myError = "";
 	myExecuteCount++;
 
@@ -182,7 +184,9 @@ SpectrumTOP::execute(TOP_Output* output, const OP_Inputs* inputs, void*)
 		return;
 	}
 
+	myCookStats.beginPhase(CookPhase::Input);
 	*myFrame = cv::cuda::GpuMat(info.textureDesc.height, info.textureDesc.width, CV_32FC2);
+	myCookStats.addAllocated(static_cast<size_t>(info.textureDesc.width) * info.textureDesc.height * 2 * sizeof(float));
 	if (mode == ModeMenuItems::dft)
 	{
 		GpuUtils::arrayToComplexMatGPU(info.textureDesc.width, info.textureDesc.height, inputArray->cudaArray, *myFrame, myNumChan, channame, myChanFormat);
@@ -192,10 +196,12 @@ SpectrumTOP::execute(TOP_Output* output, const OP_Inputs* inputs, void*)
 		GpuUtils::arrayToMatGPU(info.textureDesc.width, info.textureDesc.height, inputArray->cudaArray, *myFrame, 2 * sizeof(float));
 	}
 
+	myCookStats.endPhase();
+
 	if (myFrame->empty())
 		return;
 	
-
+	myCookStats.beginPhase(CookPhase::Transform);
 	if (mode == ModeMenuItems::dft)
 	{
 		cv::cuda::Stream stream = cv::cuda::StreamAccessor::wrapStream(myStream);
@@ -248,9 +254,9 @@ SpectrumTOP::execute(TOP_Output* output, const OP_Inputs* inputs, void*)
 
 		dft(*myFrame, *myResult, mySize, 0);
 	}
+	myCookStats.endPhase();
 
-	
-
+	myCookStats.beginPhase(CookPhase::Output);
 	if (mode == ModeMenuItems::dft)
 	{
 		GpuUtils::matGPUToArray(info.textureDesc.width, info.textureDesc.height, *myResult, outputInfo->cudaArray, 2 * sizeof(float));
@@ -261,6 +267,7 @@ SpectrumTOP::execute(TOP_Output* output, const OP_Inputs* inputs, void*)
 	}
 
 	myContext->endCUDAOperations(nullptr);
+	myCookStats.endPhase();
 }
 
 void
@@ -353,6 +360,17 @@ SpectrumTOP::getErrorString(OP_String* error, void*)
 	myError.clear();
 }
 
+int32_t
+SpectrumTOP::getNumInfoCHOPChans(void*)
+{
+	return myCookStats.getNumInfoCHOPChans();
+}
+
+void
+SpectrumTOP::getInfoCHOPChan(int32_t index, OP_InfoCHOPChan* chan, void*)
+{
+	myCookStats.getInfoCHOPChan(index, chan);
+}
 
 bool
 SpectrumTOP::checkInputTop(const OP_TOPInput* topInput, const OP_Inputs* input)
@@ -16,6 +16,7 @@
 #define __SpectrumTOP__
 
 #include "TOP_CPlusPlusBase.h"
+#include "CookStats.h"
 
 #include <opencv2\core.hpp>
 #include <string>
@@ -49,6 +50,10 @@ It takes the following parameters:
 
 This TOP takes one input. If the inverse is to be calculated the input must have
 exactly 2 32-bit float channels.
+
+It outputs the cook time statistics described in CookStats.h to CHOPInfo, with the
+input, transform and output phases. The CUDA work is asynchronous, the phases measure the
+time spent on the CPU issuing it.
 */
 
 // To get more help about these functions, look at TOP_CPlusPlusBase.h
@@ -66,7 +71,18 @@ public:
 
 	virtual void		getErrorString(OP_String*, void* reserved) override;
 
+	virtual int32_t		getNumInfoCHOPChans(void* reserved) override;
+
+	virtual void		getInfoCHOPChan(int32_t index, OP_InfoCHOPChan* chan, void* reserved) override;
+
 private:
+	enum class CookPhase
+	{
+		Input,
+		Transform,
+		Output
+	};
+
 	bool				checkInputTop(const OP_TOPInput*, const TD::OP_Inputs*);
 
 	void				swapQuadrants(cv::cuda::GpuMat&);
@@ -89,6 +105,8 @@ private:
 
 	TOP_Context*		myContext;
 	cudaStream_t		myStream;
+
+	CookStats			myCookStats;
 };
 
 #endif